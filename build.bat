@@ -21,7 +21,7 @@ set script_dir=%~dp0
 :: `build release` -> optimized build, no debug symbols
 :: `build clang`   -> use clang compiler
 :: `build msvc`    -> use msvc compiler
-:: `build web`     -> compile to web assembly with emscripten
+:: `build web`     -> compile to web assembly with emscripten (packs the assets first)
 :: `build clean`   -> delete old generated build files (excluding CMake)
 :: CMake build:
 :: `build cmake`       -> setup and build using CMake
@@ -32,12 +32,19 @@ set script_dir=%~dp0
 :: - CMake will automatically download and build raylib if needed
 :: - You can find the generated Visual Studio solution in build\desktop\
 ::
+:: Note: web builds preload assets.pak like `make web`, the packer (src\pack.c)
+:: is a desktop tool so it's built with gcc first. `build cmake web` preloads
+:: assets.pak only if one was already packed, else the loose assets\
+::
 :: ----------------------------------------------------------------------------
 
 :: Project Config
 :: ----------------------------------------------------------------------------
 set output=frogger
-set source_code=src\main.c
+set source_code=src\main.c src\unity.c src\platform_desktop.c
+set web_source_code=src\main.c src\unity.c src\platform_web.c
+set pack_output=frogger_pack
+set pack_source_code=src\pack.c src\unity.c src\platform_headless.c
 
 set raylib_dep=deps\raylib
 
@@ -115,7 +122,7 @@ set cl_out=      /Fe:
 
 set web_release=  -Os
 set web_platform= -DPLATFORM_WEB
-set web_link=     -lraylib -L"%raylib_dep%\lib\web" --shell-file shell.html --preload-file assets -sUSE_GLFW=3 -sTOTAL_MEMORY=67108864 -sFORCE_FILESYSTEM=1 -sASYNCIFY -sEXPORTED_FUNCTIONS=_main,requestFullscreen -sEXPORTED_RUNTIME_METHODS=HEAPF32
+set web_link=     -lraylib -L"%raylib_dep%\lib\web" --shell-file shell.html --preload-file assets.pak -sUSE_GLFW=3 -sTOTAL_MEMORY=67108864 -sFORCE_FILESYSTEM=1 -sASYNCIFY -sEXPORTED_FUNCTIONS=_main,requestFullscreen -sEXPORTED_RUNTIME_METHODS=HEAPF32
 
 :: Choose Compile/Line Lines
 :: ----------------------------------------------------------------------------
@@ -147,6 +154,7 @@ if "%web%"=="1" (
     set compile_debug=%web_release%
     set compile_release=%web_release%
     set compile_out=%cc_out% index.html
+    set source_code=%web_source_code%
 )
 
 if "%debug%"=="1"   set compile=%compile% %compile_debug%
@@ -174,6 +182,20 @@ if "%cmake%"=="1" (
     )
 )
 
+if "%simple_build%"=="1" if "%web%"=="1" (
+    rem Pack assets\ into assets.pak for the web build to preload, see src\pack.c
+    rem Stored by the path the game loads them by, e.g. assets/audio/frog_hop.wav
+    set asset_files=
+    for /d %%d in (assets\*) do for %%f in (%%d\*) do (
+        set asset_file=%%f
+        set asset_files=!asset_files! !asset_file:\=/!
+    )
+    set pack_compile=gcc %cc_common% %cc_release% -DPLATFORM_HEADLESS
+    echo !pack_compile! %pack_source_code% %cc_out% %pack_output%.exe %cc_link%
+    !pack_compile! %pack_source_code% %cc_out% %pack_output%.exe %cc_link% || exit /b 1
+    %pack_output%.exe assets.pak !asset_files! || exit /b 1
+)
+
 if "%simple_build%"=="1" (
     echo %compile% %source_code% %compile_out% %compile_link%
     %compile% %source_code% %compile_out% %compile_link%
@@ -194,6 +216,7 @@ if "%cmake%"=="1" (
     rmdir /s /q build_web
     del /q %output%.exe
     del /q index.html index.js index.wasm index.data
+    del /q %pack_output%.exe assets.pak
     del /q %output%.ilk %output%.pdb vc140.pdb *.rdi
     echo Build files cleaned
 )
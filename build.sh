@@ -19,7 +19,7 @@ script_dir=$(cd -- "$(dirname -- "${BASH_SOURCE[0]}")" &> /dev/null && pwd)
 # Below is a non-exhaustive list of arguments you can use:
 # `build release` -> optimized build, no debug symbols
 # `build clang`   -> use clang compiler
-# `build web`     -> compile to web assembly with emscripten
+# `build web`     -> compile to web assembly with emscripten (packs the assets first)
 # `build clean`   -> delete old generated build files (excluding CMake)
 # CMake build:
 # `build cmake`       -> config and build using CMake
@@ -27,13 +27,19 @@ script_dir=$(cd -- "$(dirname -- "${BASH_SOURCE[0]}")" &> /dev/null && pwd)
 # `build cmake clean` -> delete CMake's old build files
 #
 # Note: CMake will automatically download and build raylib if needed
+# Note: web builds preload assets.pak like `make web`, the packer (src/pack.c)
+# is a desktop tool so it's built with gcc first. `build cmake web` preloads
+# assets.pak only if one was already packed, else the loose assets/
 #
 # -----------------------------------------------------------------------------
 
 # Project Config
 # -----------------------------------------------------------------------------
 output=frogger
-source_code=src/main.c
+source_code="src/main.c src/unity.c src/platform_desktop.c" # modules as one unit, see Makefile for incremental builds
+web_source_code="src/main.c src/unity.c src/platform_web.c"
+pack_output=frogger_pack
+pack_source_code="src/pack.c src/unity.c src/platform_headless.c"
 
 raylib_dep=deps/raylib
 
@@ -116,7 +122,7 @@ script_choose_simple_lines()
 
     web_release='-Os'
     web_platform='-DPLATFORM_WEB'
-    web_link="-lraylib -L\"$raylib_dep/lib/web\" --shell-file shell.html --preload-file assets -sUSE_GLFW=3 -sTOTAL_MEMORY=67108864 -sFORCE_FILESYSTEM=1 -sASYNCIFY -sEXPORTED_FUNCTIONS=_main,requestFullscreen -sEXPORTED_RUNTIME_METHODS=HEAPF32"
+    web_link="-lraylib -L\"$raylib_dep/lib/web\" --shell-file shell.html --preload-file assets.pak -sUSE_GLFW=3 -sTOTAL_MEMORY=67108864 -sFORCE_FILESYSTEM=1 -sASYNCIFY -sEXPORTED_FUNCTIONS=_main,requestFullscreen -sEXPORTED_RUNTIME_METHODS=HEAPF32"
 
     # Choose Lines
     if [[ "$gcc" == 1   ]]; then compile="gcc $cc_common"; fi
@@ -133,6 +139,7 @@ script_choose_simple_lines()
         compile_platform="$web_platform"
         compile_link="$web_link"
         compile_out="$cc_out index.html"
+        source_code="$web_source_code"
         compile_release="$web_release"
         compile_debug="$web_release";
     fi
@@ -160,8 +167,18 @@ script_cmake_config_and_build()
     fi
 }
 
+# Pack assets/ into assets.pak for the web build to preload, see src/pack.c
+script_pack_assets()
+{
+    pack_compile="gcc $cc_common $cc_release -DPLATFORM_HEADLESS"
+    echo "$pack_compile $pack_source_code $cc_out $pack_output $cc_link"
+    eval $pack_compile $pack_source_code $cc_out $pack_output $cc_link || exit 1
+    ./$pack_output assets.pak assets/*/* || exit 1
+}
+
 script_simple_build()
 {
+    if [[ "$web" == 1 ]]; then script_pack_assets; fi
     echo "$compile $source_code $compile_out $compile_link"
     eval $compile $source_code $compile_out $compile_link
 }
@@ -173,7 +190,7 @@ script_build_cleanup()
         rm -rf $output build/
         echo "CMake build files cleaned"
     else
-        rm -rf index build_web/ index.html index.js index.wasm index.data
+        rm -rf index build_web/ index.html index.js index.wasm index.data $pack_output assets.pak
         echo "Build files cleaned"
     fi
     popd
@@ -0,0 +1,84 @@
+// EXPLANATION:
+// Allocation tracker, counts the heap allocations made by the project's code
+// See header for more documentation/descriptions
+
+#include "common.h" // all project header includes
+
+#include <stdlib.h> // realloc, free
+
+static PLATFORM_THREAD_LOCAL AllocTracker *boundTracker; // soak workers each count their own game
+
+static const char *allocScopeNames[ALLOC_SCOPE_COUNT] = {
+    "other", "input", "update", "level", "draw"
+};
+
+void *TrackedRealloc(void *ptr, size_t size)
+{
+    if ((boundTracker != NULL) && (size > 0))
+    {
+        boundTracker->frameCounts[boundTracker->scope]++;
+        boundTracker->totalCounts[boundTracker->scope]++;
+        boundTracker->totalBytes += (long long)size;
+    }
+
+    return realloc(ptr, size);
+}
+
+void TrackedFree(void *ptr)
+{
+    free(ptr);
+}
+
+void BindAllocTracker(GameContext *ctx)
+{
+    boundTracker = (ctx != NULL)? &ctx->alloc : NULL;
+}
+
+AllocScope SetAllocScope(GameContext *ctx, AllocScope scope)
+{
+    AllocTracker *alloc = &ctx->alloc;
+
+    AllocScope previous = alloc->scope;
+    alloc->scope = scope;
+    return previous;
+}
+
+void EndAllocFrame(GameContext *ctx)
+{
+    AllocTracker *alloc = &ctx->alloc;
+
+    for (int i = 0; i < ALLOC_SCOPE_COUNT; i++)
+    {
+        alloc->lastFrameCounts[i] = alloc->frameCounts[i];
+        alloc->frameCounts[i] = 0;
+    }
+
+    if (GetSteadyAllocCount(ctx) == 0) alloc->steadyFrames++;
+    else alloc->steadyFrames = 0;
+}
+
+int GetSteadyAllocCount(GameContext *ctx)
+{
+    AllocTracker *alloc = &ctx->alloc;
+
+    int count = 0;
+    for (int i = 0; i < ALLOC_SCOPE_COUNT; i++)
+        if (i != ALLOC_SCOPE_LEVEL) count += alloc->lastFrameCounts[i];
+
+    return count;
+}
+
+const char *GetAllocScopeName(AllocScope scope)
+{
+    return allocScopeNames[scope];
+}
+
+void PrintAllocReport(GameContext *ctx)
+{
+    AllocTracker *alloc = &ctx->alloc;
+
+    TraceLog(LOG_INFO, "ALLOC: %.1f KB allocated, last %i frames without steady state allocations",
+             (double)alloc->totalBytes/1024, alloc->steadyFrames);
+    for (int i = 0; i < ALLOC_SCOPE_COUNT; i++)
+        TraceLog(LOG_INFO, "ALLOC:     %-6s %lli", allocScopeNames[i], alloc->totalCounts[i]);
+}
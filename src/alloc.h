@@ -0,0 +1,46 @@
+// EXPLANATION:
+// Allocation tracker, counts the heap allocations made by the project's code
+// stb_ds arrays and arena regions allocate through TrackedRealloc(), which
+// counts them in the tracker bound to the calling thread, under the scope
+// the game loop is in. The debug overlay shows the last frame's counts, and
+// the tests check that steady gameplay doesn't allocate outside level
+// transitions. raylib's own allocations (assets, audio) aren't seen.
+
+#ifndef FROGGER_ALLOC_HEADER_GUARD
+#define FROGGER_ALLOC_HEADER_GUARD
+
+// Types and Structures
+// ----------------------------------------------------------------------------
+typedef enum {
+    ALLOC_SCOPE_OTHER, // startup, shutdown, anything outside the scopes below
+    ALLOC_SCOPE_INPUT,
+    ALLOC_SCOPE_UPDATE,
+    ALLOC_SCOPE_LEVEL, // new game or level, expected to allocate until warmed up
+    ALLOC_SCOPE_DRAW,
+    ALLOC_SCOPE_COUNT
+} AllocScope;
+
+typedef struct {
+    AllocScope scope;
+
+    int frameCounts[ALLOC_SCOPE_COUNT];     // allocations so far this frame
+    int lastFrameCounts[ALLOC_SCOPE_COUNT]; // allocations in the last finished frame
+    long long totalCounts[ALLOC_SCOPE_COUNT];
+    long long totalBytes;
+
+    int steadyFrames; // frames in a row that only allocated in level transitions
+} AllocTracker;
+
+// Prototypes
+// ----------------------------------------------------------------------------
+void BindAllocTracker(GameContext *ctx); // Count this thread's allocations in ctx (NULL stops counting)
+AllocScope SetAllocScope(GameContext *ctx, AllocScope scope); // Returns the previous scope, to restore it
+void EndAllocFrame(GameContext *ctx);
+int GetSteadyAllocCount(GameContext *ctx); // Allocations outside level transitions in the last frame
+const char *GetAllocScopeName(AllocScope scope);
+void PrintAllocReport(GameContext *ctx);
+
+// TrackedRealloc() and TrackedFree() are declared in common.h, before the
+// library headers that use them
+
+#endif // FROGGER_ALLOC_HEADER_GUARD
@@ -0,0 +1,144 @@
+// EXPLANATION:
+// Packed asset archive, all the files in assets/ in one file with an index
+// See header for more documentation/descriptions
+
+#include "common.h" // all project header includes
+
+#include <string.h> // memcpy, strcmp, strlen
+
+static AssetArchive mountedArchive;
+
+typedef struct {
+    const char *name;
+    int file; // index into the packer's input arrays
+} ArchivePackFile;
+
+static int CompareArchiveEntry(const void *name, const void *entry)
+{
+    return strncmp(name, ((const AssetArchiveEntry *)entry)->name, ASSET_ARCHIVE_NAME_SIZE);
+}
+
+static int CompareArchivePackFile(const void *a, const void *b)
+{
+    return strcmp(((const ArchivePackFile *)a)->name, ((const ArchivePackFile *)b)->name);
+}
+
+bool OpenAssetArchive(AssetArchive *archive, const unsigned char *data, int size)
+{
+    *archive = (AssetArchive){ 0 };
+    if ((data == NULL) || (size < (int)sizeof(AssetArchiveHeader))) return false;
+
+    AssetArchiveHeader header;
+    memcpy(&header, data, sizeof(header));
+    if ((memcmp(header.magic, ASSET_ARCHIVE_MAGIC, 4) != 0) || (header.version != ASSET_ARCHIVE_VERSION) ||
+        (header.size != (unsigned int)size))
+        return false;
+
+    size_t indexEnd = sizeof(header) + (size_t)header.entryCount*sizeof(AssetArchiveEntry);
+    if (indexEnd > (size_t)size) return false;
+
+    // Every file has to fit, with its NUL, so a bad archive can't read out of bounds
+    const AssetArchiveEntry *entries = (const AssetArchiveEntry *)(data + sizeof(header));
+    for (unsigned int i = 0; i < header.entryCount; i++)
+    {
+        const AssetArchiveEntry *e = &entries[i];
+        if ((e->name[ASSET_ARCHIVE_NAME_SIZE - 1] != '\0') || (e->offset < indexEnd) ||
+            ((size_t)e->offset + e->size >= (size_t)size) || (data[e->offset + e->size] != '\0'))
+            return false;
+        if ((i > 0) && (strcmp(entries[i - 1].name, e->name) >= 0)) return false; // sorted for bsearch()
+    }
+
+    *archive = (AssetArchive){
+        .data = data,
+        .size = size,
+        .entries = entries,
+        .entryCount = (int)header.entryCount,
+    };
+    return true;
+}
+
+const unsigned char *FindAssetArchiveEntry(const AssetArchive *archive, const char *fileName, int *size)
+{
+    if (archive->entryCount == 0) return NULL;
+
+    const AssetArchiveEntry *e = bsearch(fileName, archive->entries, archive->entryCount,
+                                         sizeof(AssetArchiveEntry), CompareArchiveEntry);
+    if (e == NULL) return NULL;
+
+    *size = (int)e->size;
+    return archive->data + e->offset;
+}
+
+unsigned char *PackAssetArchive(const char **fileNames, const unsigned char **fileData, const int *fileSizes, int count, int *size)
+{
+    // Index sorted by name, the files go in the same order. Both passes walk
+    // this order, the padding before each file depends on the ones before it
+    ArchivePackFile *sorted = MemAlloc(count*sizeof(sorted[0]));
+    for (int i = 0; i < count; i++) sorted[i] = (ArchivePackFile){ fileNames[i], i };
+    qsort(sorted, count, sizeof(sorted[0]), CompareArchivePackFile);
+
+    size_t indexEnd = sizeof(AssetArchiveHeader) + count*sizeof(AssetArchiveEntry);
+    size_t totalSize = indexEnd;
+    for (int i = 0; i < count; i++)
+    {
+        if (strlen(sorted[i].name) >= ASSET_ARCHIVE_NAME_SIZE) { MemFree(sorted); return NULL; }
+        if ((i > 0) && (strcmp(sorted[i - 1].name, sorted[i].name) == 0)) { MemFree(sorted); return NULL; }
+        totalSize = (totalSize + ASSET_ARCHIVE_ALIGN - 1)/ASSET_ARCHIVE_ALIGN*ASSET_ARCHIVE_ALIGN;
+        totalSize += fileSizes[sorted[i].file] + 1;
+    }
+
+    unsigned char *archive = MemAlloc((unsigned int)totalSize); // zeroed, pads and NULs included
+    AssetArchiveHeader header = { .version = ASSET_ARCHIVE_VERSION, .entryCount = count, .size = (unsigned int)totalSize };
+    memcpy(header.magic, ASSET_ARCHIVE_MAGIC, 4);
+    memcpy(archive, &header, sizeof(header));
+
+    size_t offset = indexEnd;
+    for (int i = 0; i < count; i++)
+    {
+        int file = sorted[i].file;
+
+        offset = (offset + ASSET_ARCHIVE_ALIGN - 1)/ASSET_ARCHIVE_ALIGN*ASSET_ARCHIVE_ALIGN;
+        AssetArchiveEntry entry = { .offset = (unsigned int)offset, .size = (unsigned int)fileSizes[file] };
+        strcpy(entry.name, fileNames[file]);
+        memcpy(archive + sizeof(header) + i*sizeof(entry), &entry, sizeof(entry));
+
+        memcpy(archive + offset, fileData[file], fileSizes[file]);
+        offset += fileSizes[file] + 1;
+    }
+
+    MemFree(sorted);
+    *size = (int)totalSize;
+    return archive;
+}
+
+// Mounted archive
+// ----------------------------------------------------------------------------
+bool MountAssetArchive(const char *fileName)
+{
+    int size = 0;
+    const unsigned char *data = PlatformMapFile(fileName, &size);
+    if (data == NULL) return false;
+
+    if (!OpenAssetArchive(&mountedArchive, data, size))
+    {
+        TraceLog(LOG_WARNING, "ARCHIVE: [%s] Not a valid asset archive, loading loose files", fileName);
+        PlatformUnmapFile(data, size);
+        return false;
+    }
+
+    TraceLog(LOG_INFO, "ARCHIVE: [%s] Mounted, %i files (%i bytes)", fileName, mountedArchive.entryCount, size);
+    return true;
+}
+
+void UnmountAssetArchive(void)
+{
+    if (mountedArchive.data == NULL) return;
+
+    PlatformUnmapFile(mountedArchive.data, mountedArchive.size);
+    mountedArchive = (AssetArchive){ 0 };
+}
+
+const unsigned char *GetAssetArchiveEntry(const char *fileName, int *size)
+{
+    return FindAssetArchiveEntry(&mountedArchive, fileName, size);
+}
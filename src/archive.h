@@ -0,0 +1,56 @@
+// EXPLANATION:
+// Packed asset archive, all the files in assets/ in one file with an index
+// `make pack` builds it with src/pack.c. The game mounts it at startup (mapped
+// into memory on desktop, preloaded as one blob on web) and the asset loaders
+// in rl_utils.c read straight from its bytes. Without an archive they load the
+// loose files instead.
+//
+// Layout (little endian):
+// AssetArchiveHeader
+// AssetArchiveEntry[entryCount], sorted by name
+// file data, each file aligned to ASSET_ARCHIVE_ALIGN and followed by a NUL byte
+
+#ifndef FROGGER_ARCHIVE_HEADER_GUARD
+#define FROGGER_ARCHIVE_HEADER_GUARD
+
+// Macros
+// ----------------------------------------------------------------------------
+#define ASSET_ARCHIVE_MAGIC "FPAK"
+#define ASSET_ARCHIVE_VERSION 1
+#define ASSET_ARCHIVE_NAME_SIZE 56 // including the NUL
+#define ASSET_ARCHIVE_ALIGN 16
+
+// Types and Structures
+// ----------------------------------------------------------------------------
+typedef struct {
+    char magic[4];
+    unsigned int version;
+    unsigned int entryCount;
+    unsigned int size; // whole archive, to catch truncated files
+} AssetArchiveHeader;
+
+typedef struct {
+    char name[ASSET_ARCHIVE_NAME_SIZE]; // path the game loads it by, e.g. "assets/audio/frog_hop.wav"
+    unsigned int offset; // from the start of the archive
+    unsigned int size;   // bytes, not counting the NUL after it
+} AssetArchiveEntry;
+
+typedef struct {
+    const unsigned char *data;
+    int size;
+    const AssetArchiveEntry *entries;
+    int entryCount;
+} AssetArchive;
+
+// Prototypes
+// ----------------------------------------------------------------------------
+bool OpenAssetArchive(AssetArchive *archive, const unsigned char *data, int size); // Check the header and index of archive bytes in memory
+const unsigned char *FindAssetArchiveEntry(const AssetArchive *archive, const char *fileName, int *size); // NULL if the archive doesn't have it
+unsigned char *PackAssetArchive(const char **fileNames, const unsigned char **fileData, const int *fileSizes, int count, int *size); // Build an archive, free with MemFree()
+
+// Mounted archive, used by the asset loaders (one per process, read-only once mounted)
+bool MountAssetArchive(const char *fileName);
+void UnmountAssetArchive(void); // After all the assets are unloaded, music streams read from it while playing
+const unsigned char *GetAssetArchiveEntry(const char *fileName, int *size); // NULL if there is no mounted archive or it doesn't have the file
+
+#endif // FROGGER_ARCHIVE_HEADER_GUARD
@@ -0,0 +1,281 @@
+// EXPLANATION:
+// Sprite atlas packer, builds the texture and the sprite header the game draws from
+// Every sprite is its own PNG in art/sprites/ (or art/controls/ for the touch
+// controls, which get their own bilinear filtered atlas). A sprite with several frames
+// (animations, log pieces) has its frame grid in the name, e.g.
+// frog_dying.3x2.png is 3 frames across and 2 down. Each frame gets its edge
+// pixels repeated around it and a transparent gap after that, so sampling
+// just outside a frame (filtering, subpixel positions, rotation) only picks
+// up its own edge. Sprites are shelf packed, tallest first, into the smallest
+// power of two texture they fit. Built and run by `make atlas`, both outputs
+// are checked in so the game builds without running it.
+//
+// Usage: frogger_atlas <atlas.png> <header.h> <sprites...>
+// The atlas is written to the path given, which is the path the game loads
+// it by (e.g. assets/textures/sprites.png). The header's name sets its macro
+// prefix, e.g. src/controls.h defines CONTROL_ATLAS_FILE and CONTROL_DPAD.
+
+#include "common.h" // all project header includes
+
+#include <stdio.h>
+#include <stdlib.h> // qsort
+#include <string.h> // strchr, strcmp, strncmp, strcpy
+#include <ctype.h>  // toupper, isalnum
+
+// Macros
+// ----------------------------------------------------------------------------
+#define ATLAS_EXTRUDE 1         // edge pixels repeated around each frame
+#define ATLAS_PADDING 1         // transparent pixels between frames
+#define ATLAS_MIN_SIZE 64
+#define ATLAS_MAX_SIZE 4096
+#define ATLAS_NAME_SIZE 64
+
+// Types and Structures
+// ----------------------------------------------------------------------------
+typedef struct {
+    char name[ATLAS_NAME_SIZE]; // macro name, e.g. FROG_DYING
+    Image image;                // all frames, RGBA
+    int cols, rows;
+    int frameWidth, frameHeight;
+    int strideX, strideY;       // frame, its border and the gap
+    int width, height;          // all frames in the atlas
+    int x, y;                   // top left of the first frame's border
+} AtlasSprite;
+
+// Module Functions Definition
+// ----------------------------------------------------------------------------
+
+// Sprite name and frame grid from e.g. art/sprites/frog_dying.3x2.png
+static bool ParseSpriteFileName(AtlasSprite *sprite, const char *fileName)
+{
+    char base[ATLAS_NAME_SIZE] = { 0 };
+    strncpy(base, GetFileNameWithoutExt(fileName), sizeof(base) - 1);
+
+    sprite->cols = 1;
+    sprite->rows = 1;
+    char *grid = strchr(base, '.');
+    if (grid != NULL)
+    {
+        if ((sscanf(grid + 1, "%ix%i", &sprite->cols, &sprite->rows) != 2) || (sprite->cols < 1) || (sprite->rows < 1))
+            return false;
+        *grid = '\0';
+    }
+
+    for (int i = 0; base[i] != '\0'; i++)
+    {
+        if (!isalnum((unsigned char)base[i]) && (base[i] != '_')) return false;
+        sprite->name[i] = (char)toupper((unsigned char)base[i]);
+    }
+    return (base[0] != '\0');
+}
+
+static int CompareSpriteHeight(const void *a, const void *b)
+{
+    const AtlasSprite *x = *(const AtlasSprite **)a, *y = *(const AtlasSprite **)b;
+    if (x->height != y->height) return y->height - x->height;
+    if (x->width != y->width) return y->width - x->width;
+    return strcmp(x->name, y->name);
+}
+
+// Shelf packing, rows of sprites sorted by height, false if they don't fit
+static bool PackSprites(AtlasSprite **sorted, int count, int width, int height)
+{
+    int x = 0, y = 0, shelfHeight = 0;
+    for (int i = 0; i < count; i++)
+    {
+        AtlasSprite *sprite = sorted[i];
+        if (x + sprite->width > width)
+        {
+            x = 0;
+            y += shelfHeight + ATLAS_PADDING;
+            shelfHeight = 0;
+        }
+        if ((sprite->width > width) || (y + sprite->height > height)) return false;
+
+        sprite->x = x;
+        sprite->y = y;
+        x += sprite->width + ATLAS_PADDING;
+        if (sprite->height > shelfHeight) shelfHeight = sprite->height;
+    }
+    return true;
+}
+
+static int ClampInt(int value, int min, int max)
+{
+    return (value < min)? min : (value > max)? max : value;
+}
+
+// Copy each frame with its edges extruded into the border
+static void DrawSpriteFrames(Image *atlas, const AtlasSprite *sprite)
+{
+    Color *dst = atlas->data;
+    const Color *src = sprite->image.data;
+
+    for (int row = 0; row < sprite->rows; row++)
+    {
+        for (int col = 0; col < sprite->cols; col++)
+        {
+            int borderX = sprite->x + col*sprite->strideX;
+            int borderY = sprite->y + row*sprite->strideY;
+            for (int y = 0; y < sprite->frameHeight + ATLAS_EXTRUDE*2; y++)
+            {
+                for (int x = 0; x < sprite->frameWidth + ATLAS_EXTRUDE*2; x++)
+                {
+                    int srcX = col*sprite->frameWidth + ClampInt(x - ATLAS_EXTRUDE, 0, sprite->frameWidth - 1);
+                    int srcY = row*sprite->frameHeight + ClampInt(y - ATLAS_EXTRUDE, 0, sprite->frameHeight - 1);
+                    dst[(borderY + y)*atlas->width + borderX + x] = src[srcY*sprite->image.width + srcX];
+                }
+            }
+        }
+    }
+}
+
+// Header guard and macro prefix from the header's name, e.g. src/sprites.h is SPRITES and SPRITE
+static void GetHeaderNames(const char *fileName, char *guard, char *prefix)
+{
+    const char *base = GetFileNameWithoutExt(fileName);
+    int length = 0;
+    for (; (base[length] != '\0') && (length < ATLAS_NAME_SIZE - 1); length++)
+        guard[length] = isalnum((unsigned char)base[length])? (char)toupper((unsigned char)base[length]) : '_';
+    guard[length] = '\0';
+
+    strcpy(prefix, guard);
+    if ((length > 1) && (prefix[length - 1] == 'S')) prefix[length - 1] = '\0';
+}
+
+static bool SaveSpriteHeader(const char *fileName, const char *atlasFileName, const char *spriteDir,
+                             const AtlasSprite *sprites, int count, int width, int height)
+{
+    char guard[ATLAS_NAME_SIZE], prefix[ATLAS_NAME_SIZE];
+    GetHeaderNames(fileName, guard, prefix);
+    if (strncmp(spriteDir, "./", 2) == 0) spriteDir += 2; // raylib's prefix for relative paths
+
+    FILE *file = fopen(fileName, "w");
+    if (file == NULL) return false;
+
+    fprintf(file, "// EXPLANATION:\n");
+    fprintf(file, "// Sprite atlas rectangles, generated by `make atlas` from %s/, don't edit\n", spriteDir);
+    fprintf(file, "// Each sprite is its first frame in the atlas and the step to the next frame\n");
+    fprintf(file, "// across and down, see GetSpriteFrame() and src/atlas.c\n\n");
+    fprintf(file, "#ifndef FROGGER_%s_HEADER_GUARD\n#define FROGGER_%s_HEADER_GUARD\n\n", guard, guard);
+    fprintf(file, "// Macros\n// ----------------------------------------------------------------------------\n");
+    fprintf(file, "#define %s_ATLAS_FILE \"%s\"\n", prefix, atlasFileName);
+    fprintf(file, "#define %s_ATLAS_WIDTH  %i\n#define %s_ATLAS_HEIGHT %i\n\n", prefix, width, prefix, height);
+
+    for (int i = 0; i < count; i++)
+    {
+        const AtlasSprite *s = &sprites[i];
+        char name[ATLAS_NAME_SIZE*2];
+        snprintf(name, sizeof(name), "%s_%s", prefix, s->name);
+        fprintf(file, "#define %-23s CLITERAL(Sprite){ { %4i, %4i, %4i, %4i }, { %4i, %4i } } // %ix%i frames\n",
+                name, s->x + ATLAS_EXTRUDE, s->y + ATLAS_EXTRUDE, s->frameWidth, s->frameHeight,
+                s->strideX, s->strideY, s->cols, s->rows);
+    }
+
+    fprintf(file, "\n#endif // FROGGER_%s_HEADER_GUARD\n", guard);
+    return (fclose(file) == 0);
+}
+
+// Main entry point
+int main(int argc, char **argv)
+{
+    if (argc < 4)
+    {
+        fprintf(stderr, "usage: %s <atlas.png> <header.h> <sprites...>\n", argv[0]);
+        return 1;
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+
+    int count = argc - 3;
+    const char **fileNames = (const char **)&argv[3];
+    AtlasSprite *sprites = MemAlloc(count*sizeof(sprites[0]));
+    AtlasSprite **sorted = MemAlloc(count*sizeof(sorted[0]));
+    int status = 0;
+
+    for (int i = 0; (i < count) && (status == 0); i++)
+    {
+        AtlasSprite *sprite = &sprites[i];
+        sorted[i] = sprite;
+        if (!ParseSpriteFileName(sprite, fileNames[i]))
+        {
+            fprintf(stderr, "%s: expected name.png or name.<cols>x<rows>.png, name in [a-z0-9_]\n", fileNames[i]);
+            status = 1;
+            break;
+        }
+        for (int j = 0; j < i; j++)
+        {
+            if (strcmp(sprites[j].name, sprite->name) == 0)
+            {
+                fprintf(stderr, "%s: sprite %s is already in %s\n", fileNames[i], sprite->name, fileNames[j]);
+                status = 1;
+            }
+        }
+
+        sprite->image = LoadImage(fileNames[i]);
+        if (sprite->image.data == NULL)
+        {
+            fprintf(stderr, "failed to read %s\n", fileNames[i]);
+            status = 1;
+            break;
+        }
+        ImageFormat(&sprite->image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        if ((sprite->image.width % sprite->cols != 0) || (sprite->image.height % sprite->rows != 0))
+        {
+            fprintf(stderr, "%s: %ix%i isn't a whole number of %ix%i frames\n", fileNames[i],
+                    sprite->image.width, sprite->image.height, sprite->cols, sprite->rows);
+            status = 1;
+        }
+
+        sprite->frameWidth = sprite->image.width/sprite->cols;
+        sprite->frameHeight = sprite->image.height/sprite->rows;
+        sprite->strideX = sprite->frameWidth + ATLAS_EXTRUDE*2 + ATLAS_PADDING;
+        sprite->strideY = sprite->frameHeight + ATLAS_EXTRUDE*2 + ATLAS_PADDING;
+        sprite->width = sprite->cols*sprite->strideX - ATLAS_PADDING;
+        sprite->height = sprite->rows*sprite->strideY - ATLAS_PADDING;
+    }
+
+    // Smallest power of two area first, the wider shape before the taller one
+    int width = 0, height = 0;
+    if (status == 0)
+    {
+        qsort(sorted, count, sizeof(sorted[0]), CompareSpriteHeight);
+        for (int area = ATLAS_MIN_SIZE*ATLAS_MIN_SIZE; (width == 0) && (area <= ATLAS_MAX_SIZE*ATLAS_MAX_SIZE); area *= 2)
+        {
+            int w = ATLAS_MIN_SIZE;
+            while (w*w < area) w *= 2;
+            int h = area/w;
+            if (PackSprites(sorted, count, w, h)) { width = w; height = h; }
+            else if ((w != h) && PackSprites(sorted, count, h, w)) { width = h; height = w; }
+        }
+        if (width == 0)
+        {
+            fprintf(stderr, "sprites don't fit in %ix%i\n", ATLAS_MAX_SIZE, ATLAS_MAX_SIZE);
+            status = 1;
+        }
+    }
+
+    if (status == 0)
+    {
+        Image atlas = GenImageColor(width, height, BLANK);
+        for (int i = 0; i < count; i++) DrawSpriteFrames(&atlas, &sprites[i]);
+        if (!ExportImage(atlas, argv[1]))
+        {
+            fprintf(stderr, "failed to write %s\n", argv[1]);
+            status = 1;
+        }
+        UnloadImage(atlas);
+    }
+
+    if ((status == 0) && !SaveSpriteHeader(argv[2], argv[1], GetDirectoryPath(fileNames[0]), sprites, count, width, height))
+    {
+        fprintf(stderr, "failed to write %s\n", argv[2]);
+        status = 1;
+    }
+    if (status == 0) printf("%s: %i sprites, %ix%i\n", argv[1], count, width, height);
+
+    for (int i = 0; i < count; i++) UnloadImage(sprites[i].image);
+    MemFree(sprites);
+    MemFree(sorted);
+    return status;
+}
@@ -0,0 +1,219 @@
+// EXPLANATION:
+// Audio mixer on the audio thread, fed by a lock-free event queue
+// See header for more documentation/descriptions
+
+#include "common.h" // all project header includes
+
+#include <string.h> // memset
+
+static AudioMixer *boundMixer; // raylib's stream callback has no user data, there's one audio device
+
+// Event queue
+// ----------------------------------------------------------------------------
+static void PushAudioEvent(AudioMixer *mixer, AudioEvent event)
+{
+    AudioEventQueue *queue = &mixer->queue;
+
+    long writeIdx = queue->writeIdx; // only this thread writes it
+    if (writeIdx - PLATFORM_ATOMIC_LOAD(&queue->readIdx) >= AUDIO_EVENT_QUEUE_SIZE)
+    {
+        mixer->droppedCount++;
+        return;
+    }
+
+    queue->events[writeIdx & (AUDIO_EVENT_QUEUE_SIZE - 1)] = event;
+    PLATFORM_ATOMIC_STORE(&queue->writeIdx, writeIdx + 1); // publishes the event
+}
+
+void PlayGameSound(GameContext *ctx, const GameSound *sound)
+{
+    if (!ctx->audio.isEnabled) return;
+
+    PushAudioEvent(&ctx->audio, (AudioEvent){ .type = AUDIO_EVENT_PLAY_SOUND, .sound = sound });
+}
+
+void PlayGameMusic(GameContext *ctx, GameMusic *music)
+{
+    if (!ctx->audio.isEnabled) return;
+
+    PushAudioEvent(&ctx->audio, (AudioEvent){ .type = AUDIO_EVENT_PLAY_MUSIC, .music = music });
+}
+
+void StopGameMusic(GameContext *ctx)
+{
+    if (!ctx->audio.isEnabled) return;
+
+    PushAudioEvent(&ctx->audio, (AudioEvent){ .type = AUDIO_EVENT_STOP_MUSIC });
+}
+
+// Mixer (audio thread)
+// ----------------------------------------------------------------------------
+static void StartAudioVoice(AudioMixer *mixer, const GameSound *sound)
+{
+    if ((sound->wave.data == NULL) || (sound->wave.frameCount == 0)) return; // not loaded
+
+    AudioVoice *freeVoice = NULL;
+    AudioVoice *oldestInstance = NULL; // of this sound
+    AudioVoice *stealVoice = NULL;     // lowest priority, then furthest along
+    int instanceCount = 0;
+    for (int i = 0; i < AUDIO_MIXER_VOICES; i++)
+    {
+        AudioVoice *voice = &mixer->voices[i];
+        if (voice->sound == NULL)
+        {
+            if (freeVoice == NULL) freeVoice = voice;
+            continue;
+        }
+
+        if (voice->sound == sound)
+        {
+            instanceCount++;
+            if ((oldestInstance == NULL) || (voice->position > oldestInstance->position)) oldestInstance = voice;
+        }
+        if ((stealVoice == NULL) || (voice->sound->priority < stealVoice->sound->priority) ||
+            ((voice->sound->priority == stealVoice->sound->priority) && (voice->position > stealVoice->position)))
+            stealVoice = voice;
+    }
+
+    int maxVoices = (sound->maxVoices > 1)? sound->maxVoices : 1;
+    if (instanceCount >= maxVoices) oldestInstance->position = 0; // restart it, like a single raylib Sound
+    else if (freeVoice != NULL) *freeVoice = (AudioVoice){ .sound = sound };
+    else if (stealVoice->sound->priority <= sound->priority)
+    {
+        *stealVoice = (AudioVoice){ .sound = sound };
+        mixer->stolenCount++;
+    }
+    else mixer->skippedCount++;
+}
+
+static void TakeAudioEvents(AudioMixer *mixer)
+{
+    AudioEventQueue *queue = &mixer->queue;
+
+    long readIdx = queue->readIdx; // only this thread writes it
+    long writeIdx = PLATFORM_ATOMIC_LOAD(&queue->writeIdx);
+    for (; readIdx != writeIdx; readIdx++)
+    {
+        AudioEvent *event = &queue->events[readIdx & (AUDIO_EVENT_QUEUE_SIZE - 1)];
+        switch (event->type)
+        {
+            case AUDIO_EVENT_PLAY_SOUND:
+                StartAudioVoice(mixer, event->sound);
+                break;
+            case AUDIO_EVENT_PLAY_MUSIC:
+                mixer->music = event->music;
+                RewindGameMusic(mixer->music);
+                break;
+            case AUDIO_EVENT_STOP_MUSIC:
+                mixer->music = NULL;
+                break;
+        }
+    }
+    PLATFORM_ATOMIC_STORE(&queue->readIdx, readIdx); // the slots can be reused
+}
+
+static void MixAudioVoices(AudioMixer *mixer, float *mix, int frameCount)
+{
+    int voiceCount = 0;
+    for (int i = 0; i < AUDIO_MIXER_VOICES; i++)
+    {
+        AudioVoice *voice = &mixer->voices[i];
+        if (voice->sound == NULL) continue;
+        voiceCount++;
+
+        const short *samples = (const short *)voice->sound->wave.data + voice->position;
+        unsigned int remaining = voice->sound->wave.frameCount - voice->position;
+        int count = (remaining < (unsigned int)frameCount)? (int)remaining : frameCount;
+        float volume = voice->sound->volume;
+        for (int j = 0; j < count; j++) mix[j] += samples[j]*volume;
+
+        voice->position += count;
+        if (voice->position >= voice->sound->wave.frameCount) voice->sound = NULL;
+    }
+
+    mixer->voiceCount = voiceCount;
+    if (voiceCount > mixer->voiceCountMax) mixer->voiceCountMax = voiceCount;
+}
+
+void MixAudioFrames(AudioMixer *mixer, short *out, int frames)
+{
+    double startTime = GetTime();
+    TakeAudioEvents(mixer);
+
+    while (frames > 0)
+    {
+        int count = (frames < AUDIO_MIX_FRAMES)? frames : AUDIO_MIX_FRAMES;
+        memset(mixer->mix, 0, count*sizeof(mixer->mix[0]));
+
+        if (mixer->music != NULL) MixGameMusic(mixer->music, mixer->mix, count);
+        MixAudioVoices(mixer, mixer->mix, count);
+
+        for (int i = 0; i < count; i++)
+        {
+            float sample = mixer->mix[i];
+            out[i] = (short)((sample < -32768.0f)? -32768.0f : (sample > 32767.0f)? 32767.0f : sample);
+        }
+        out += count;
+        frames -= count;
+    }
+
+    float mixTime = (float)(GetTime() - startTime);
+    mixer->mixTime = mixTime;
+    if (mixTime > mixer->mixTimeMax) mixer->mixTimeMax = mixTime;
+    mixer->mixCount++;
+}
+
+static void MixAudioCallback(void *bufferData, unsigned int frames)
+{
+    MixAudioFrames(boundMixer, bufferData, (int)frames);
+}
+
+// Game thread
+// ----------------------------------------------------------------------------
+void InitAudioMixer(GameContext *ctx)
+{
+    AudioMixer *mixer = &ctx->audio;
+
+    *mixer = (AudioMixer){ 0 };
+    if (!IsAudioDeviceReady() || (boundMixer != NULL)) return;
+
+    mixer->stream = LoadAudioStream(AUDIO_SAMPLE_RATE, 16, 1);
+    if (!IsAudioStreamValid(mixer->stream)) return;
+
+    boundMixer = mixer;
+    SetAudioStreamCallback(mixer->stream, MixAudioCallback);
+    PlayAudioStream(mixer->stream);
+    mixer->isEnabled = true;
+}
+
+void SilenceAudioMixer(GameContext *ctx)
+{
+    AudioMixer *mixer = &ctx->audio;
+
+    if (!mixer->isEnabled) return;
+
+    // raylib holds its audio lock while it mixes streams, so once the stream is
+    // stopped the callback isn't running and the mixer state is ours
+    StopAudioStream(mixer->stream);
+    memset(mixer->voices, 0, sizeof(mixer->voices));
+    mixer->music = NULL;
+    mixer->queue.readIdx = mixer->queue.writeIdx; // drop what wasn't taken yet
+    PlayAudioStream(mixer->stream);
+}
+
+void CloseAudioMixer(GameContext *ctx)
+{
+    AudioMixer *mixer = &ctx->audio;
+
+    if (!mixer->isEnabled) return;
+
+    StopAudioStream(mixer->stream);
+    UnloadAudioStream(mixer->stream);
+    boundMixer = NULL;
+    mixer->isEnabled = false;
+
+    TraceLog(LOG_INFO, "AUDIO: %li mixes, slowest %.1f us, %i events dropped",
+             mixer->mixCount, mixer->mixTimeMax*1e6f, mixer->droppedCount);
+    TraceLog(LOG_INFO, "AUDIO: %i of %i voices at most, %li stolen, %li sounds skipped",
+             mixer->voiceCountMax, AUDIO_MIXER_VOICES, mixer->stolenCount, mixer->skippedCount);
+}
@@ -0,0 +1,93 @@
+// EXPLANATION:
+// Audio mixer on the audio thread, fed by a lock-free event queue
+// Gameplay doesn't call raylib's sound functions, it pushes play/stop events
+// into a single-producer single-consumer ring. The mixer is the callback of one
+// raylib audio stream, it runs on the audio device's thread, takes the events,
+// and mixes the sounds' samples and the decoded music (music.h) itself. The
+// game thread never waits on audio or decodes music, and without a mixer
+// (headless simulations, audio muted) pushing an event is a single check.
+// Only the game thread pushes events, only the audio thread takes them.
+//
+// Voices come from a fixed pool, nothing is allocated while playing. Each
+// sound can play on up to maxVoices voices at once (like raylib's sound
+// aliases sharing one wave), playing it past that restarts its oldest voice.
+// When the pool is full, a new sound takes the voice of the lowest priority
+// sound that's furthest along, if that priority isn't above its own.
+
+#ifndef FROGGER_AUDIO_HEADER_GUARD
+#define FROGGER_AUDIO_HEADER_GUARD
+
+// Macros
+// ----------------------------------------------------------------------------
+#define AUDIO_EVENT_QUEUE_SIZE 64 // power of two, a frame only makes a few events
+#define AUDIO_MIXER_VOICES 32 // enough for several frogs hopping at once
+#define AUDIO_MIX_FRAMES 512      // mixed per step, callbacks can ask for any amount
+
+// Types and Structures
+// ----------------------------------------------------------------------------
+typedef enum {
+    AUDIO_PRIORITY_LOW,    // frequent and short, e.g. hops
+    AUDIO_PRIORITY_NORMAL,
+    AUDIO_PRIORITY_HIGH,   // events the player must hear, e.g. deaths
+} AudioPriority;
+
+typedef struct {
+    Wave wave;     // AUDIO_SAMPLE_RATE, 16-bit mono, see QueueGameSound()
+    float volume;
+    int maxVoices; // instances playing at once, at least 1
+    int priority;  // AudioPriority
+} GameSound;
+
+typedef enum {
+    AUDIO_EVENT_PLAY_SOUND,
+    AUDIO_EVENT_PLAY_MUSIC, // from the start
+    AUDIO_EVENT_STOP_MUSIC,
+} AudioEventType;
+
+typedef struct {
+    AudioEventType type;
+    const GameSound *sound;
+    GameMusic *music;
+} AudioEvent;
+
+typedef struct {
+    AudioEvent events[AUDIO_EVENT_QUEUE_SIZE];
+    volatile long writeIdx, readIdx; // only ever increase, wrapped by the size
+} AudioEventQueue;
+
+typedef struct {
+    const GameSound *sound; // NULL when free
+    unsigned int position;  // next frame
+} AudioVoice;
+
+typedef struct {
+    bool isEnabled; // sounds and music are dropped without a mixer
+    AudioStream stream;
+    AudioEventQueue queue;
+    int droppedCount; // events pushed while the queue was full
+
+    // Audio thread only, while the stream plays
+    AudioVoice voices[AUDIO_MIXER_VOICES];
+    GameMusic *music; // NULL when stopped
+    float mix[AUDIO_MIX_FRAMES];
+
+    // Written by the audio thread, read for the debug info
+    volatile float mixTime, mixTimeMax; // seconds, last and slowest callback
+    volatile long mixCount;
+    volatile int voiceCount, voiceCountMax;
+    volatile long stolenCount, skippedCount; // voices taken from other sounds, sounds that found none
+} AudioMixer;
+
+// Prototypes
+// ----------------------------------------------------------------------------
+void InitAudioMixer(GameContext *ctx);  // Start mixing, after InitAudioDevice()
+void CloseAudioMixer(GameContext *ctx); // Stop mixing and log the mix times, before unloading sounds or CloseAudioDevice()
+void SilenceAudioMixer(GameContext *ctx); // Stop all sounds and music now, before unloading any of them
+
+void PlayGameSound(GameContext *ctx, const GameSound *sound); // On a new voice, see above for when there's none free
+void PlayGameMusic(GameContext *ctx, GameMusic *music);       // From the start of its intro
+void StopGameMusic(GameContext *ctx);
+
+void MixAudioFrames(AudioMixer *mixer, short *out, int frames); // The audio thread's work: take the events, then mix (stream callback)
+
+#endif // FROGGER_AUDIO_HEADER_GUARD
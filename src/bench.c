@@ -0,0 +1,325 @@
+// EXPLANATION:
+// Benchmark suite for the game simulation and renderer
+// Builds the game modules without the platform game loop and times them
+//
+// Usage: frogger_bench [--filter <name>] [--out <file>] [--draw]
+// Results are written as JSON lines (one object per benchmark), so runs on
+// different commits can be compared by a script.
+// Drawing benchmarks need a window (--draw, requires a display), otherwise
+// they are reported as skipped.
+
+#include "common.h" // all project header includes
+
+#include <stdio.h>
+#include <string.h>
+
+#include "sim_tools.h" // timer
+
+// Benchmark settings
+#define BENCH_SEED 12345
+#define BENCH_FRAME_TIME (1.0f/60.0f)
+#define BENCH_SAMPLES 7               // timed samples per benchmark, median is reported
+#define BENCH_SAMPLE_TARGET_NS 20e6   // aim for ~20ms per sample
+#define BENCH_WARMUP_OPS 16
+
+// Types and Structures
+// ----------------------------------------------------------------------------
+typedef void (*BenchFunc)(GameContext *ctx, long long ops);
+
+typedef struct {
+    const char *name;
+    BenchFunc run;
+    int entityCount; // 0 = keep the default level layout
+    bool needsWindow;
+} Benchmark;
+
+// Local Functions Declaration
+// ----------------------------------------------------------------------------
+static void BenchResetGame(GameContext *ctx, int entityCount);
+static void BenchPrintResult(GameContext *ctx, FILE *out, const Benchmark *bench, long long ops, double *samples);
+
+static void BenchCreateNextLevel(GameContext *ctx, long long ops);
+static void BenchUpdateGameFrame(GameContext *ctx, long long ops);
+static void BenchGetEntityRec(GameContext *ctx, long long ops);
+static void BenchCollisionQuery(GameContext *ctx, long long ops);
+static void BenchProcessUserInput(GameContext *ctx, long long ops);
+static void BenchInputActions(GameContext *ctx, long long ops);
+static void BenchDrawGameFrame(GameContext *ctx, long long ops);
+static void BenchDrawLaneStrips(GameContext *ctx, long long ops);
+static void BenchDrawUiLayer(GameContext *ctx, long long ops);
+
+static volatile int benchSink; // keeps results observable so the work isn't optimized out
+
+static const Benchmark benchmarks[] = {
+    { "CreateNextLevel",  BenchCreateNextLevel,  0,     false },
+    { "UpdateGameFrame",  BenchUpdateGameFrame,  1,     false },
+    { "UpdateGameFrame",  BenchUpdateGameFrame,  100,   false },
+    { "UpdateGameFrame",  BenchUpdateGameFrame,  10000, false },
+    { "GetEntityRec",     BenchGetEntityRec,     100,   false },
+    { "GetEntityRec",     BenchGetEntityRec,     10000, false },
+    { "CollisionQuery",   BenchCollisionQuery,   100,   false },
+    { "CollisionQuery",   BenchCollisionQuery,   10000, false },
+    { "ProcessUserInput", BenchProcessUserInput, 0,     false },
+    { "InputActions",     BenchInputActions,     0,     false },
+    { "DrawGameFrame",    BenchDrawGameFrame,    0,     true  },
+    { "DrawGameFrame",    BenchDrawGameFrame,    10000, true  },
+    { "DrawLaneStrips",   BenchDrawLaneStrips,   0,     true  },
+    { "DrawUiLayer",      BenchDrawUiLayer,      0,     true  },
+};
+
+// Main entry point
+int main(int argc, char **argv)
+{
+    const char *filter = NULL;
+    const char *outPath = NULL;
+    bool drawEnabled = false;
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--filter") && (i + 1 < argc)) filter = argv[++i];
+        else if (!strcmp(argv[i], "--out") && (i + 1 < argc)) outPath = argv[++i];
+        else if (!strcmp(argv[i], "--draw")) drawEnabled = true;
+        else
+        {
+            fprintf(stderr, "usage: %s [--filter <name>] [--out <file>] [--draw]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    FILE *out = stdout;
+    if (outPath && !(out = fopen(outPath, "w")))
+    {
+        fprintf(stderr, "bench: could not open %s\n", outPath);
+        return 1;
+    }
+
+    SetTraceLogLevel(LOG_NONE); // keep the output machine-readable
+
+    static GameContext context = { 0 };
+    GameContext *ctx = &context;
+
+    // Drawing needs a GPU context, use a hidden window
+    // (raylib 5.5 crashes if the window can't be created, so this is opt-in)
+    if (drawEnabled)
+    {
+        SetConfigFlags(PlatformWindowFlags());
+        InitWindow(INITIAL_WIDTH, INITIAL_HEIGHT, WINDOW_TITLE " (bench)");
+        if (IsWindowReady())
+        {
+            SetTargetFPS(0);
+            InitViewport(ctx);
+        }
+    }
+
+    InitUiState(ctx);
+    InitDefaultInputSettings(ctx);
+
+    for (int b = 0; b < (int)(sizeof(benchmarks)/sizeof(benchmarks[0])); b++)
+    {
+        const Benchmark *bench = &benchmarks[b];
+        if (filter && !strstr(bench->name, filter)) continue;
+
+        if (bench->needsWindow && !IsWindowReady())
+        {
+            fprintf(out, "{\"name\":\"%s\",\"entities\":%i,\"skipped\":\"needs --draw\"}\n",
+                    bench->name, bench->entityCount);
+            continue;
+        }
+
+        BenchResetGame(ctx, bench->entityCount);
+        bench->run(ctx, BENCH_WARMUP_OPS);
+
+        // Calibrate the op count so a sample takes roughly the target time
+        long long ops = 1;
+        for (;;)
+        {
+            double start = GetClockTimeNs();
+            bench->run(ctx, ops);
+            double elapsed = GetClockTimeNs() - start;
+            if ((elapsed > BENCH_SAMPLE_TARGET_NS/4) || (ops >= (1LL << 30))) break;
+            ops *= 2;
+        }
+        ops *= 4;
+
+        double samples[BENCH_SAMPLES];
+        for (int i = 0; i < BENCH_SAMPLES; i++)
+        {
+            BenchResetGame(ctx, bench->entityCount);
+            double start = GetClockTimeNs();
+            bench->run(ctx, ops);
+            samples[i] = (GetClockTimeNs() - start)/(double)ops;
+        }
+
+        BenchPrintResult(ctx, out, bench, ops, samples);
+        fflush(out);
+    }
+
+    // De-Initialization
+    // ----------------------------------------------------------------------------
+    FreeGameState(ctx);
+    FreeUiState(ctx);
+    if (IsWindowReady())
+    {
+        UnloadShader(ctx->viewport.shader);
+        UnloadRenderTexture(ctx->viewport.renderTarget);
+        CloseWindow();
+    }
+    if (out != stdout) fclose(out);
+
+    return 0;
+}
+
+// Harness
+// ----------------------------------------------------------------------------
+// Start a fresh, deterministic game on level 1
+// A nonzero entity count replaces the level with that many entities (frog included),
+// cycling through copies of the level's own entities
+static void BenchResetGame(GameContext *ctx, int entityCount)
+{
+    GameState *game = &ctx->game;
+
+    FreeGameState(ctx);
+    InitGameStateEx(ctx, BENCH_SEED);
+    game->currentScreen = SCREEN_GAMEPLAY;
+    game->frameTime = BENCH_FRAME_TIME;
+    ctx->ui.currentMenu = UI_MENU_NONE;
+
+    if (entityCount <= 0) return;
+
+    // The level stays in the arena, the copies go after it
+    Entity *level = game->entities;
+    int levelCount = game->entityCount - 1; // minus the frog
+    game->entities = arena_alloc(&game->levelArena, entityCount*sizeof(Entity));
+    game->entityCount = game->entityCapacity = entityCount;
+
+    for (int i = 0; i < entityCount - 1; i++)
+        game->entities[i] = level[i % levelCount];
+    game->entities[entityCount - 1] = level[levelCount];
+    game->frog = &game->entities[entityCount - 1];
+    LayoutLaneStrips(ctx);
+}
+
+static int CompareDouble(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static void BenchPrintResult(GameContext *ctx, FILE *out, const Benchmark *bench, long long ops, double *samples)
+{
+    qsort(samples, BENCH_SAMPLES, sizeof(samples[0]), CompareDouble);
+    fprintf(out, "{\"name\":\"%s\",\"entities\":%i,\"ops\":%lld,\"samples\":%i,"
+                 "\"ns_per_op\":%.1f,\"ns_per_op_min\":%.1f,\"ns_per_op_max\":%.1f}\n",
+            bench->name, (bench->entityCount > 0)? bench->entityCount : ctx->game.entityCount,
+            ops, BENCH_SAMPLES, samples[BENCH_SAMPLES/2], samples[0], samples[BENCH_SAMPLES - 1]);
+}
+
+// Benchmarks
+// ----------------------------------------------------------------------------
+static void BenchCreateNextLevel(GameContext *ctx, long long ops)
+{
+    for (long long i = 0; i < ops; i++)
+        CreateNextLevel(ctx);
+}
+
+static void BenchUpdateGameFrame(GameContext *ctx, long long ops)
+{
+    for (long long i = 0; i < ops; i++)
+    {
+        ctx->game.frameCount++;
+        UpdateGameFrame(ctx);
+    }
+}
+
+// Placing every moving entity at the current level time, what drawing them all costs
+static void BenchGetEntityRec(GameContext *ctx, long long ops)
+{
+    GameState *game = &ctx->game;
+
+    float sum = 0;
+    for (long long i = 0; i < ops; i++)
+    {
+        game->levelTime += BENCH_FRAME_TIME;
+        for (int j = 0; j < game->entityCount; j++)
+            if (game->entities[j].flags & ENTITY_FLAG_MOVE)
+                sum += GetEntityRec(ctx, &game->entities[j]).x;
+    }
+    benchSink = (int)sum;
+}
+
+// The checks UpdateHostile() and UpdatePlatform() do, from a random grid cell each query
+static void BenchCollisionQuery(GameContext *ctx, long long ops)
+{
+    GameState *game = &ctx->game;
+
+    int hits = 0;
+    for (long long i = 0; i < ops; i++)
+    {
+        Vector2 frogPos = GetGridPosition(ctx, GetGameRandomValue(ctx, 1, GRID_RES_X - 2), GetGameRandomValue(ctx, 2, 14));
+        frogPos.x += GRID_UNIT/2;
+        frogPos.y += GRID_UNIT/2;
+
+        for (int j = 0; j < game->entityCount; j++)
+        {
+            Entity *e = &game->entities[j];
+            if ((frogPos.y < e->rec.y) || (frogPos.y > e->rec.y + e->rec.height)) continue; // other rows aren't placed
+            Rectangle rec = GetEntityRec(ctx, e);
+            if ((e->flags & ENTITY_FLAG_KILL) &&
+                CheckCollisionCircleRec(frogPos, game->frog->radius*0.75f, rec))
+                hits++;
+            if ((e->flags & ENTITY_FLAG_PLATFORM) && CheckCollisionPointRec(frogPos, rec))
+                hits++;
+        }
+    }
+    benchSink = hits;
+}
+
+static void BenchProcessUserInput(GameContext *ctx, long long ops)
+{
+    for (long long i = 0; i < ops; i++)
+        ProcessUserInput(ctx, INPUT_POLL_ALL);
+    benchSink = ctx->input.player.moveUp;
+}
+
+// Only the action mappings (global, menu and player), no mouse/touch/gamepad polling
+static void BenchInputActions(GameContext *ctx, long long ops)
+{
+    for (long long i = 0; i < ops; i++)
+        ProcessUserInput(ctx, INPUT_POLL_GLOBAL | INPUT_POLL_MENU | INPUT_POLL_PLAYER);
+    benchSink = ctx->input.player.moveUp;
+}
+
+// Includes submitting the batch to the GPU, EndTextureMode() flushes it
+static void BenchDrawGameFrame(GameContext *ctx, long long ops)
+{
+    for (long long i = 0; i < ops; i++)
+    {
+        BeginTextureMode(ctx->viewport.renderTarget);
+            BeginMode2D(ctx->game.camera);
+                DrawGameFrame(ctx);
+            EndMode2D();
+        EndTextureMode();
+    }
+}
+
+// The same frame with the moving lanes drawn as baked strips, see lanes.h
+static void BenchDrawLaneStrips(GameContext *ctx, long long ops)
+{
+    ctx->lanes.isEnabled = true;
+    UpdateLaneStrips(ctx);
+    BenchDrawGameFrame(ctx, ops);
+    ctx->lanes.isEnabled = false;
+}
+
+// HUD and pause menu text, what a UI layer redraw costs
+static void BenchDrawUiLayer(GameContext *ctx, long long ops)
+{
+    ctx->ui.currentMenu = UI_MENU_PAUSE;
+    for (long long i = 0; i < ops; i++)
+    {
+        BeginTextureMode(ctx->viewport.renderTarget);
+            BeginMode2D(ctx->game.camera);
+                DrawUiLayer(ctx);
+            EndMode2D();
+        EndTextureMode();
+    }
+}
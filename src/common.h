@@ -6,19 +6,33 @@
 
 // External Headers
 // ----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h> // stb_ds only includes it for its default allocator
 #include "raylib.h"
 #include "raymath.h"
 
-#define STB_DS_IMPLEMENTATION
-#include "stb_ds.h" // for dynamic arrays
+// Library allocations go through the allocation tracker, see alloc.h
+void *TrackedRealloc(void *ptr, size_t size);
+void TrackedFree(void *ptr);
+#define STBDS_REALLOC(context, ptr, size) TrackedRealloc(ptr, size)
+#define STBDS_FREE(context, ptr) TrackedFree(ptr)
 
-#define ARENA_IMPLEMENTATION
+#include "stb_ds.h" // for dynamic arrays, implemented in external.c
 #include "arena.h"
 
 // Project Headers
 // ----------------------------------------------------------------------------
+typedef struct GameContext GameContext; // all state of one game, see context.h
+
 #include "config.h"   // program config, e.g. window title/size, fps, vsync
+#include "platform.h" // platform layer, e.g. desktop/web specific settings
 #include "rl_utils.h" // raylib extra convenience
+#include "sprites.h"  // sprite atlas rectangles, generated by `make atlas`
+#include "controls.h" // touch control atlas rectangles, generated by `make atlas`
+#include "archive.h"  // packed asset archive
+#include "jobs.h"     // job queue for worker threads
+#include "music.h"    // streaming QOA music
+#include "audio.h"    // audio mixer and its event queue
 
 // Modules
 #include "frogger.h"
@@ -26,6 +40,13 @@
 #include "input.h"    // input actions and helpers
 #include "logo.h"     // startup raylib logo animation
 #include "ui.h"       // user interface
+#include "latency.h"  // input latency instrumentation
+#include "pacing.h"   // frame pacing and late input polling
+#include "frame_arena.h" // per-frame scratch memory
+#include "alloc.h"    // allocation tracker
+#include "loader.h"   // background asset loading
+#include "lanes.h"    // moving lanes drawn as scrolling strips
+#include "context.h"  // game context, holds the state of all the above
 
 
 #endif // FROGGER_COMMON_HEADER_GUARD
@@ -21,7 +21,13 @@
 // there may be small bugs with very high FPS (uncapped + no vsync), but should work fine overall
 #define MAX_FRAMERATE 300 // Set to 0 for uncapped framerate
 #define VSYNC_ENABLED true
+#define LATE_LATCH_INPUT true // With vsync, wait and poll input as late as possible each frame
+#define LANE_STRIPS_ENABLED true // Draw each moving lane as one scrolling quad, see lanes.h
 
 #define DEBUG_DEFAULT false
 
+#define AUDIO_SAMPLE_RATE 44100 // the mixer's output, sounds are converted to it when loaded
+
+#define ASSET_ARCHIVE_FILE "assets.pak" // built by `make pack`, loose files in assets/ are used without it
+
 #endif // FROGGER_CONFIG_HEADER_GUARD
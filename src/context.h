@@ -0,0 +1,26 @@
+// EXPLANATION:
+// All the state of one running game, passed explicitly to every subsystem
+// so several games can exist in one process (e.g. tests, soak runner)
+
+#ifndef FROGGER_CONTEXT_HEADER_GUARD
+#define FROGGER_CONTEXT_HEADER_GUARD
+
+// Types and Structures
+// ----------------------------------------------------------------------------
+struct GameContext {
+    GameState game;
+    InputState input;
+    InputActionMaps inputMaps; // input action controls
+    UiState ui;
+    RenderData viewport;
+    LogoAnimationState logo;
+    LatencyTracker latency;
+    FramePacer pacer;
+    FrameArena frame; // scratch memory, reset every frame
+    AllocTracker alloc;
+    AssetLoader loader; // background asset loads
+    AudioMixer audio;
+    LaneStrips lanes; // moving lanes baked for the level
+};
+
+#endif // FROGGER_CONTEXT_HEADER_GUARD
@@ -0,0 +1,20 @@
+// EXPLANATION:
+// Sprite atlas rectangles, generated by `make atlas` from art/controls/, don't edit
+// Each sprite is its first frame in the atlas and the step to the next frame
+// across and down, see GetSpriteFrame() and src/atlas.c
+
+#ifndef FROGGER_CONTROLS_HEADER_GUARD
+#define FROGGER_CONTROLS_HEADER_GUARD
+
+// Macros
+// ----------------------------------------------------------------------------
+#define CONTROL_ATLAS_FILE "assets/textures/controls.png"
+#define CONTROL_ATLAS_WIDTH  1024
+#define CONTROL_ATLAS_HEIGHT 512
+
+#define CONTROL_ANALOG_BASE     CLITERAL(Sprite){ {    1,    1,  256,  256 }, {  259,  259 } } // 1x1 frames
+#define CONTROL_ANALOG_STICK    CLITERAL(Sprite){ {  519,    1,  128,  128 }, {  131,  131 } } // 1x1 frames
+#define CONTROL_DPAD            CLITERAL(Sprite){ {  260,    1,  256,  256 }, {  259,  259 } } // 1x1 frames
+#define CONTROL_PAUSE           CLITERAL(Sprite){ {  650,    1,  128,  128 }, {  131,  131 } } // 1x1 frames
+
+#endif // FROGGER_CONTROLS_HEADER_GUARD
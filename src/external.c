@@ -0,0 +1,21 @@
+// EXPLANATION:
+// Implementations of the single header libraries in deps/
+// Compiled once here, every other file only includes their declarations
+
+#include <stdio.h>
+#include <stdlib.h> // before the malloc/free redirect below
+
+#include "common.h" // the allocation hooks, stb_ds picks them up from here
+
+#define STB_DS_IMPLEMENTATION
+#include "stb_ds.h" // for dynamic arrays
+#undef STB_DS_IMPLEMENTATION // not include guarded, unity.c includes the headers again
+
+// arena.h has no allocation hooks, redirect its region allocations
+#define malloc(size) TrackedRealloc(NULL, size)
+#define free(ptr) TrackedFree(ptr)
+#define ARENA_IMPLEMENTATION
+#include "arena.h"
+#undef ARENA_IMPLEMENTATION
+#undef malloc
+#undef free
@@ -0,0 +1,101 @@
+// EXPLANATION:
+// Scratch memory that lives for one frame
+// See header for more documentation/descriptions
+
+#include "common.h" // all project header includes
+
+#include <stdarg.h> // va_list
+#include <string.h> // memset
+
+// Stored in front of every allocation, keeps the memory after it 8-byte aligned
+typedef struct {
+    unsigned int frame;
+    unsigned int size;
+} FrameAllocHeader;
+
+void ResetFrameArena(GameContext *ctx)
+{
+    FrameArena *frame = &ctx->frame;
+
+    if (frame->usedBytes > frame->highWaterBytes) frame->highWaterBytes = frame->usedBytes;
+    if (frame->allocCount > frame->highWaterAllocs) frame->highWaterAllocs = frame->allocCount;
+
+    // Old data and headers become garbage, so stale reads stand out
+    if (ctx->game.isDebugMode)
+    {
+        for (Region *r = frame->arena.begin; r != NULL; r = r->next)
+            memset(r->data, FRAME_ARENA_POISON, r->count*sizeof(r->data[0]));
+    }
+
+    arena_reset(&frame->arena);
+    frame->frame++;
+    frame->usedBytes = 0;
+    frame->allocCount = 0;
+}
+
+void *FrameAlloc(GameContext *ctx, size_t size)
+{
+    FrameArena *frame = &ctx->frame;
+
+    size_t allocSize = sizeof(FrameAllocHeader) + size;
+    FrameAllocHeader *header = arena_alloc(&frame->arena, allocSize);
+
+    *header = (FrameAllocHeader){ frame->frame, (unsigned int)size };
+    memset(header + 1, 0, size);
+
+    frame->usedBytes += allocSize;
+    frame->allocCount++;
+    return header + 1;
+}
+
+char *FrameTextFormat(GameContext *ctx, const char *format, ...)
+{
+    va_list args, argsCopy;
+    va_start(args, format);
+    va_copy(argsCopy, args);
+
+    int length = vsnprintf(NULL, 0, format, args);
+    if (length < 0) length = 0;
+    char *text = FrameAlloc(ctx, (size_t)length + 1);
+    vsnprintf(text, (size_t)length + 1, format, argsCopy);
+
+    va_end(argsCopy);
+    va_end(args);
+    return text;
+}
+
+bool IsFrameAllocValid(GameContext *ctx, const void *ptr)
+{
+    FrameArena *frame = &ctx->frame;
+
+    if (!ctx->game.isDebugMode || (ptr == NULL)) return true;
+
+    const FrameAllocHeader *header = (const FrameAllocHeader *)ptr - 1;
+    if (header->frame == frame->frame) return true;
+
+    frame->staleCount++;
+    TraceLog(LOG_WARNING, "FRAME: Memory from frame %u used in frame %u", header->frame, frame->frame);
+    return false;
+}
+
+void PrintFrameArenaReport(GameContext *ctx)
+{
+    FrameArena *frame = &ctx->frame;
+
+    if (frame->highWaterAllocs == 0) return;
+
+    // Regions are only ever added, more than one means a frame outgrew the first
+    int regionCount = 0;
+    for (Region *r = frame->arena.begin; r != NULL; r = r->next) regionCount++;
+
+    TraceLog(LOG_INFO, "FRAME: Arena high water %i bytes in %i allocations, %i regions, %i stale uses",
+             (int)frame->highWaterBytes, frame->highWaterAllocs, regionCount, frame->staleCount);
+}
+
+void FreeFrameArena(GameContext *ctx)
+{
+    FrameArena *frame = &ctx->frame;
+
+    arena_free(&frame->arena);
+    *frame = (FrameArena){ 0 };
+}
@@ -0,0 +1,42 @@
+// EXPLANATION:
+// Scratch memory that lives for one frame
+// UpdateDrawFrame() resets the arena first thing, anything allocated from it
+// (formatted text, draw lists, query results) is gone by the next frame.
+// The arena keeps its regions between frames, so once the busiest frame has
+// been seen nothing on the frame path touches malloc.
+// In debug mode, freed memory is overwritten with FRAME_ARENA_POISON and each
+// allocation remembers its frame, so IsFrameAllocValid() catches a pointer
+// kept past the reset. The high-water marks are shown in the debug info.
+
+#ifndef FROGGER_FRAME_ARENA_HEADER_GUARD
+#define FROGGER_FRAME_ARENA_HEADER_GUARD
+
+// Macros
+// ----------------------------------------------------------------------------
+#define FRAME_ARENA_POISON 0xDD // byte written over the last frame's memory in debug mode
+
+#define FrameAllocArray(ctx, type, count) ((type *)FrameAlloc((ctx), sizeof(type)*(count)))
+
+// Types and Structures
+// ----------------------------------------------------------------------------
+typedef struct {
+    Arena arena;
+    unsigned int frame; // bumped by every reset, allocations remember it
+
+    // This frame and the most in any frame, bytes include the headers
+    size_t usedBytes, highWaterBytes;
+    int allocCount, highWaterAllocs;
+
+    int staleCount; // stale pointers caught by IsFrameAllocValid()
+} FrameArena;
+
+// Prototypes
+// ----------------------------------------------------------------------------
+void ResetFrameArena(GameContext *ctx); // Start a new frame, frees everything from the last one
+void *FrameAlloc(GameContext *ctx, size_t size); // Zeroed memory, valid until the next reset
+char *FrameTextFormat(GameContext *ctx, const char *format, ...); // Like TextFormat(), but not shared between contexts or limited in length
+bool IsFrameAllocValid(GameContext *ctx, const void *ptr); // Was ptr allocated this frame (always true outside debug mode)
+void PrintFrameArenaReport(GameContext *ctx);
+void FreeFrameArena(GameContext *ctx);
+
+#endif // FROGGER_FRAME_ARENA_HEADER_GUARD
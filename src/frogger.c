@@ -2,24 +2,100 @@
 // All the game logic, including how/when to draw to screen
 // See header for more documentation/descriptions
 
+#include "common.h" // all project header includes
+
+// Level layouts
+// ----------------------------------------------------------------------------
+
+static const LevelRow levelOneRows[] = {
+    // Win zones
+    { ENTITY_TYPE_WALL,   2,  ".O_OO_OO_OO_OO_O.", 0 },
+    { ENTITY_TYPE_WIN,    2,  "._O__O__O__O__O_.", 0 },
+
+    // River
+    { ENTITY_TYPE_LOG,    3,  "_OOOO_.OOOO_.OOOO", 0.8f },
+    { ENTITY_TYPE_TURTLE, 4,  "___SS_.OO_.OO_.OO", -1 },
+    { ENTITY_TYPE_LOG,    5,  "__OOOOOO__OOOOOO",  2 },
+    { ENTITY_TYPE_LOG,    6,  "___OOO__OOO__OOO",  0.5f },
+    { ENTITY_TYPE_TURTLE, 7,  "_FFF_OOO_OOO_OOO",  -1 },
+
+    // Road, Cars
+    { ENTITY_TYPE_CAR,    9,  "________.OO___.OO", -1 },
+    { ENTITY_TYPE_CAR,    10, "O_______________",  0.6f },
+    { ENTITY_TYPE_CAR,    11, "_______O___O___O",  -0.6f },
+    { ENTITY_TYPE_CAR,    12, "_______O___O___O",  0.4f },
+    { ENTITY_TYPE_CAR,    13, "______O___.O___.O", -0.4f },
+};
+
+static const LevelRow levelTwoRows[] = {
+    // Win zones
+    { ENTITY_TYPE_WALL,   2,  ".O_OO_OO_OO_OO_O.", 0 },
+    { ENTITY_TYPE_WIN,    2,  "._O__O__O__O__O_.", 0 },
+
+    // River
+    { ENTITY_TYPE_LOG,    3,  "______.OOOO_.OOOO", 0.8f },
+    { ENTITY_TYPE_CROC,   3,  "__OOX_._____.____", 0.8f },
+    { ENTITY_TYPE_TURTLE, 4,  "OO_SS_.OO_.OO_.OO", -1 },
+    { ENTITY_TYPE_LOG,    5,  "__OOOOOO________",  2 },
+    { ENTITY_TYPE_LOG,    6,  "___OOO__OOO__OOO",  0.5f },
+    { ENTITY_TYPE_TURTLE, 7,  "_FFF_____OOO_OOO",  -1 },
+
+    // Road, Cars
+    { ENTITY_TYPE_CAR,    9,  "___OO___.OO___.OO", -1 },
+    { ENTITY_TYPE_CAR,    10, "O_.O____________",  0.6f },
+    { ENTITY_TYPE_CAR,    11, "___O___O___O___O",  -0.6f },
+    { ENTITY_TYPE_CAR,    12, "___O___O___O___O",  0.4f },
+    { ENTITY_TYPE_CAR,    13, "__O___O___.O___.O", -0.4f },
+};
+
+// Animations, see AnimationClip
+static const AnimationKey sinkingTurtleKeys[] = {
+    { -1, 1 }, { 0, 1 }, { 1, 0.5f }, { TURTLE_SUNK_FRAME, 1/3.0f }, { 1, 0.5f }, { 0, 1 }, // swim, dive, surface
+};
+static const AnimationClip sinkingTurtleClip = { sinkingTurtleKeys, 6, true };
+
+static const AnimationKey crocHeadKeys[] = { { 1, 1 }, { -1, 1 } }; // mouth closed, open
+static const AnimationClip crocHeadClip = { crocHeadKeys, 2, true };
+
+static const AnimationKey frogDeathKeys[] = { { 0, 1 }, { 1, 1 }, { 2, 1 }, { FROG_DEAD_FRAME, 1 } };
+static const AnimationClip frogDeathClip = { frogDeathKeys, 4, false };
+
 // Initialization
 // ----------------------------------------------------------------------------
 
-void InitGameState(void)
+// Glyphs are baked at the size they cover on the render target, so they're
+// drawn 1:1 instead of scaled up from raylib's default 32px
+static int GetGameFontPixelSize(GameContext *ctx)
+{
+    return (int)roundf(GAME_FONT_SIZE*ctx->game.camera.zoom);
+}
+
+void InitGameState(GameContext *ctx)
+{
+    InitGameStateEx(ctx, (unsigned int)GetRandomValue(1, RAND_MAX - 1));
+}
+
+void InitGameStateEx(GameContext *ctx, unsigned int randomSeed)
 {
-    game = (GameState){ 0 };
-    game.currentScreen = SCREEN_LOGO;
+    GameState *game = &ctx->game;
+    UiState *ui = &ctx->ui;
+    RenderData *viewport = &ctx->viewport;
+
+    AllocScope allocScope = SetAllocScope(ctx, ALLOC_SCOPE_LEVEL); // a new game is a level transition too
+    *game = (GameState){ 0 };
+    game->currentScreen = SCREEN_LOGO;
+    game->randomState = (randomSeed != 0)? randomSeed : 1; // xorshift can't start at 0
 
     // Center camera
-    game.camera.target = (Vector2){ VIRTUAL_WIDTH/2, VIRTUAL_HEIGHT/2 };
-    game.camera.offset = (Vector2){ viewport.renderTexWidth/2, viewport.renderTexHeight/2 };
-    game.camera.zoom = viewport.renderTexHeight/VIRTUAL_HEIGHT;
+    game->camera.target = (Vector2){ VIRTUAL_WIDTH/2, VIRTUAL_HEIGHT/2 };
+    game->camera.offset = (Vector2){ viewport->renderTexWidth/2, viewport->renderTexHeight/2 };
+    game->camera.zoom = viewport->renderTexHeight/VIRTUAL_HEIGHT;
 
-    game.level = 1;
-    game.lives = 4;
-    game.isDebugMode = DEBUG_DEFAULT;
+    game->level = 1;
+    game->lives = 4;
+    game->isDebugMode = DEBUG_DEFAULT;
 
-    game.fly.spawnTimer = (float)GetRandomValue(3, 6);
+    game->fly.spawnTimer = (float)GetGameRandomValue(ctx, 3, 6);
 
     // Set up game grid positions
     Vector2 gridOffset = {
@@ -31,140 +107,90 @@ void InitGameState(void)
         for (int col = 0; col < GRID_RES_X; col++)
         {
             int index = row*GRID_RES_X + col;
-            game.grid[index].x = gridOffset.x + GRID_UNIT*col;
-            game.grid[index].y = gridOffset.y + GRID_UNIT*row;
+            game->grid[index].x = gridOffset.x + GRID_UNIT*col;
+            game->grid[index].y = gridOffset.y + GRID_UNIT*row;
         }
     }
 
-    game.gridStart = GetGridPosition(0, 0);
-
-    // Load external assets
-    game.textures.atlas = LoadTextureAssetEx(&game.assets, "assets/textures/frogger.png", TEXTURE_FILTER_POINT);
-    const float s = SPRITE_SIZE;
-    game.textures.car         = (Rectangle){ s*3,    0,      s,   s      };
-    game.textures.frog        = (Rectangle){ 0,      0,      s,   s      };
-    game.textures.grassPurple = (Rectangle){ s*3,    s*2,    s,   s      };
-    game.textures.grassGreen  = (Rectangle){ s*4,    s*1.5f, s,   s*1.5f };
-    game.textures.dead        = (Rectangle){ s*3,    s*3,    s,   s      };
-    game.textures.dying       = (Rectangle){ 0,      s*3,    s,   s      };
-    game.textures.turtle      = (Rectangle){ 0,      s*5,    s,   s      };
-    game.textures.turtleSink  = (Rectangle){ s*3,    s*5,    s,   s      };
-    game.textures.fly         = (Rectangle){ s*2,    s*6,    s,   s      };
-    game.textures.winFrog     = (Rectangle){ s*3,    s*6,    s,   s      };
-    game.textures.log         = (Rectangle){ s*6,    s*8,    s,   s      };
-    game.textures.life        = (Rectangle){ s*3,    s,      s/2, s/2    };
-    game.textures.level       = (Rectangle){ s*3.5f, s,      s/2, s/2    };
-    game.textures.score       = (Rectangle){ s,      s*6,    s,   s      };
-    game.textures.croc        = (Rectangle){ 0,      s*7,    s,   s      };
-
-    game.sounds.hop        = LoadSoundAsset(&game.assets, "assets/audio/frog_hop.wav",    0.6f);
-    game.sounds.hit        = LoadSoundAsset(&game.assets, "assets/audio/frog_hit.wav",    0.5f);
-    game.sounds.sunk       = LoadSoundAsset(&game.assets, "assets/audio/frog_sunk.wav",   0.6f);
-    game.sounds.win        = LoadSoundAsset(&game.assets, "assets/audio/frog_win.wav",    0.7f);
-    game.sounds.blink      = LoadSoundAsset(&game.assets, "assets/audio/frog_blink.wav",  0.7f);
-    game.sounds.musicIntro = LoadSoundAsset(&game.assets, "assets/audio/music_intro.wav", 0.5f);
-    game.sounds.musicLoop  = LoadMusicAsset(&game.assets, "assets/audio/music_loop.wav",  0.8f);
-
-    game.font = LoadFont("assets/fonts/PressStart2P.ttf");
-
-    UiText defaultFont = {
-        .fontSize = GRID_UNIT*0.5f,
-        .color = WHITE,
-    };
-    UiText score = defaultFont;
-    strcpy(score.text, "SCORE");
-    score.measure = MeasureTextEx(game.font, score.text, score.fontSize, 0);
-    score.position = (Vector2){ game.gridStart.x + GRID_UNIT*2.5f, game.gridStart.y };
-    UiText scoreNum = score;
-    scoreNum.position.y += scoreNum.measure.y;
-    scoreNum.position.x = GetGridPosition(3, 0).x;
-    ui.score = score;
-    ui.scoreNum = scoreNum;
-
-    UiText hiScore = defaultFont;
-    strcpy(hiScore.text, "HI-SCORE");
-    hiScore.measure = MeasureTextEx(game.font, hiScore.text, hiScore.fontSize, 0);
-    hiScore.position = (Vector2){ (VIRTUAL_WIDTH - hiScore.measure.x)/2, game.gridStart.y };
-    UiText hiScoreNum = hiScore;
-    hiScoreNum.position.y += hiScoreNum.measure.y;
-    hiScoreNum.position.x = GetGridPosition(6, 0).x + GRID_UNIT/2;
-    ui.hiScore = hiScore;
-    ui.hiScoreNum = hiScoreNum;
-
-    ui.timedMessage = defaultFont;
-    SetTimedMessage("GAME START", 3.0f, YELLOW);
+    game->gridStart = GetGridPosition(ctx, 0, 0);
+
+    // Load external assets (decoded in the background while the logo plays, see loader.h)
+    QueueGameSound(ctx, &game->assets, &game->sounds.hop,   "assets/audio/frog_hop.wav",   0.6f, 4, AUDIO_PRIORITY_LOW);
+    QueueGameSound(ctx, &game->assets, &game->sounds.hit,   "assets/audio/frog_hit.wav",   0.5f, 2, AUDIO_PRIORITY_HIGH);
+    QueueGameSound(ctx, &game->assets, &game->sounds.sunk,  "assets/audio/frog_sunk.wav",  0.6f, 2, AUDIO_PRIORITY_HIGH);
+    QueueGameSound(ctx, &game->assets, &game->sounds.win,   "assets/audio/frog_win.wav",   0.7f, 2, AUDIO_PRIORITY_HIGH);
+    QueueGameSound(ctx, &game->assets, &game->sounds.blink, "assets/audio/frog_blink.wav", 0.7f, 1, AUDIO_PRIORITY_NORMAL);
+    LoadGameMusic(&game->sounds.music, "assets/audio/music_intro.qoa", 0.5f, "assets/audio/music_loop.qoa", 0.8f);
+
+    QueueFontAsset(ctx, &game->assets, &game->font, GAME_FONT_FILE, GetGameFontPixelSize(ctx), TEXTURE_FILTER_POINT);
+
+    ui->timedMessage = (UiText){ .fontSize = GAME_FONT_SIZE, .color = WHITE };
+    SetTimedMessage(ctx, "GAME START", 3.0f, YELLOW);
+    LayoutUiHud(ctx); // again once the font is loaded
 
     // Frog
     Entity frog = { 0 };
-    frog.sprite = game.textures.frog;
-    frog.textureOffset.x = SPRITE_SIZE*2;
+    frog.sprite = SPRITE_FROG;
+    frog.spriteFrame.x = 2;
     frog.type = ENTITY_TYPE_FROG;
     frog.speed = BASE_SPEED*5.0f;
     frog.radius = GRID_UNIT*0.4f;
     frog.color = GREEN;
-    frog.animate.sprite = game.textures.dying;
-    frog.animate.frames = 3;
-    frog.animate.offset.x = s;
-    frog.animate.offset.y = s;
+    frog.animate.sprite = SPRITE_FROG_DYING; // see KillFrog()
     frog.animate.length = 0.3f;
-    Vector2 frogSpawnPos = GetGridPosition(8, 14);
+    Vector2 frogSpawnPos = GetGridPosition(ctx, 8, 14);
     frog.position = frogSpawnPos;
     frog.position.x += GRID_UNIT/2;
     frog.position.y += GRID_UNIT/2 + GRID_UNIT/16;
-    arrpush(game.entities, frog);
-    game.frog = &arrlast(game.entities);
-    game.spawnPos = frog.position;
-    game.prevFrogYPos = frog.position.y;
+    game->frog = &frog; // copied into the level's entities
+    game->spawnPos = frog.position;
+    game->prevFrogYPos = frog.position.y;
 
-    CreateNextLevel();
+    CreateNextLevel(ctx);
 
     int flyCount = 0;
-    for (int i = 0; i < arrlen(game.entities); i++)
+    for (int i = 0; i < game->entityCount; i++)
     {
-        Entity *e = &game.entities[i];
+        Entity *e = &game->entities[i];
         if (e->type == ENTITY_TYPE_WIN)
         {
-            game.fly.entityIdx[flyCount] = i;
+            game->fly.entityIdx[flyCount] = i;
             flyCount++;
         }
     }
 
     // Background rectangles
-    game.background.water.x = game.gridStart.x;
-    game.background.water.y = game.gridStart.y;
-    game.background.water.width = GRID_WIDTH;
-    game.background.water.height = GRID_UNIT*8;
-
-    game.background.grassMiddle.x = game.gridStart.x;
-    game.background.grassMiddle.y = GetGridPosition(0, 8).y;
-    game.background.grassMiddle.width = GRID_WIDTH;
-    game.background.grassMiddle.height = GRID_UNIT;
-
-    game.background.grassBottom.x = game.gridStart.x;
-    game.background.grassBottom.y = GetGridPosition(0, 14).y;
-    game.background.grassBottom.width = GRID_WIDTH;
-    game.background.grassBottom.height = GRID_UNIT;
-}
-
-void CreateRow(EntityType type, int row, char *pattern, float speed)
-{
-    const float s = SPRITE_SIZE;
-    float carTextureOffsets[5] = {
-        s*2, // truck
-        s*5, // racer 1
-        s*4, // car
-        s,   // tractor
-        0,   // racer 2
-    };
-    float carTextureSizes[5] = { s*2, s, s, s, s };
+    game->background.water.x = game->gridStart.x;
+    game->background.water.y = game->gridStart.y;
+    game->background.water.width = GRID_WIDTH;
+    game->background.water.height = GRID_UNIT*8;
+
+    game->background.grassMiddle.x = game->gridStart.x;
+    game->background.grassMiddle.y = GetGridPosition(ctx, 0, 8).y;
+    game->background.grassMiddle.width = GRID_WIDTH;
+    game->background.grassMiddle.height = GRID_UNIT;
+
+    game->background.grassBottom.x = game->gridStart.x;
+    game->background.grassBottom.y = GetGridPosition(ctx, 0, 14).y;
+    game->background.grassBottom.width = GRID_WIDTH;
+    game->background.grassBottom.height = GRID_UNIT;
+
+    SetAllocScope(ctx, allocScope);
+}
+
+void CreateRow(GameContext *ctx, EntityType type, int row, const char *pattern, float speed)
+{
+    GameState *game = &ctx->game;
+
+    Sprite carSprites[5] = { SPRITE_CAR_TRUCK, SPRITE_CAR_RACER_1, SPRITE_CAR, SPRITE_CAR_TRACTOR, SPRITE_CAR_RACER_2 };
     int spriteIdx = row - 9;
-    Vector2 currentPos = GetGridPosition(0, row);
+    Vector2 currentPos = GetGridPosition(ctx, 0, row);
     float entityWidth = GRID_UNIT;
     bool isLeftWall = false;
     bool isExtending = false;
     char lastLetter = '\0';
 
-    for (char *c = pattern; *c != '\0'; c++)
+    for (const char *c = pattern; *c != '\0'; c++)
     {
         if (*c == '.') currentPos.x += GRID_UNIT/2;
         if (*c == '_') currentPos.x += GRID_UNIT;
@@ -173,7 +199,7 @@ void CreateRow(EntityType type, int row, char *pattern, float speed)
         if (*c != lastLetter) isExtending = false;
         if (isExtending)
         {
-            arrlast(game.entities).rec.width += entityWidth;
+            game->entities[game->entityCount - 1].rec.width += entityWidth;
             currentPos.x += entityWidth;
         }
         if (*c == '_' || *c == '.' || isExtending)
@@ -191,16 +217,14 @@ void CreateRow(EntityType type, int row, char *pattern, float speed)
         isExtending = true;
         if (type == ENTITY_TYPE_TURTLE)
         {
-            e.sprite = game.textures.turtle;
+            e.sprite = SPRITE_TURTLE;
             e.flags = ENTITY_FLAG_MOVE | ENTITY_FLAG_PLATFORM;
             isExtending = false;
             if (*c == 'F' || *c == 'S')
             {
                 e.isSinking = true;
-                e.isAnimated = true;
-                e.animate.sprite = game.textures.turtleSink;
-                e.animate.frames = 3;
-                e.animate.offset.x = SPRITE_SIZE;
+                e.animate.sprite = SPRITE_TURTLE_SINK;
+                e.animate.clip = &sinkingTurtleClip;
                 if (*c == 'F') e.animate.length = 0.5f; // fast sink
                 if (*c == 'S') e.animate.length = 1.0f;  // slow sink
             }
@@ -208,40 +232,35 @@ void CreateRow(EntityType type, int row, char *pattern, float speed)
 
         if (type == ENTITY_TYPE_LOG)
         {
-            e.sprite = game.textures.log;
+            e.sprite = SPRITE_LOG;
             e.flags = ENTITY_FLAG_MOVE | ENTITY_FLAG_PLATFORM;
         }
 
         if (type == ENTITY_TYPE_CROC)
         {
-            e.sprite = game.textures.croc;
-            e.sprite.width = s*2; // tail and body
+            e.sprite = SPRITE_CROC; // tail and body
             e.flags = ENTITY_FLAG_MOVE | ENTITY_FLAG_PLATFORM;
             if (*c == 'X')
             {
-                e.sprite.x += s*2; // croc mouth open
-                e.sprite.width = s;
+                e.sprite = SPRITE_CROC_HEAD; // croc mouth open
                 e.animate.sprite = e.sprite;
-                e.animate.offset.x = s; // croc mouth closed
-                e.animate.frames = 1;
+                e.animate.clip = &crocHeadClip;
                 e.animate.length = 1;
-                e.isAnimated = true;
+                e.flags |= ENTITY_FLAG_KILL; // while the mouth is open, see UpdateHostile()
             }
         }
 
         if (type == ENTITY_TYPE_CAR)
         {
-            e.sprite = game.textures.car;
-            e.sprite.x += carTextureOffsets[spriteIdx];
-            e.sprite.width = carTextureSizes[spriteIdx];
+            e.sprite = carSprites[spriteIdx];
             e.flags = ENTITY_FLAG_MOVE | ENTITY_FLAG_KILL;
         }
 
         if (type == ENTITY_TYPE_WALL)
         {
-            e.sprite = game.textures.grassGreen;
+            e.sprite = SPRITE_GRASS_GREEN;
             if (isLeftWall)
-                e.textureOffset.x = s*2;
+                e.spriteFrame.x = 2;
             isLeftWall = !isLeftWall;
             e.flags = ENTITY_FLAG_KILL;
             e.rec.height += GRID_UNIT/2;
@@ -252,582 +271,642 @@ void CreateRow(EntityType type, int row, char *pattern, float speed)
 
         if (type == ENTITY_TYPE_WIN)
         {
-            e.sprite = game.textures.winFrog;
-            e.animate.offset.x = s;
-            e.animate.timer = 0.75f*(game.winCount + 1);
-            game.winCount++;
+            e.sprite = SPRITE_WIN_FROG;
+            e.animate.timer = 0.75f*(game->winCount + 1);
+            game->winCount++;
         }
 
-        arrpush(game.entities, e);
+        if (game->entityCount >= game->entityCapacity - 1) // room for the frog
+        {
+            TraceLog(LOG_ERROR, "GAME: Row %i has more entities than CountRowEntities() says", row);
+            return;
+        }
+        game->entities[game->entityCount++] = e;
         lastLetter = *c;
     }
 }
 
-void CreateNextLevel(void)
+int CountRowEntities(EntityType type, const char *pattern)
 {
-    StopGameSounds();
+    // Same rules as CreateRow(): a run of letters is one entity, except
+    // turtles and walls which are one per letter
+    bool isSingleTile = (type == ENTITY_TYPE_TURTLE) || (type == ENTITY_TYPE_WALL);
+    bool isExtending = false;
+    char lastLetter = '\0';
+    int count = 0;
 
-    game.winCount = 0;
-    game.isGameOver = false;
-    game.isGameWon = false;
-    game.isFirstFrame = true;
+    for (const char *c = pattern; *c != '\0'; c++)
+    {
+        if (*c != lastLetter) isExtending = false;
+        if (*c == '_' || *c == '.' || isExtending)
+            continue;
 
-    Entity frog = *game.frog;
-    if (game.entities) arrfree(game.entities);
+        count++;
+        isExtending = !isSingleTile;
+        lastLetter = *c;
+    }
 
-    float speed = BASE_SPEED;
-    if (game.level > 1)
+    return count;
+}
+
+const LevelRow *GetLevelRows(int level, int *rowCount)
+{
+    if (level == 1)
     {
-        speed *= game.level*0.7f; // TEMP until more level layouts
-        SetTimedMessage(TextFormat("LEVEL %i", game.level), 3.0f, YELLOW);
+        *rowCount = sizeof(levelOneRows)/sizeof(levelOneRows[0]);
+        return levelOneRows;
     }
 
-    // Win zones
-    int spawnRow = 2;
-    CreateRow(ENTITY_TYPE_WALL,   spawnRow,   ".O_OO_OO_OO_OO_O.", 0);
-    CreateRow(ENTITY_TYPE_WIN,    spawnRow,   "._O__O__O__O__O_.",  0);
-
-    if (game.level == 1)
-    {
-        // River
-        CreateRow(ENTITY_TYPE_LOG,    ++spawnRow, "_OOOO_.OOOO_.OOOO", speed*0.8f);
-        CreateRow(ENTITY_TYPE_TURTLE, ++spawnRow, "___SS_.OO_.OO_.OO", -speed);
-        CreateRow(ENTITY_TYPE_LOG,    ++spawnRow, "__OOOOOO__OOOOOO",  speed*2);
-        CreateRow(ENTITY_TYPE_LOG,    ++spawnRow, "___OOO__OOO__OOO",  speed*0.5f);
-        CreateRow(ENTITY_TYPE_TURTLE, ++spawnRow, "_FFF_OOO_OOO_OOO",  -speed);
-
-        // Road, Cars
-        spawnRow = 9;
-        CreateRow(ENTITY_TYPE_CAR, spawnRow,   "________.OO___.OO", -speed);
-        CreateRow(ENTITY_TYPE_CAR, ++spawnRow, "O_______________",  speed*0.6f);
-        CreateRow(ENTITY_TYPE_CAR, ++spawnRow, "_______O___O___O",  -speed*0.6f);
-        CreateRow(ENTITY_TYPE_CAR, ++spawnRow, "_______O___O___O",  speed*0.4f);
-        CreateRow(ENTITY_TYPE_CAR, ++spawnRow, "______O___.O___.O", -speed*0.4f);
-    }
-    else
-    {
-        // River
-        CreateRow(ENTITY_TYPE_LOG,    ++spawnRow, "______.OOOO_.OOOO", speed*0.8f);
-        CreateRow(ENTITY_TYPE_CROC,     spawnRow, "__OOX_._____.____", speed*0.8f);
-        CreateRow(ENTITY_TYPE_TURTLE, ++spawnRow, "OO_SS_.OO_.OO_.OO", -speed);
-        CreateRow(ENTITY_TYPE_LOG,    ++spawnRow, "__OOOOOO________",  speed*2);
-        CreateRow(ENTITY_TYPE_LOG,    ++spawnRow, "___OOO__OOO__OOO",  speed*0.5f);
-        CreateRow(ENTITY_TYPE_TURTLE, ++spawnRow, "_FFF_____OOO_OOO",  -speed);
+    *rowCount = sizeof(levelTwoRows)/sizeof(levelTwoRows[0]);
+    return levelTwoRows;
+}
+
+int CountLevelEntities(int level)
+{
+    int rowCount;
+    const LevelRow *rows = GetLevelRows(level, &rowCount);
 
-        // Road, Cars
-        spawnRow = 9;
-        CreateRow(ENTITY_TYPE_CAR, spawnRow,   "___OO___.OO___.OO", -speed);
-        CreateRow(ENTITY_TYPE_CAR, ++spawnRow, "O_.O____________",  speed*0.6f);
-        CreateRow(ENTITY_TYPE_CAR, ++spawnRow, "___O___O___O___O",  -speed*0.6f);
-        CreateRow(ENTITY_TYPE_CAR, ++spawnRow, "___O___O___O___O",  speed*0.4f);
-        CreateRow(ENTITY_TYPE_CAR, ++spawnRow, "__O___O___.O___.O", -speed*0.4f);
+    int count = 1; // frog
+    for (int i = 0; i < rowCount; i++)
+        count += CountRowEntities(rows[i].type, rows[i].pattern);
+
+    return count;
+}
+
+void CreateNextLevel(GameContext *ctx)
+{
+    GameState *game = &ctx->game;
+
+    AllocScope allocScope = SetAllocScope(ctx, ALLOC_SCOPE_LEVEL);
+    StopGameSounds(ctx);
+
+    game->winCount = 0;
+    game->isGameOver = false;
+    game->isGameWon = false;
+    game->isFirstFrame = true;
+    game->levelTime = 0;
+
+    // The old level's memory is reused as is, after the first few levels
+    // the arena has room for every layout and this doesn't allocate
+    Entity frog = *game->frog;
+    arena_reset(&game->levelArena);
+    game->entityCapacity = CountLevelEntities(game->level);
+    game->entities = arena_alloc(&game->levelArena, game->entityCapacity*sizeof(Entity));
+    game->entityCount = 0;
+
+    float speed = BASE_SPEED;
+    if (game->level > 1)
+    {
+        speed *= game->level*0.7f; // TEMP until more level layouts
+        char levelText[32]; // not TextFormat(), its buffers are shared between threads
+        snprintf(levelText, sizeof(levelText), "LEVEL %i", game->level);
+        SetTimedMessage(ctx, levelText, 3.0f, YELLOW);
     }
 
-    arrpush(game.entities, frog);
-    game.frog = &arrlast(game.entities);
-    RespawnFrog();
+    int rowCount;
+    const LevelRow *rows = GetLevelRows(game->level, &rowCount);
+    for (int i = 0; i < rowCount; i++)
+        CreateRow(ctx, rows[i].type, rows[i].row, rows[i].pattern, speed*rows[i].speed);
+
+    game->entities[game->entityCount++] = frog;
+    game->frog = &game->entities[game->entityCount - 1];
+    RespawnFrog(ctx);
+    LayoutLaneStrips(ctx);
+    SetAllocScope(ctx, allocScope);
 }
 
-void FreeGameState(void)
+void BakeGameFont(GameContext *ctx)
 {
-    FreeRaylibAssets(&game.assets);
-    arrfree(game.entities);
+    GameState *game = &ctx->game;
+
+    FinishAssetLoads(ctx); // a queued font would land on top of this one
+
+    int pixelSize = GetGameFontPixelSize(ctx);
+    if ((game->font.texture.id != 0) && (game->font.baseSize == pixelSize)) return;
+
+    if (game->font.texture.id != 0) UnloadFontAsset(&game->assets, game->font);
+    game->font = LoadFontAssetEx(&game->assets, GAME_FONT_FILE, pixelSize); // point filtered, it's a pixel font
+}
+
+void FreeGameState(GameContext *ctx)
+{
+    GameState *game = &ctx->game;
+
+    FinishAssetLoads(ctx); // nothing may land in the pool after it's freed
+    SilenceAudioMixer(ctx); // or be played from it
+    FreeRaylibAssets(&game->assets);
+    UnloadGameMusic(&game->sounds.music);
+    UnloadLaneStrips(ctx);
+    arena_free(&game->levelArena);
+    game->entities = NULL;
+    game->entityCount = game->entityCapacity = 0;
 }
 
 // Update
 // ----------------------------------------------------------------------------
 
-void UpdateGameFrame(void)
+void UpdateGameFrame(GameContext *ctx)
 {
-    if (game.isFirstFrame)
-    {
-        game.isFirstFrame = false;
-        PlaySound(game.sounds.musicIntro);
-    }
-    if (!game.isGameOver && !game.isGameWon &&
-        !IsSoundPlaying(game.sounds.musicIntro) &&
-        !IsMusicStreamPlaying(game.sounds.musicLoop))
+    GameState *game = &ctx->game;
+    InputState *input = &ctx->input;
+    UiState *ui = &ctx->ui;
+
+    if (game->isFirstFrame)
     {
-        PlayMusicStream(game.sounds.musicLoop);
+        game->isFirstFrame = false;
+        PlayGameMusic(ctx, &game->sounds.music); // the loop follows the intro by itself
     }
-    UpdateMusicStream(game.sounds.musicLoop);
 
     // Debug:
     if (IsKeyPressed(KEY_K))
-        KillFrog();
+        KillFrog(ctx);
 
     if (IsKeyPressed(KEY_L))
-        game.winCount--;
+        game->winCount--;
 
     // Pause
-    if (input.player.pause || (game.isPaused && input.menu.cancel))
+    if (input->player.pause || (game->isPaused && input->menu.cancel))
     {
-        static float previousTextFade = 0.0f;
-        if (!game.isPaused)
+        if (!game->isPaused)
         {
-            game.isPaused = true;
-            ChangeUiMenu(UI_MENU_PAUSE);
-            previousTextFade = ui.textFade;
-            ui.textFade = 1.0f;
+            game->isPaused = true;
+            ChangeUiMenu(ctx, UI_MENU_PAUSE);
+            ui->textFadeBeforePause = ui->textFade;
+            ui->textFade = 1.0f;
         }
         else
         {
-            game.isPaused = false;
-            ui.currentMenu = UI_MENU_NONE;
-            ui.textFade = previousTextFade;
+            game->isPaused = false;
+            ui->currentMenu = UI_MENU_NONE;
+            ui->textFade = ui->textFadeBeforePause;
         }
-        PlaySound(ui.sounds.menu);
+        PlayGameSound(ctx, &ui->sounds.menu);
     }
 
-    if (!game.isPaused)
+    if (!game->isPaused)
     {
-        // Current level win condition
-        if ((game.winCount == 0) && !game.isGameWon)
-        {
-            StopGameSounds();
+        UpdateGameSimulation(ctx);
 
-            game.isGameWon = true;
-            SetTimedMessage("WINNER", 3.0f, YELLOW);
-            game.waitTimer = 4.5f;
-        }
-        if (game.isGameWon && (game.waitTimer < EPSILON))
-        {
-            game.level++;
-            CreateNextLevel();
-        }
+        UpdateUiHud(ctx);
+    }
+    // Prevent input after resuming pause
+    if (IsMouseButtonUp(MOUSE_LEFT_BUTTON) && game->isInputDisabledFromResume)
+        game->isInputDisabledFromResume = false;
 
-        // Update score
-        if (game.score > game.hiScore)
-            game.hiScore = game.score;
-        strcpy(ui.scoreNum.text, TextFormat("%i", game.score));
-        strcpy(ui.hiScoreNum.text, TextFormat("%i", game.hiScore));
+    // Update user interface elements and logic
+    UpdateUiFrame(ctx);
+}
 
-        // Game over condition
-        if ((game.lives == 0) && !game.isGameOver)
-        {
-            StopGameSounds();
+void UpdateGameSimulation(GameContext *ctx)
+{
+    GameState *game = &ctx->game;
 
-            game.isGameOver = true;
-            SetTimedMessage("GAME OVER", 3.0f, RED);
-            game.waitTimer = 4.5f;
-        }
-        if (game.isGameOver && (game.waitTimer < EPSILON))
-        {
-            game.level = 1;
-            game.score = 0;
-            game.lives = 4;
-            CreateNextLevel();
-            SetTimedMessage("GAME START", 3.0f, YELLOW);
-        }
+    // Current level win condition
+    if ((game->winCount == 0) && !game->isGameWon)
+    {
+        StopGameSounds(ctx);
 
-        // Update entities
-        UpdateFrog();
+        game->isGameWon = true;
+        SetTimedMessage(ctx, "WINNER", 3.0f, YELLOW);
+        game->waitTimer = 4.5f;
+    }
+    if (game->isGameWon && (game->waitTimer < EPSILON))
+    {
+        game->level++;
+        CreateNextLevel(ctx);
+    }
 
-        for (int i = 0; i < arrlen(game.entities); i++)
-        {
-            Entity *e = &game.entities[i];
+    // Update score
+    if (game->score > game->hiScore)
+        game->hiScore = game->score;
 
-            if (e->type == ENTITY_TYPE_WIN)      UpdateWinZone(e, i);
-            if (e->flags & ENTITY_FLAG_KILL)     UpdateHostile(e);
-            if (e->flags & ENTITY_FLAG_PLATFORM) UpdatePlatform(e);
-            if (e->flags & ENTITY_FLAG_MOVE)     MoveEntity(e);
+    // Game over condition
+    if ((game->lives == 0) && !game->isGameOver)
+    {
+        StopGameSounds(ctx);
 
-            if (e->isAnimated)
-            {
-                if (e->type == ENTITY_TYPE_CROC) UpdateAnimationCroc(e);
-                if (e->isSinking)                UpdateAnimationSinkingTurtle(e);
-            }
-        }
+        game->isGameOver = true;
+        SetTimedMessage(ctx, "GAME OVER", 3.0f, RED);
+        game->waitTimer = 4.5f;
+    }
+    if (game->isGameOver && (game->waitTimer < EPSILON))
+    {
+        game->level = 1;
+        game->score = 0;
+        game->lives = 4;
+        CreateNextLevel(ctx);
+        SetTimedMessage(ctx, "GAME START", 3.0f, YELLOW);
+    }
+
+    // Update entities
+    UpdateFrog(ctx);
+
+    for (int i = 0; i < game->entityCount; i++)
+    {
+        Entity *e = &game->entities[i];
 
-        // Update flies
-        if (game.fly.idx == 0)
+        if (e->type == ENTITY_TYPE_WIN)      UpdateWinZone(ctx, e, i);
+        if (e->flags & ENTITY_FLAG_KILL)     UpdateHostile(ctx, e);
+        if (e->flags & ENTITY_FLAG_PLATFORM) UpdatePlatform(ctx, e);
+    }
+
+    // Update flies
+    if (game->fly.idx == 0)
+    {
+        if (game->fly.spawnTimer < EPSILON)
         {
-            if (game.fly.spawnTimer < EPSILON)
-            {
-                game.fly.spawnTimer = (float)GetRandomValue(1, 10);
-                game.fly.despawnTimer = 3;
-                game.fly.idx = GetRandomValue(0, 5);
-            }
-            else
-                game.fly.spawnTimer -= game.frameTime;
+            game->fly.spawnTimer = (float)GetGameRandomValue(ctx, 1, 10);
+            game->fly.despawnTimer = 3;
+            game->fly.idx = GetGameRandomValue(ctx, 0, 5);
         }
         else
+            game->fly.spawnTimer -= game->frameTime;
+    }
+    else
+    {
+        if (game->fly.despawnTimer < EPSILON)
         {
-            if (game.fly.despawnTimer < EPSILON)
-            {
-                game.fly.idx = 0;
-                game.fly.spawnTimer = GetRandomValue(3, 6);
-            }
-            else
-            {
-                game.fly.despawnTimer -= game.frameTime;
-            }
+            game->fly.idx = 0;
+            game->fly.spawnTimer = (float)GetGameRandomValue(ctx, 3, 6);
         }
-
-        // global game wait timer (player cannot move)
-        if (game.waitTimer > 0)
-            game.waitTimer -= game.frameTime;
-
-        // Update global turtle animation
-        if (game.animateTimer > 0)
-            game.animateTimer -= game.frameTime;
         else
         {
-            game.animateTimer = 0.25f;
-            game.animateTextureOffset = fmodf(game.animateTextureOffset + game.textures.turtle.width, SPRITE_SIZE*3);
+            game->fly.despawnTimer -= game->frameTime;
         }
     }
-    // Prevent input after resuming pause
-    if (IsMouseButtonUp(MOUSE_LEFT_BUTTON) && game.isInputDisabledFromResume)
-        game.isInputDisabledFromResume = false;
 
-    // Update user interface elements and logic
-    UpdateUiFrame();
+    // global game wait timer (player cannot move)
+    if (game->waitTimer > 0)
+        game->waitTimer -= game->frameTime;
+
+    game->levelTime += game->frameTime;
 }
 
-void UpdateFrog(void)
+void UpdateFrog(GameContext *ctx)
 {
+    GameState *game = &ctx->game;
+    InputState *input = &ctx->input;
+
     // track to moving platform
-    if (game.frog->isOnPlatform)
+    if (game->frog->isOnPlatform)
     {
-        game.frog->position.x += game.frog->platformMove*game.frameTime;
-        game.frog->seekPos.x += game.frog->platformMove*game.frameTime;
-        game.frog->bufferPos.x += game.frog->platformMove*game.frameTime;
+        game->frog->position.x += game->frog->platformMove*game->frameTime;
+        game->frog->seekPos.x += game->frog->platformMove*game->frameTime;
+        game->frog->bufferPos.x += game->frog->platformMove*game->frameTime;
     }
 
     // wrap around screen edge
-    bool pastLeftEdge = (game.frog->position.x + game.frog->radius < game.gridStart.x);
+    bool pastLeftEdge = (game->frog->position.x + game->frog->radius < game->gridStart.x);
     if (pastLeftEdge)
     {
-        game.frog->position.x += GRID_WIDTH;
-        game.frog->seekPos.x += GRID_WIDTH;
-        game.frog->bufferPos.x += GRID_WIDTH;
-        KillFrog();
+        game->frog->position.x += GRID_WIDTH;
+        game->frog->seekPos.x += GRID_WIDTH;
+        game->frog->bufferPos.x += GRID_WIDTH;
+        if (!game->frog->isDead) KillFrog(ctx); // a dead frog can still drift off on a platform
     }
-    bool pastRightEdge = (game.frog->position.x - game.frog->radius > game.gridStart.x + GRID_WIDTH);
+    bool pastRightEdge = (game->frog->position.x - game->frog->radius > game->gridStart.x + GRID_WIDTH);
     if (pastRightEdge)
     {
-        game.frog->position.x -= GRID_WIDTH;
-        game.frog->seekPos.x -= GRID_WIDTH;
-        game.frog->bufferPos.x -= GRID_WIDTH;
-        KillFrog();
+        game->frog->position.x -= GRID_WIDTH;
+        game->frog->seekPos.x -= GRID_WIDTH;
+        game->frog->bufferPos.x -= GRID_WIDTH;
+        if (!game->frog->isDead) KillFrog(ctx);
     }
 
-    bool onLeftEdge = (game.frog->position.x - game.frog->radius < game.gridStart.x);
-    bool onRightEdge = (game.frog->position.x + game.frog->radius > game.gridStart.x + GRID_WIDTH);
-    game.frog->isWrapping = onLeftEdge || onRightEdge;
-
     // respawn frog
-    if (game.frog->isDead)
+    if (game->frog->isDead)
     {
-        // update death animation
-        if ((game.frog->animate.timer < EPSILON) &&
-            (game.frog->animate.frame <= game.frog->animate.frames))
-        {
-            game.frog->animate.frame++;
-            if (game.frog->animate.frame >= 2)
-                game.frog->animate.timer /= game.frog->animate.frame;
-            game.frog->animate.timer = game.frog->animate.length;
-        }
-        else game.frog->animate.timer -= game.frameTime;
-        game.frog->textureOffset.x = game.frog->animate.offset.x*(game.frog->animate.frame - 1);
+        game->deathTimer -= game->frameTime;
 
-
-        game.deathTimer -= game.frameTime;
-
-        if ((game.deathTimer < 0) && !game.isGameOver)
-            RespawnFrog();
+        if ((game->deathTimer < 0) && !game->isGameOver)
+            RespawnFrog(ctx);
 
         return; // no update
     }
 
     // drowned in river (lethal rapids, I guess?)
-    if (!game.frog->isOnPlatform &&
-        CheckCollisionPointRec(game.frog->position, game.background.water))
+    if (!game->frog->isOnPlatform &&
+        CheckCollisionPointRec(game->frog->position, game->background.water))
     {
-        game.frog->isDrowned = true;
-        KillFrog();
-        game.frog->textureOffset.y = 0; // set to drown death animation
+        game->frog->isDrowned = true;
+        KillFrog(ctx);
+        game->frog->spriteFrame.y = 0; // set to drown death animation
         return;
     }
-    game.frog->isOnPlatform = false;
+    game->frog->isOnPlatform = false;
 
     // frog reached next seek position
-    if (game.frog->isMoving && Vector2Equals(game.frog->position, game.frog->seekPos))
+    if (game->frog->isMoving && Vector2Equals(game->frog->position, game->frog->seekPos))
     {
         // +10 points for moving forward
-        if (game.frog->position.y < game.prevFrogYPos)
+        if (game->frog->position.y < game->prevFrogYPos)
         {
-            game.prevFrogYPos = game.frog->position.y;
-            game.rowsTravelled++;
-            game.score += 10;
+            game->prevFrogYPos = game->frog->position.y;
+            game->rowsTravelled++;
+            game->score += 10;
         }
 
         // move to possible buffered position
-        if (game.frog->isMoveBuffered)
+        if (game->frog->isMoveBuffered)
         {
-            game.frog->seekPos = game.frog->bufferPos;
-            game.frog->isMoveBuffered = false;
-            PlaySound(game.sounds.hop);
+            game->frog->seekPos = game->frog->bufferPos;
+            game->frog->isMoveBuffered = false;
+            PlayGameSound(ctx, &game->sounds.hop);
+            TrackInputMoveLatency(ctx, input->bufferedMoveEventTime);
+            input->bufferedMoveEventTime = 0;
         }
-        else game.frog->isMoving = false;
+        else game->frog->isMoving = false;
     }
 
-    if (game.lives == 0) return;
+    if (game->lives == 0) return;
 
     // set movement vector
-    bool moveInput = (input.player.moveUp   || input.player.moveDown ||
-                      input.player.moveLeft || input.player.moveRight);
+    bool moveInput = (input->player.moveUp   || input->player.moveDown ||
+                      input->player.moveLeft || input->player.moveRight);
 
-    if (moveInput && (game.waitTimer < EPSILON))
+    if (moveInput && (game->waitTimer < EPSILON))
     {
         Vector2 moveVector = Vector2Zero();
 
-        if      (input.player.moveUp)    moveVector.y -= GRID_UNIT;
-        else if (input.player.moveDown)  moveVector.y += GRID_UNIT;
-        else if (input.player.moveLeft)  moveVector.x -= GRID_UNIT;
-        else if (input.player.moveRight) moveVector.x += GRID_UNIT;
+        if      (input->player.moveUp)    moveVector.y -= GRID_UNIT;
+        else if (input->player.moveDown)  moveVector.y += GRID_UNIT;
+        else if (input->player.moveLeft)  moveVector.x -= GRID_UNIT;
+        else if (input->player.moveRight) moveVector.x += GRID_UNIT;
 
-        Vector2 newSeekPos = Vector2Add(game.frog->position, moveVector);
+        Vector2 newSeekPos = Vector2Add(game->frog->position, moveVector);
 
         // no moving past screen edge
-        pastLeftEdge        = (newSeekPos.x + game.frog->radius < game.gridStart.x + GRID_UNIT);
-        pastRightEdge       = (newSeekPos.x - game.frog->radius > game.gridStart.x + GRID_WIDTH - GRID_UNIT);
-        bool pastBottomEdge = (newSeekPos.y - game.frog->radius > game.gridStart.y + GRID_HEIGHT - GRID_UNIT);
+        pastLeftEdge        = (newSeekPos.x + game->frog->radius < game->gridStart.x + GRID_UNIT);
+        pastRightEdge       = (newSeekPos.x - game->frog->radius > game->gridStart.x + GRID_WIDTH - GRID_UNIT);
+        bool pastBottomEdge = (newSeekPos.y - game->frog->radius > game->gridStart.y + GRID_HEIGHT - GRID_UNIT);
         if (pastLeftEdge || pastRightEdge || pastBottomEdge) return;
 
-        Vector2 newBufferPos = Vector2Add(game.frog->seekPos, moveVector);
+        Vector2 newBufferPos = Vector2Add(game->frog->seekPos, moveVector);
 
         // set new seek position
-        if (!game.frog->isMoving)
+        if (!game->frog->isMoving)
         {
-            game.frog->isMoving = true;
-            game.frog->seekPos = newSeekPos;
-            PlaySound(game.sounds.hop);
+            game->frog->isMoving = true;
+            game->frog->seekPos = newSeekPos;
+            PlayGameSound(ctx, &game->sounds.hop);
+            TrackInputMoveLatency(ctx, input->moveEventTime);
         }
 
         // set buffered position
-        else if (!game.frog->isMoveBuffered && !Vector2Equals(game.frog->bufferPos, newBufferPos))
+        else if (!game->frog->isMoveBuffered && !Vector2Equals(game->frog->bufferPos, newBufferPos))
         {
-            pastLeftEdge   = (newBufferPos.x + game.frog->radius < game.gridStart.x + GRID_UNIT);
-            pastRightEdge  = (newBufferPos.x - game.frog->radius > game.gridStart.x + GRID_WIDTH - GRID_UNIT);
-            pastBottomEdge = (newBufferPos.y - game.frog->radius > game.gridStart.y + GRID_HEIGHT - GRID_UNIT);
+            pastLeftEdge   = (newBufferPos.x + game->frog->radius < game->gridStart.x + GRID_UNIT);
+            pastRightEdge  = (newBufferPos.x - game->frog->radius > game->gridStart.x + GRID_WIDTH - GRID_UNIT);
+            pastBottomEdge = (newBufferPos.y - game->frog->radius > game->gridStart.y + GRID_HEIGHT - GRID_UNIT);
             if (pastLeftEdge || pastRightEdge || pastBottomEdge) return;
 
-            game.frog->bufferPos = newBufferPos;
-            game.frog->isMoveBuffered = true;
+            game->frog->bufferPos = newBufferPos;
+            game->frog->isMoveBuffered = true;
+            input->bufferedMoveEventTime = input->moveEventTime;
         }
     }
 
     // move towards next position
-    if (game.frog->isMoving)
+    if (game->frog->isMoving)
     {
-        Vector2 newPos = Vector2MoveTowards(game.frog->position, game.frog->seekPos, game.frog->speed*game.frameTime);
-        Vector2 moveDelta = Vector2Subtract(game.frog->position, newPos);
-        game.frog->position = newPos;
+        Vector2 newPos = Vector2MoveTowards(game->frog->position, game->frog->seekPos, game->frog->speed*game->frameTime);
+        Vector2 moveDelta = Vector2Subtract(game->frog->position, newPos);
+        game->frog->position = newPos;
 
         // set sprite
-        float distFromDest = Vector2Length(Vector2Subtract(game.frog->position, game.frog->seekPos));
+        float distFromDest = Vector2Length(Vector2Subtract(game->frog->position, game->frog->seekPos));
         if (distFromDest < GRID_UNIT*0.2f)
-            game.frog->textureOffset.x = SPRITE_SIZE*2; // not hopping
+            game->frog->spriteFrame.x = 2; // not hopping
         else
-            game.frog->textureOffset.x = 0; // hopping
+            game->frog->spriteFrame.x = 0; // hopping
 
-        if (moveDelta.x > 0) game.frog->angle = 270;
-        if (moveDelta.x < 0) game.frog->angle = 90;
-        if (moveDelta.y > 0) game.frog->angle = 0;
-        if (moveDelta.y < 0) game.frog->angle = 180;
+        if (moveDelta.x > 0) game->frog->angle = 270;
+        if (moveDelta.x < 0) game->frog->angle = 90;
+        if (moveDelta.y > 0) game->frog->angle = 0;
+        if (moveDelta.y < 0) game->frog->angle = 180;
     }
-    else game.frog->textureOffset.x = SPRITE_SIZE*2;
+    else game->frog->spriteFrame.x = 2;
 }
 
-void UpdateAnimationSinkingTurtle(Entity *e)
+int GetEntityAnimationFrame(GameContext *ctx, const Entity *e)
 {
-    if (e->animate.timer < EPSILON)
-    {
-        e->animate.frame += e->animate.frameIterate;
-        e->animate.timer = e->animate.length;
-        if (e->animate.frame >= 2)
-            e->animate.timer /= e->animate.frame;
+    const AnimationClip *clip = e->animate.clip;
 
-        if (e->animate.frame == e->animate.frames)
-            e->animate.frameIterate = -1;
-        else if (e->animate.frame == 0)
-            e->animate.frameIterate = 1;
+    if (clip == NULL) return -1;
 
+    float time = (float)(ctx->game.levelTime - e->animate.start);
+    if (clip->isLooping)
+    {
+        float period = 0;
+        for (int i = 0; i < clip->keyCount; i++) period += clip->keys[i].duration;
+        time = fmodf(time, period*e->animate.length);
     }
-    else
-        e->animate.timer -= game.frameTime;
 
-    e->textureOffset.x = (float)((e->animate.frame - 1)*e->animate.offset.x);
+    for (int i = 0; i < clip->keyCount; i++)
+    {
+        time -= clip->keys[i].duration*e->animate.length;
+        if (time < 0) return clip->keys[i].frame;
+    }
+    return clip->keys[clip->keyCount - 1].frame;
 }
 
-void UpdateAnimationCroc(Entity *e)
+int GetTurtlePaddleFrame(GameContext *ctx)
 {
-    if (e->animate.timer < EPSILON)
-    {
-        if (e->animate.frame == e->animate.frames)
-            e->animate.frame = 0;
-        else
-            e->animate.frame++;
-        e->animate.timer = e->animate.length;
-    }
-    else
-        e->animate.timer -= game.frameTime;
+    return (int)(ctx->game.levelTime/TURTLE_PADDLE_LENGTH) % TURTLE_PADDLE_FRAMES;
+}
 
-    e->textureOffset.x = (float)(e->animate.frame*e->animate.offset.x);
-    if (e->animate.frame)
-        e->flags &= ~ENTITY_FLAG_KILL; // mouth closed
-    else
-        e->flags |= ENTITY_FLAG_KILL; // mouth open
+// Whether the frog reaches into the entity's row, checked before working out
+// where a moving entity is, so the lanes away from the frog cost next to nothing
+static bool IsFrogInRow(GameContext *ctx, Rectangle rec, float radius)
+{
+    float frogY = ctx->game.frog->position.y;
+    return (frogY + radius >= rec.y) && (frogY - radius <= rec.y + rec.height);
 }
 
-void UpdateHostile(Entity *hostile)
+void UpdateHostile(GameContext *ctx, Entity *hostile)
 {
-    if (!game.frog->isDead &&
-        CheckCollisionCircleRec(game.frog->position, game.frog->radius*0.75f, hostile->rec))
+    GameState *game = &ctx->game;
+    float radius = game->frog->radius*0.75f;
+
+    // crocs only bite with their mouth open
+    if ((hostile->type == ENTITY_TYPE_CROC) && (GetEntityAnimationFrame(ctx, hostile) >= 0)) return;
+
+    if (game->frog->isDead || !IsFrogInRow(ctx, hostile->rec, radius)) return;
+
+    Rectangle recs[2];
+    int recCount = GetEntityRecs(ctx, hostile, recs);
+    for (int i = 0; i < recCount; i++)
     {
-        KillFrog();
-        PlaySound(game.sounds.hit);
+        if (CheckCollisionCircleRec(game->frog->position, radius, recs[i]))
+        {
+            KillFrog(ctx);
+            PlayGameSound(ctx, &game->sounds.hit);
+            return;
+        }
     }
 }
 
-void UpdatePlatform(Entity *platform)
+void UpdatePlatform(GameContext *ctx, Entity *platform)
 {
+    GameState *game = &ctx->game;
+
+    if (!IsFrogInRow(ctx, platform->rec, 0)) return;
+
     bool colliding = false;
-    if (platform->isWrapping)
-    {
-        Rectangle platformWrapLeft = platform->rec;
-        platformWrapLeft.x += GRID_WIDTH;
-        Rectangle platformWrapRight = platform->rec;
-        platformWrapRight.x -= GRID_WIDTH;
-        colliding = (CheckCollisionPointRec(game.frog->position, platformWrapLeft) ||
-                     CheckCollisionPointRec(game.frog->position, platformWrapRight));
-    }
+    Rectangle recs[2];
+    int recCount = GetEntityRecs(ctx, platform, recs);
+    for (int i = 0; i < recCount; i++)
+        colliding |= CheckCollisionPointRec(game->frog->position, recs[i]);
 
-    if (!game.frog->isOnPlatform && !game.frog->isDrowned &&
-        (colliding |= CheckCollisionPointRec(game.frog->position, platform->rec)))
+    if (!game->frog->isOnPlatform && !game->frog->isDrowned && colliding)
     {
-        game.frog->isOnPlatform = true;
-        if (platform->animate.frame == 3)
-            game.frog->isOnPlatform = false; // for sinking turtles
+        game->frog->isOnPlatform = true;
+        if (GetEntityAnimationFrame(ctx, platform) == TURTLE_SUNK_FRAME)
+            game->frog->isOnPlatform = false; // for sinking turtles
     }
 
-    if (colliding && game.frog->isOnPlatform)
+    if (colliding && game->frog->isOnPlatform)
     {
-        game.frog->platformMove = platform->speed;
+        game->frog->platformMove = platform->speed;
     }
 }
 
-void UpdateWinZone(Entity *zone, int entityIndex)
+void UpdateWinZone(GameContext *ctx, Entity *zone, int entityIndex)
 {
-    if (!zone->isWin && CheckCollisionPointRec(game.frog->position, zone->rec))
+    GameState *game = &ctx->game;
+
+    if (!zone->isWin && CheckCollisionPointRec(game->frog->position, zone->rec))
     {
-        game.score += 50; // win score
-        if ((game.fly.idx > 0) && (game.fly.entityIdx[game.fly.idx - 1] == entityIndex))
+        game->score += 50; // win score
+        if ((game->fly.idx > 0) && (game->fly.entityIdx[game->fly.idx - 1] == entityIndex))
         {
-            game.score += 200; // fly score
+            game->score += 200; // fly score
             zone->scoreTimer = 3.0f;
         }
         zone->isWin = true;
         zone->flags |= ENTITY_FLAG_KILL;
-        game.winCount--;
-        PlaySound(game.sounds.win);
-        RespawnFrog();
+        game->winCount--;
+        PlayGameSound(ctx, &game->sounds.win);
+        RespawnFrog(ctx);
     }
 
     if (zone->scoreTimer > EPSILON)
-        zone->scoreTimer -= game.frameTime;
+        zone->scoreTimer -= game->frameTime;
 
-    if (game.isGameWon)
+    if (game->isGameWon)
     {
         if (!zone->isDead && zone->animate.timer < EPSILON)
         {
             zone->isDead = true;
-            zone->textureOffset.x = zone->animate.offset.x;
-            PlaySound(game.sounds.blink);
+            zone->spriteFrame.x = 1; // empty
+            PlayGameSound(ctx, &game->sounds.blink);
         }
-        else zone->animate.timer -= game.frameTime;
+        else zone->animate.timer -= game->frameTime;
     }
 }
 
-void MoveEntity(Entity *e)
+float GetLanePhase(GameContext *ctx, float speed)
 {
-    // wrap rectangle entities
-    if (e->rec.width > 0)
-    {
-        bool pastLeftEdge = (e->rec.x + e->rec.width < game.gridStart.x);
-        if (pastLeftEdge) e->rec.x += GRID_WIDTH;
-        bool pastRightEdge = (e->rec.x > game.gridStart.x + GRID_WIDTH);
-        if (pastRightEdge) e->rec.x -= GRID_WIDTH;
+    double distance = speed*ctx->game.levelTime;
+    return (float)(distance - GRID_WIDTH*floor(distance/GRID_WIDTH));
+}
 
-        bool onLeftEdge = (e->rec.x < game.gridStart.x);
-        bool onRightEdge = (e->rec.x + e->rec.width > game.gridStart.x + GRID_WIDTH);
-        e->isWrapping = onLeftEdge || onRightEdge;
-    }
+Rectangle GetEntityRec(GameContext *ctx, const Entity *e)
+{
+    GameState *game = &ctx->game;
+
+    Rectangle rec = e->rec;
+    if (!(e->flags & ENTITY_FLAG_MOVE)) return rec;
+
+    // Every entity in a lane moves together and wraps at the grid width, so
+    // nothing is stepped per frame, the spawn is moved by the lane's phase
+    float x = e->rec.x - game->gridStart.x + GetLanePhase(ctx, e->speed);
+    if (x >= GRID_WIDTH) x -= GRID_WIDTH; // spawns are in the grid, phases under GRID_WIDTH
+    rec.x = game->gridStart.x + x;
+    return rec;
+}
 
-    e->rec.x += e->speed*game.frameTime;
+int GetEntityRecs(GameContext *ctx, const Entity *e, Rectangle recs[2])
+{
+    recs[0] = GetEntityRec(ctx, e);
+    if (!(e->flags & ENTITY_FLAG_MOVE)) return 1;
+
+    float offsets[2];
+    int recCount = GetGridWrapOffsets(ctx, recs[0].x, recs[0].width, offsets);
+    Rectangle rec = recs[0];
+    for (int i = 0; i < recCount; i++)
+    {
+        recs[i] = rec;
+        recs[i].x += offsets[i];
+    }
+    return recCount;
 }
 
 // Draw
 // ----------------------------------------------------------------------------
 
-void DrawGameFrame(void)
+void DrawGameFrame(GameContext *ctx)
 {
+    GameState *game = &ctx->game;
+    UiState *ui = &ctx->ui;
+
     ClearBackground(BLACK);
 
     // Draw background elements
-    DrawRectangleRec(game.background.water, WATER_COLOR);
-    DrawGrass(game.background.grassMiddle);
-    DrawGrass(game.background.grassBottom);
+    DrawRectangleRec(game->background.water, WATER_COLOR);
+    DrawGrass(ctx, game->background.grassMiddle);
+    DrawGrass(ctx, game->background.grassBottom);
 
-    const float s = SPRITE_SIZE;
+    Texture *atlas = &ui->textures.atlas;
+
+    // Moving lanes, one quad each, see lanes.h
+    bool isLaneDrawn = DrawLaneStrips(ctx);
 
     // Draw entities
-    for (int i = 0; i < arrlen(game.entities); i++)
+    for (int i = 0; i < game->entityCount; i++)
     {
-        Entity *e = &game.entities[i];
+        Entity *e = &game->entities[i];
+        if (isLaneDrawn && (e->laneIdx >= 0)) continue;
+
+        int animationFrame = GetEntityAnimationFrame(ctx, e);
+        Vector2 frame = e->spriteFrame;
         Rectangle sprite;
 
-        if (e->isAnimated && e->animate.frame > 0)
-            sprite = e->animate.sprite;
+        if (animationFrame >= 0)
+        {
+            frame.x = (float)animationFrame;
+            sprite = GetSpriteFrame(e->animate.sprite, frame);
+        }
         else
-            sprite = e->sprite;
-        sprite.x += e->textureOffset.x;
-        sprite.y += e->textureOffset.y;
-
-        // Global turtle animation
-        if (e->type == ENTITY_TYPE_TURTLE)
         {
-            if (e->animate.frame == 0)
-            {
-                sprite.x = e->sprite.x + game.animateTextureOffset;
-            }
+            // Global turtle animation
+            if (e->type == ENTITY_TYPE_TURTLE)
+                frame.x = (float)GetTurtlePaddleFrame(ctx);
+            sprite = GetSpriteFrame(e->sprite, frame);
         }
 
         // Grass on top of screen
         if (e->type == ENTITY_TYPE_WALL)
         {
-            DrawSpriteOnRectangle(&game.textures.atlas, sprite, e->rec, e->angle);
+            DrawSpriteOnRectangle(atlas, sprite, e->rec, e->angle);
         }
 
         // Win zones (and grass above win zone)
         if (e->type == ENTITY_TYPE_WIN)
         {
-            Rectangle topGrass = game.textures.grassGreen;
-            topGrass.x += s;
-            topGrass.height -= s/2;
+            Rectangle topGrass = GetSpriteFrame(SPRITE_GRASS_GREEN, (Vector2){ 1, 0 });
+            topGrass.height -= SPRITE_SIZE/2;
             Rectangle grassRec = e->rec;
             grassRec.y -= GRID_UNIT/2;
-            DrawSpriteOnRectangle(&game.textures.atlas, topGrass, grassRec, 0);
+            DrawSpriteOnRectangle(atlas, topGrass, grassRec, 0);
 
             if (e->isWin)
-                DrawSpriteOnRectangle(&game.textures.atlas, sprite, e->rec, 0);
-            else if ((game.fly.idx > 0) && (game.fly.entityIdx[game.fly.idx - 1] == i)) // is active fly tile
-                DrawSpriteOnRectangle(&game.textures.atlas, game.textures.fly, e->rec, 0);
+                DrawSpriteOnRectangle(atlas, sprite, e->rec, 0);
+            else if ((game->fly.idx > 0) && (game->fly.entityIdx[game->fly.idx - 1] == i)) // is active fly tile
+                DrawSpriteOnRectangle(atlas, SPRITE_FLY.rec, e->rec, 0);
 
             if (e->scoreTimer > EPSILON)
-                DrawSpriteOnRectangle(&game.textures.atlas, game.textures.score, e->rec, 0);
+                DrawSpriteOnRectangle(atlas, SPRITE_SCORE.rec, e->rec, 0);
         }
 
         // Wrapping entities
@@ -835,54 +914,41 @@ void DrawGameFrame(void)
             e->type == ENTITY_TYPE_TURTLE ||
             e->type == ENTITY_TYPE_CROC)
         {
-            DrawWrappingEntity(&game.textures.atlas, sprite, e->rec, e->angle, e->isWrapping);
+            DrawWrappingEntity(ctx, atlas, sprite, GetEntityRec(ctx, e), e->angle);
         }
 
         // Logs
         if (e->type == ENTITY_TYPE_LOG)
         {
             int logWidth = (int)(e->rec.width/GRID_UNIT);
-            Rectangle logRec = e->rec;
+            Rectangle logRec = GetEntityRec(ctx, e);
             logRec.width = GRID_UNIT;
 
             for (int j = 0; j < logWidth; j++)
             {
-                if (j > 0)
-                    sprite.x = e->sprite.x + s; // log middle
-                if (j == logWidth - 1)
-                    sprite.x = e->sprite.x + s*2; // log end
-                DrawWrappingEntity(&game.textures.atlas, sprite, logRec, e->angle, e->isWrapping);
+                DrawWrappingEntity(ctx, atlas, GetLogTileSprite(e, j), logRec, e->angle);
                 logRec.x += GRID_UNIT;
             }
         }
 
         // Frog
-        if ((e->type == ENTITY_TYPE_FROG) && !game.isGameWon)
+        if ((e->type == ENTITY_TYPE_FROG) && !game->isGameWon)
         {
             float angle;
             if (e->isDead)
             {
-                if (e->animate.frame > e->animate.frames)
-                    sprite = game.textures.dead;
-                else
-                {
-                    sprite = e->animate.sprite;
-                    sprite.x += e->textureOffset.x;
-                    sprite.y += e->textureOffset.y;
-                }
+                if (animationFrame == FROG_DEAD_FRAME)
+                    sprite = SPRITE_FROG_DEAD.rec;
                 angle = 0;
             }
             else angle = e->angle;
 
-            Vector2 frogPos = e->position;
-            DrawSpriteOnCircle(&game.textures.atlas, sprite, frogPos, GRID_UNIT/2, angle);
-
-            if (e->isWrapping)
+            float offsets[2];
+            int copyCount = GetGridWrapOffsets(ctx, e->position.x - GRID_UNIT/2, GRID_UNIT, offsets);
+            for (int j = 0; j < copyCount; j++)
             {
-                Vector2 wrapLeftPos = { frogPos.x + GRID_WIDTH, frogPos.y };
-                Vector2 wrapRightPos = { frogPos.x - GRID_WIDTH, frogPos.y };
-                DrawSpriteOnCircle(&game.textures.atlas, sprite, wrapLeftPos, GRID_UNIT/2, angle);
-                DrawSpriteOnCircle(&game.textures.atlas, sprite, wrapRightPos, GRID_UNIT/2, angle);
+                Vector2 frogPos = { e->position.x + offsets[j], e->position.y };
+                DrawSpriteOnCircle(atlas, sprite, frogPos, GRID_UNIT/2, angle);
             }
         }
     }
@@ -891,119 +957,144 @@ void DrawGameFrame(void)
     DrawRectangleV((Vector2){ 0, 0 },
                    (Vector2){ VIRTUAL_WIDTH - GRID_WIDTH + GRID_UNIT/2, VIRTUAL_HEIGHT },
                    BG_COLOR);
-    DrawRectangleV((Vector2){ game.gridStart.x + GRID_WIDTH - GRID_UNIT, 0 },
+    DrawRectangleV((Vector2){ game->gridStart.x + GRID_WIDTH - GRID_UNIT, 0 },
                    (Vector2){ VIRTUAL_WIDTH - GRID_WIDTH + GRID_UNIT, VIRTUAL_HEIGHT },
                    BG_COLOR);
-    DrawRectangleV((Vector2){ game.gridStart.x, 0 },
-                   (Vector2){ GRID_WIDTH, (VIRTUAL_HEIGHT + GRID_UNIT - (game.gridStart.y + GRID_HEIGHT)) },
+    DrawRectangleV((Vector2){ game->gridStart.x, 0 },
+                   (Vector2){ GRID_WIDTH, (VIRTUAL_HEIGHT + GRID_UNIT - (game->gridStart.y + GRID_HEIGHT)) },
                    BG_COLOR);
-    DrawRectangleV((Vector2){ game.gridStart.x, (game.gridStart.y + GRID_HEIGHT - GRID_UNIT) },
-                   (Vector2){ GRID_WIDTH, (VIRTUAL_HEIGHT + GRID_UNIT - (game.gridStart.y + GRID_HEIGHT)) },
+    DrawRectangleV((Vector2){ game->gridStart.x, (game->gridStart.y + GRID_HEIGHT - GRID_UNIT) },
+                   (Vector2){ GRID_WIDTH, (VIRTUAL_HEIGHT + GRID_UNIT - (game->gridStart.y + GRID_HEIGHT)) },
                    BG_COLOR);
     // Rectangle outerBorder = {
-    //     game.gridStart.x - GRID_UNIT/2, game.gridStart.y - GRID_UNIT/2,
+    //     game->gridStart.x - GRID_UNIT/2, game->gridStart.y - GRID_UNIT/2,
     //     GRID_WIDTH + GRID_UNIT, GRID_WIDTH + GRID_UNIT,
     // };
     // DrawRectangleLinesEx(outerBorder, GRID_UNIT/2, BG_COLOR);
 
-    if (ui.messageTimer > 0)
+    if (ui->messageTimer > 0)
     {
-        DrawRectangleV(ui.timedMessage.position, ui.timedMessage.measure, BLACK);
-        DrawUiText(game.font, ui.timedMessage);
+        DrawRectangleV(ui->timedMessage.position, ui->timedMessage.measure, BLACK);
+        DrawUiText(game->font, &ui->timedMessage);
     }
 
-    // Draw HUD
-    DrawUiText(game.font, ui.score);
-    DrawUiText(game.font, ui.scoreNum);
-    DrawUiText(game.font, ui.hiScore);
-    DrawUiText(game.font, ui.hiScoreNum);
+    // HUD is drawn with the menus, see DrawUiFrame()
+}
 
-    Vector2 lifePos = game.gridStart;
-    lifePos.x += GRID_UNIT;
-    lifePos.y += GRID_HEIGHT - GRID_UNIT;
-    Rectangle lifeRec = { lifePos.x, lifePos.y, GRID_UNIT/2, GRID_UNIT/2 };
-    for (int i = 0; i < game.lives; i++)
-    {
-        DrawSpriteOnRectangle(&game.textures.atlas, game.textures.life, lifeRec, 0);
-        lifeRec.x += GRID_UNIT/2;
-    }
+void DrawWrappingEntity(GameContext *ctx, Texture2D *atlas, Rectangle sprite, Rectangle rec, float angle)
+{
+    float offsets[2];
+    int copyCount = GetGridWrapOffsets(ctx, rec.x, rec.width, offsets);
 
-    Vector2 levelPos = game.gridStart;
-    levelPos.x += GRID_WIDTH - GRID_UNIT*2;
-    levelPos.y += GRID_HEIGHT - GRID_UNIT;
-    Rectangle levelRec = { levelPos.x, levelPos.y, GRID_UNIT/2, GRID_UNIT/2 };
-    for (int i = 0; i < game.level; i++)
+    for (int i = 0; i < copyCount; i++)
     {
-        DrawSpriteOnRectangle(&game.textures.atlas, game.textures.level, levelRec, 0);
-        levelRec.x -= GRID_UNIT/2;
+        Rectangle copyRec = rec;
+        copyRec.x += offsets[i];
+        DrawSpriteOnRectangle(atlas, sprite, copyRec, angle);
     }
 }
 
-void DrawWrappingEntity(Texture2D *atlas, Rectangle sprite, Rectangle rec, float angle, bool isWrapping)
+int GetGridWrapOffsets(GameContext *ctx, float x, float width, float offsets[2])
 {
-    DrawSpriteOnRectangle(atlas, sprite, rec, angle);
+    float left = ctx->game.gridStart.x;
+    float right = left + GRID_WIDTH;
+
+    // The copy that's (at least partly) inside the grid
+    float offset = 0;
+    if (x + width <= left) offset = GRID_WIDTH;
+    else if (x >= right) offset = -GRID_WIDTH;
+    offsets[0] = offset;
+    x += offset;
+
+    // Crossing an edge, the part past it shows on the other side. Anything
+    // else outside the grid is under the border, so it isn't drawn at all.
+    if (x < left) offsets[1] = offset + GRID_WIDTH;
+    else if (x + width > right) offsets[1] = offset - GRID_WIDTH;
+    else return 1;
+
+    return 2;
+}
 
-    if (isWrapping)
-    {
-        Rectangle wrapLeft = rec;
-        wrapLeft.x += GRID_WIDTH;
-        Rectangle wrapRight = rec;
-        wrapRight.x -= GRID_WIDTH;
+Rectangle GetLogTileSprite(const Entity *log, int tile)
+{
+    int logWidth = (int)(log->rec.width/GRID_UNIT);
 
-        DrawSpriteOnRectangle(atlas, sprite, wrapLeft, angle);
-        DrawSpriteOnRectangle(atlas, sprite, wrapRight, angle);
-    }
+    if (tile == logWidth - 1) return GetSpriteFrame(log->sprite, (Vector2){ 2, 0 }); // log end
+    if (tile > 0) return GetSpriteFrame(log->sprite, (Vector2){ 1, 0 }); // log middle
+    return GetSpriteFrame(log->sprite, (Vector2){ 0, 0 });
 }
 
-void DrawGrass(Rectangle grassRec)
+void DrawGrass(GameContext *ctx, Rectangle grassRec)
 {
+    UiState *ui = &ctx->ui;
+
     int tileAmount = (int)(grassRec.width/GRID_UNIT);
     grassRec.width = GRID_UNIT + 0.1f;
 
     for (int i = 0; i < tileAmount; i++)
     {
-        DrawSpriteOnRectangle(&game.textures.atlas, game.textures.grassPurple, grassRec, 0);
+        DrawSpriteOnRectangle(&ui->textures.atlas, SPRITE_GRASS_PURPLE.rec, grassRec, 0);
         grassRec.x += GRID_UNIT;
     }
 }
 
-Vector2 GetGridPosition(int col, int row)
+int GetGameRandomValue(GameContext *ctx, int min, int max)
 {
+    GameState *game = &ctx->game;
+
+    // xorshift32, so every game instance can be replayed from its seed
+    unsigned int x = game->randomState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    game->randomState = x;
+    return min + (int)(x % (unsigned int)(max - min + 1));
+}
+
+Vector2 GetGridPosition(GameContext *ctx, int col, int row)
+{
+    GameState *game = &ctx->game;
+
     int index = row*GRID_RES_X + col;
-    return (Vector2){ game.grid[index].x, game.grid[index].y };
+    return (Vector2){ game->grid[index].x, game->grid[index].y };
 }
 
-void KillFrog(void)
+void KillFrog(GameContext *ctx)
 {
-    game.frog->isDead = true;
-    game.frog->animate.frame = 0;
-    game.deathTimer = 1.5f;
-    game.frog->textureOffset.x = 0;
-    game.frog->textureOffset.y = game.frog->animate.offset.y; // default land death animation
-    game.lives--;
-    if (game.frog->isDrowned)
-        PlaySound(game.sounds.sunk);
+    GameState *game = &ctx->game;
+
+    game->frog->isDead = true;
+    game->frog->animate.clip = &frogDeathClip;
+    game->frog->animate.start = (float)game->levelTime;
+    game->deathTimer = 1.5f;
+    game->frog->spriteFrame.x = 0;
+    game->frog->spriteFrame.y = 1; // default land death animation
+    game->lives--;
+    if (game->frog->isDrowned)
+        PlayGameSound(ctx, &game->sounds.sunk);
     else
-        PlaySound(game.sounds.hit);
+        PlayGameSound(ctx, &game->sounds.hit);
 }
 
-void RespawnFrog(void)
+void RespawnFrog(GameContext *ctx)
 {
-    game.frog->position = game.spawnPos;
-    game.frog->seekPos = game.spawnPos;
-    game.frog->bufferPos= game.spawnPos;
-    game.frog->isWin = false;
-    game.frog->isDead = false;
-    game.frog->isDrowned = false;
-    game.frog->textureOffset.y = 0;
-    game.frog->textureOffset.x = 0;
-    game.prevFrogYPos = game.spawnPos.y;
-    game.rowsTravelled = 0;
+    GameState *game = &ctx->game;
+
+    game->frog->position = game->spawnPos;
+    game->frog->seekPos = game->spawnPos;
+    game->frog->bufferPos= game->spawnPos;
+    game->frog->isWin = false;
+    game->frog->isDead = false;
+    game->frog->isDrowned = false;
+    game->frog->animate.clip = NULL;
+    game->frog->spriteFrame.y = 0;
+    game->frog->spriteFrame.x = 0;
+    game->prevFrogYPos = game->spawnPos.y;
+    game->rowsTravelled = 0;
 }
 
-void StopGameSounds(void)
+void StopGameSounds(GameContext *ctx)
 {
-    StopSound(game.sounds.musicIntro);
-    StopMusicStream(game.sounds.musicLoop);
+    StopGameMusic(ctx); // effects are short, they play out
 }
 
@@ -17,6 +17,14 @@
 
 #define BASE_SPEED (GRID_UNIT*1.5f)
 
+#define TURTLE_PADDLE_LENGTH 0.25f // seconds per frame of the swimming turtles
+#define TURTLE_PADDLE_FRAMES 3
+#define TURTLE_SUNK_FRAME 2        // sinking turtle frame that's fully under water
+#define FROG_DEAD_FRAME 3          // frog death frame past the dying ones, drawn as SPRITE_FROG_DEAD
+
+#define GAME_FONT_SIZE (GRID_UNIT*0.5f) // HUD and messages
+#define GAME_FONT_FILE "assets/fonts/PressStart2P.ttf"
+
 // Types and Structures
 // ----------------------------------------------------------------------------
 
@@ -49,28 +57,40 @@ typedef enum {
 } EntityMoveDirection;
 
 typedef struct {
-    Sound hop, sunk, hit, win, blink, musicIntro;
-    Music musicLoop;
-} GameSounds;
+    EntityType type;
+    int row;
+    const char *pattern; // see CreateRow()
+    float speed;         // times the level's base speed
+} LevelRow;
+
+// Animations are a pure function of the level time, nothing steps them
+typedef struct {
+    int frame;      // in the entity's animation sprite, -1 = its own sprite
+    float duration; // times the entity's animation length
+} AnimationKey;
 
 typedef struct {
-    Texture atlas;
-    Rectangle grassPurple, grassGreen,
-              log, turtle, turtleSink, car,
-              frog, dead, dying, winFrog,
-              fly, life, level, score,
-              croc;
-} GameTextures;
+    const AnimationKey *keys;
+    int keyCount;
+    bool isLooping; // otherwise the last key is held
+} AnimationClip;
+
+typedef struct {
+    GameSound hop, sunk, hit, win, blink;
+    GameMusic music; // intro, then the loop
+} GameSounds;
 
 typedef struct {
     struct {
-        Rectangle sprite;
-        int frame, frames, frameIterate;
-        Vector2 offset;
-        float length, rate, timer;
+        Sprite sprite;
+        const AnimationClip *clip; // NULL when not animating
+        float length;              // seconds, scales the clip's key durations
+        float start;               // level time the clip started at
+        float timer;               // win zone blink delay
     } animate;
-    Rectangle rec, sprite;
-    Vector2 textureOffset;
+    Rectangle rec;      // moving entities: where they spawned, see GetEntityRec()
+    Sprite sprite;      // see sprites.h
+    Vector2 spriteFrame; // frame across and down, see GetSpriteFrame()
     Vector2 position;
     Vector2 seekPos;
     Vector2 bufferPos;
@@ -83,14 +103,13 @@ typedef struct {
     EntityType type;
     EntityFlags flags;
     bool isMoving;
-    bool isWrapping;
     bool isMoveBuffered;
     bool isOnPlatform;
     bool isDrowned;
-    bool isAnimated;
     bool isSinking;
     bool isDead;
     bool isWin;
+    int laneIdx; // lane strip it's drawn in, -1 = drawn as a sprite, see lanes.h
 } Entity;
 
 typedef struct {
@@ -122,11 +141,12 @@ typedef struct {
 
     RaylibAssets assets;
     GameSounds sounds;
-    GameTextures textures;
-    Font font;
+    Font font; // sprites are in the UI's atlas, see UiTextures
 
+    Arena levelArena; // everything that lives for one level, reset by CreateNextLevel()
     Entity *entities;
-    Entity *frog; // player frog
+    int entityCount, entityCapacity;
+    Entity *frog; // player frog, always the last entity
 
     int winCount;
     int winIndex;
@@ -140,51 +160,61 @@ typedef struct {
     float waitTimer;
     float freezeTimer;
     float deathTimer;
-    float animateTimer;
-    float animateTextureOffset;
+    double levelTime; // seconds played since the level started, drives the animations
 
     Vector2 grid[GRID_RES_X*GRID_RES_Y];
     Vector2 gridStart;
     Vector2 spawnPos;
-} GameState;
 
-extern GameState game; // global declaration
+    unsigned int randomState; // for GetGameRandomValue()
+} GameState;
 
 // Prototypes
 // ----------------------------------------------------------------------------
 
 // Initialization
-void InitGameState(void); // Initialize game data and allocate memory for sounds
-void CreateRow(EntityType type, int row, char *pattern, float speed); // create a row of entities (e.g. logs, cars)
-                                                                      // pattern:
-                                                                      // _ full unit space
-                                                                      // . half unit space
-                                                                      // O full width
-                                                                      // F fast sinking turtle
-                                                                      // S slow sinking turtle
-void CreateNextLevel(void);
-void FreeGameState(void);
+void InitGameState(GameContext *ctx); // Initialize game data and allocate memory for sounds
+void InitGameStateEx(GameContext *ctx, unsigned int randomSeed); // Initialize game data with a fixed random seed (for reproducible runs)
+void CreateRow(GameContext *ctx, EntityType type, int row, const char *pattern, float speed); // create a row of entities (e.g. logs, cars)
+                                                                                              // pattern:
+                                                                                              // _ full unit space
+                                                                                              // . half unit space
+                                                                                              // O full width
+                                                                                              // F fast sinking turtle
+                                                                                              // S slow sinking turtle
+int CountRowEntities(EntityType type, const char *pattern); // How many entities CreateRow() makes from a pattern
+const LevelRow *GetLevelRows(int level, int *rowCount); // Layout used for a level
+int CountLevelEntities(int level); // Entities in a level, frog included
+void CreateNextLevel(GameContext *ctx); // Rebuild the entities in the level arena for game->level
+void FreeGameState(GameContext *ctx);
+void BakeGameFont(GameContext *ctx); // (Re)load the game font at the pixel size it's drawn at on the render target
 
 // Update
-void UpdateGameFrame(void); // Updates all the game's data and objects for the current frame
-void UpdateFrog(void);
-void UpdateAnimationSinkingTurtle(Entity *e);
-void UpdateAnimationCroc(Entity *e);
-void UpdateHostile(Entity *hostile);
-void UpdatePlatform(Entity *platform);
-void UpdateWinZone(Entity *zone, int entityIndex);
-void MoveEntity(Entity *e);
+void UpdateGameFrame(GameContext *ctx); // Updates all the game's data and objects for the current frame
+void UpdateGameSimulation(GameContext *ctx); // Steps the game world only (no audio, pause or UI), used by UpdateGameFrame() and headless tools
+void UpdateFrog(GameContext *ctx);
+int GetEntityAnimationFrame(GameContext *ctx, const Entity *e); // Frame of the entity's animation at the current level time, -1 = its own sprite
+int GetTurtlePaddleFrame(GameContext *ctx); // Frame of the swimming turtles at the current level time
+void UpdateHostile(GameContext *ctx, Entity *hostile);
+void UpdatePlatform(GameContext *ctx, Entity *platform);
+void UpdateWinZone(GameContext *ctx, Entity *zone, int entityIndex);
+float GetLanePhase(GameContext *ctx, float speed); // How far a lane moving at speed has gone this level, wrapped at the grid width
+Rectangle GetEntityRec(GameContext *ctx, const Entity *e); // Where the entity is now, moving ones from their spawn and lane phase
+int GetEntityRecs(GameContext *ctx, const Entity *e, Rectangle recs[2]); // GetEntityRec() and its copy across the grid edge while wrapping, returns 1 or 2
 
 // Draw
-void DrawGameFrame(void); // Draws all the game's objects for the current frame
-void DrawWrappingEntity(Texture2D *atlas, Rectangle sprite, Rectangle rec, float angle, bool isWrapping);
-void DrawGrass(Rectangle grassRec);
+void DrawGameFrame(GameContext *ctx); // Draws all the game's objects for the current frame
+void DrawWrappingEntity(GameContext *ctx, Texture2D *atlas, Rectangle sprite, Rectangle rec, float angle); // sprite is the source rectangle, drawn once or twice across the grid edge
+int GetGridWrapOffsets(GameContext *ctx, float x, float width, float offsets[2]); // x offsets of the copies of [x, x + width) that show in the grid, returns 1 or 2
+void DrawGrass(GameContext *ctx, Rectangle grassRec);
+Rectangle GetLogTileSprite(const Entity *log, int tile); // Start, middle or end piece of a log
 
 // Misc
-Vector2 GetGridPosition(int row, int col);
-void KillFrog(void);
-void RespawnFrog(void);
-void StopGameSounds(void);
+int GetGameRandomValue(GameContext *ctx, int min, int max); // Random value from the game's own seeded generator
+Vector2 GetGridPosition(GameContext *ctx, int row, int col);
+void KillFrog(GameContext *ctx);
+void RespawnFrog(GameContext *ctx);
+void StopGameSounds(GameContext *ctx);
 
 #endif // FROGGER_GAME_HEADER_GUARD
 
@@ -2,12 +2,20 @@
 // Helps manage and handle game input
 // See header for more documentation/descriptions
 
-InputActionMaps inputMaps; // contains defined input action controls
+#include "common.h" // all project header includes
 
-void InitDefaultInputSettings(void)
+// Local Functions Declaration
+// ----------------------------------------------------------------------------
+static void AddInputBinding(InputBinding *bindings, int *count, int code, InputAction action);
+static void DrainInputEvents(GameContext *ctx);
+
+void InitDefaultInputSettings(GameContext *ctx)
 {
+    InputState *input = &ctx->input;
+    InputActionMaps *inputMaps = &ctx->inputMaps;
+
     // Setup default input
-    input = (InputState){
+    *input = (InputState){
         // Analog sticks deadzone input
         .gamepad.leftStickDeadzone = 0.25f,
         .gamepad.rightStickDeadzone = 0.25f,
@@ -17,10 +25,10 @@ void InitDefaultInputSettings(void)
 
     // For touch point UI button tracking
     for (int i = 0; i < INPUT_MAX_TOUCH_POINTS; i++)
-        input.touchPoints[i].currentButton = -1;
+        input->touchPoints[i].currentButton = -1;
 
     // Setup input action control mappings
-    inputMaps = (InputActionMaps){
+    *inputMaps = (InputActionMaps){
         // Global controls
         .gamepadButton[INPUT_ACTION_FULLSCREEN] = { GAMEPAD_BUTTON_SELECT },
         .key[INPUT_ACTION_FULLSCREEN] = {
@@ -68,43 +76,112 @@ void InitDefaultInputSettings(void)
     };
     if (!PLATFORM_HAS_ANALOG_TRIGGERS)
     {
-        // AddInputActionGamepadButton(INPUT_ACTION_THRUST, GAMEPAD_BUTTON_L2);
-        // AddInputActionGamepadButton(INPUT_ACTION_SHOOT, GAMEPAD_BUTTON_R2);
+        // AddInputActionGamepadButton(ctx, INPUT_ACTION_THRUST, GAMEPAD_BUTTON_L2);
+        // AddInputActionGamepadButton(ctx, INPUT_ACTION_SHOOT, GAMEPAD_BUTTON_R2);
     }
+    CompileInputBindings(ctx);
 }
 
-void AddInputActionGamepadButton(InputAction action, GamepadButton button)
+void AddInputActionGamepadButton(GameContext *ctx, InputAction action, GamepadButton button)
 {
+    InputActionMaps *inputMaps = &ctx->inputMaps;
+
     for (int i = 0; i < INPUT_MAX_MAPS; i++)
     {
-        if (inputMaps.gamepadButton[action][i] == 0)
+        if (inputMaps->gamepadButton[action][i] == 0)
         {
-            inputMaps.gamepadButton[action][i] = button;
+            inputMaps->gamepadButton[action][i] = button;
             break;
         }
     }
+    CompileInputBindings(ctx);
 }
 
-void UpdateInputFrame(void)
+void CompileInputBindings(GameContext *ctx)
 {
-    ProcessUserInput(INPUT_POLL_ALL);
-    if (input.cancelTime > 0)
+    InputActionMaps *inputMaps = &ctx->inputMaps;
+    InputBindingTable *table = &inputMaps->bindings;
+
+    *table = (InputBindingTable){ 0 };
+    for (int action = 0; action < INPUT_MAX_ACTIONS; action++)
     {
-        input.cancelTime -= game.frameTime;
-        input.mouse.moved = false;
-        CancelInputActions();
+        // Keys, a modifier followed by a regular key is a combination (only 1 modifier for now)
+        KeyboardKey *keys = inputMaps->key[action];
+        for (int i = 0; i < INPUT_MAX_MAPS && keys[i] != 0; i++)
+        {
+            bool isCombo = IsInputKeyModifier(keys[i]) && (i + 1 < INPUT_MAX_MAPS) &&
+                           (keys[i + 1] != 0) && !IsInputKeyModifier(keys[i + 1]);
+            if (!isCombo)
+            {
+                AddInputBinding(table->keys, &table->keyCount, keys[i], action);
+                continue;
+            }
+
+            int c = 0;
+            while ((c < table->comboCount) &&
+                   ((table->combos[c].modifier != keys[i]) || (table->combos[c].key != keys[i + 1])))
+                c++;
+            if (c == INPUT_MAX_BINDINGS) break;
+            if (c == table->comboCount)
+                table->combos[table->comboCount++] = (InputBindingCombo){ keys[i], keys[i + 1], 0 };
+            table->combos[c].actions |= INPUT_ACTION_BIT(action);
+            i++; // skip the combination's key
+        }
+
+        GamepadButton *buttons = inputMaps->gamepadButton[action];
+        for (int i = 0; i < INPUT_MAX_MAPS && buttons[i] != 0; i++)
+            AddInputBinding(table->gamepadButtons, &table->gamepadButtonCount, buttons[i], action);
+
+        MouseButton *mb = inputMaps->mouse[action];
+        for (int i = 0; i < INPUT_MAX_MOUSE_MAPS && mb[i] != 0; i++)
+            AddInputBinding(table->mouseButtons, &table->mouseButtonCount,
+                            (mb[i] == INPUT_MOUSE_LEFT_BUTTON)? MOUSE_LEFT_BUTTON : mb[i], action);
+
+        if (inputMaps->gamepadAxis[action].axis != 0)
+            table->axisActions |= INPUT_ACTION_BIT(action);
+    }
+}
+
+// Adds an action to an input's binding, or a new binding if the input isn't bound yet
+static void AddInputBinding(InputBinding *bindings, int *count, int code, InputAction action)
+{
+    int i = 0;
+    while ((i < *count) && (bindings[i].code != code))
+        i++;
+    if (i == INPUT_MAX_BINDINGS) return;
+    if (i == *count)
+        bindings[(*count)++] = (InputBinding){ code, 0 };
+    bindings[i].actions |= INPUT_ACTION_BIT(action);
+}
+
+void UpdateInputFrame(GameContext *ctx)
+{
+    InputState *input = &ctx->input;
+
+    DrainInputEvents(ctx);
+    ProcessUserInput(ctx, INPUT_POLL_ALL);
+    if (input->cancelTime > 0)
+    {
+        input->cancelTime -= ctx->game.frameTime;
+        input->mouse.moved = false;
+        CancelInputActions(ctx);
     }
 }
 
-void ProcessUserInput(InputPollFlag pollType)
+void ProcessUserInput(GameContext *ctx, InputPollFlag pollType)
 {
+    GameState *game = &ctx->game;
+    InputState *input = &ctx->input;
+    UiState *ui = &ctx->ui;
+    RenderData *viewport = &ctx->viewport;
+
     if (pollType & INPUT_POLL_KEYBOARD)
     {
         KeyboardKey currentKey = GetKeyPressed();
         if (IsInputKeyModifier(currentKey))
-            input.anyKeyPressed = false;
+            input->anyKeyPressed = false;
         else
-            input.anyKeyPressed = (currentKey != 0);
+            input->anyKeyPressed = (currentKey != 0);
     }
 
     if (pollType & INPUT_POLL_MOUSE)
@@ -112,65 +189,63 @@ void ProcessUserInput(InputPollFlag pollType)
         Vector2 mousePos = GetMousePosition();
         // adjust for window offset and scale (not needed for UI)
         Vector2 gameMousePos = {
-            (mousePos.x - viewport.x)/viewport.scale,
-            (mousePos.y - viewport.y)/viewport.scale
+            (mousePos.x - viewport->x)/viewport->scale,
+            (mousePos.y - viewport->y)/viewport->scale
         };
-        input.mouse.gamePosition = GetScreenToWorld2D(gameMousePos, game.camera);
-        input.mouse.uiPosition   = GetScreenToWorld2D(mousePos, ui.camera);
-        input.mouse.delta        = Vector2Scale(GetMouseDelta(), 1.0f/game.camera.zoom);
-        input.mouse.moved        = (Vector2Length(input.mouse.delta) > 0);
-        input.mouse.leftPressed  = IsMouseButtonPressed(MOUSE_BUTTON_LEFT);
-        input.mouse.leftDown     = IsMouseButtonDown(MOUSE_BUTTON_LEFT);
-        input.mouse.rightPressed = IsMouseButtonPressed(MOUSE_BUTTON_RIGHT);
-        input.mouse.rightDown    = IsMouseButtonDown(MOUSE_BUTTON_RIGHT);
-        input.mouse.pressed      = (input.mouse.leftPressed || input.mouse.rightPressed);
+        input->mouse.gamePosition = GetScreenToWorld2D(gameMousePos, game->camera);
+        input->mouse.uiPosition   = GetScreenToWorld2D(mousePos, ui->camera);
+        input->mouse.delta        = Vector2Scale(GetMouseDelta(), 1.0f/game->camera.zoom);
+        input->mouse.moved        = (Vector2Length(input->mouse.delta) > 0);
+        input->mouse.leftPressed  = IsMouseButtonPressed(MOUSE_BUTTON_LEFT);
+        input->mouse.leftDown     = IsMouseButtonDown(MOUSE_BUTTON_LEFT);
+        input->mouse.rightPressed = IsMouseButtonPressed(MOUSE_BUTTON_RIGHT);
+        input->mouse.rightDown    = IsMouseButtonDown(MOUSE_BUTTON_RIGHT);
+        input->mouse.pressed      = (input->mouse.leftPressed || input->mouse.rightPressed);
     }
 
     // Detect and update gamepad
     if (pollType & INPUT_POLL_GAMEPAD)
     {
-        input.gamepad.available = IsGamepadAvailable(input.gamepadId);
-        if (input.gamepad.available)
+        input->gamepad.available = IsGamepadAvailable(input->gamepadId);
+        if (input->gamepad.available)
         {
-            input.gamepadButtonPressed    = GetGamepadButtonPressed();
-            input.anyGamepadButtonPressed = IsGamepadButtonPressed(input.gamepadId, input.gamepadButtonPressed);
-            input.gamepad.leftStickX      = GetGamepadAxisMovement(input.gamepadId, GAMEPAD_AXIS_LEFT_X);
-            input.gamepad.leftStickY      = GetGamepadAxisMovement(input.gamepadId, GAMEPAD_AXIS_LEFT_Y);
-            input.gamepad.rightStickX     = GetGamepadAxisMovement(input.gamepadId, GAMEPAD_AXIS_RIGHT_X);
-            input.gamepad.rightStickY     = GetGamepadAxisMovement(input.gamepadId, GAMEPAD_AXIS_RIGHT_Y);
+            input->gamepadButtonPressed    = GetGamepadButtonPressed();
+            input->anyGamepadButtonPressed = IsGamepadButtonPressed(input->gamepadId, input->gamepadButtonPressed);
+            input->gamepad.leftStickX      = GetGamepadAxisMovement(input->gamepadId, GAMEPAD_AXIS_LEFT_X);
+            input->gamepad.leftStickY      = GetGamepadAxisMovement(input->gamepadId, GAMEPAD_AXIS_LEFT_Y);
+            input->gamepad.rightStickX     = GetGamepadAxisMovement(input->gamepadId, GAMEPAD_AXIS_RIGHT_X);
+            input->gamepad.rightStickY     = GetGamepadAxisMovement(input->gamepadId, GAMEPAD_AXIS_RIGHT_Y);
             if (PLATFORM_HAS_ANALOG_TRIGGERS)
             {
-                input.gamepad.leftTrigger     = GetGamepadAxisMovement(input.gamepadId, GAMEPAD_AXIS_LEFT_TRIGGER);
-                input.gamepad.rightTrigger    = GetGamepadAxisMovement(input.gamepadId, GAMEPAD_AXIS_RIGHT_TRIGGER);
+                input->gamepad.leftTrigger     = GetGamepadAxisMovement(input->gamepadId, GAMEPAD_AXIS_LEFT_TRIGGER);
+                input->gamepad.rightTrigger    = GetGamepadAxisMovement(input->gamepadId, GAMEPAD_AXIS_RIGHT_TRIGGER);
             }
 
+            input->gamepadAxisDownPreviousFrame = input->gamepadAxisDown;
+            input->gamepadAxisDown = 0;
             for (int i = 0; i < INPUT_MAX_ACTIONS; i++)
-            {
-                if (inputMaps.gamepadAxis[i].axis == 0)
-                    continue;
-                input.gamepadAxisPressedPreviousFrame[i] = input.gamepadAxisPressedCurrentFrame[i];
-                input.gamepadAxisPressedCurrentFrame[i] = IsInputActionAxisDown(i);
-            }
+                if ((ctx->inputMaps.bindings.axisActions & INPUT_ACTION_BIT(i)) && IsInputActionAxisDown(ctx, i))
+                    input->gamepadAxisDown |= INPUT_ACTION_BIT(i);
         }
-        else input.anyGamepadButtonPressed = false;
+        else input->anyGamepadButtonPressed = false;
     }
 
-    input.anyInputPressed = (input.mouse.pressed || input.anyGamepadButtonPressed || input.anyKeyPressed);
+    input->anyInputPressed = (input->mouse.pressed || input->anyGamepadButtonPressed || input->anyKeyPressed);
 
     if (pollType & INPUT_POLL_TOUCH)
     {
         // Detect touch mode
         int tCount = GetTouchPointCount();
-        input.touchCount = tCount;
+        input->touchCount = tCount;
 
-        if (input.touchCount == 0)
+        if (input->touchCount == 0)
         {
-            if (input.mouse.leftDown || input.mouse.rightDown || input.anyKeyPressed)
-                input.touchMode = false;
+            if (input->mouse.leftDown || input->mouse.rightDown || input->anyKeyPressed)
+                input->touchMode = false;
         }
-        else input.touchMode = true;
+        else input->touchMode = true;
 
-        if (input.touchMode)
+        if (input->touchMode)
         {
             // Update touch points
             if (tCount > INPUT_MAX_TOUCH_POINTS)
@@ -179,84 +254,142 @@ void ProcessUserInput(InputPollFlag pollType)
             {
                 Vector2 touchPos = GetTouchPosition(i);
                 Vector2 gameTouchPos = {
-                    (touchPos.x - viewport.x)/viewport.scale,
-                    (touchPos.y - viewport.y)/viewport.scale
+                    (touchPos.x - viewport->x)/viewport->scale,
+                    (touchPos.y - viewport->y)/viewport->scale
                 };
-                TouchPoint *touchPoint           = &input.touchPoints[i];
-                touchPoint->gamePosition         = GetScreenToWorld2D(gameTouchPos, game.camera);
+                TouchPoint *touchPoint           = &input->touchPoints[i];
+                touchPoint->gamePosition         = GetScreenToWorld2D(gameTouchPos, game->camera);
                 touchPoint->position             = touchPos;
                 touchPoint->pressedPreviousFrame = touchPoint->pressedCurrentFrame;
                 touchPoint->pressedCurrentFrame  = true;
                 touchPoint->currentButton        = -1;
                 touchPoint->id                   = GetTouchPointId(i);
+                touchPoint->gamepadHits          = GetUiGamepadHits(ctx, touchPos);
             }
             for (int i = tCount; i < INPUT_MAX_TOUCH_POINTS; i++)
-                input.touchPoints[i].pressedCurrentFrame = false;
+                input->touchPoints[i].pressedCurrentFrame = false;
 
 
             // Process touch gamepad
-            if (game.isPaused)
-                SetTouchInputActionDown(INPUT_ACTION_PAUSE, false);
-            else UpdateUiTouchInput(&ui.gamepad.pause, UI_INPUT_ON_PRESS);
-            if (ui.gamepad.dpad.enabled) UpdateUiDPad(&ui.gamepad.dpad);
-            if (ui.gamepad.stick.enabled) UpdateUiAnalogStick(&ui.gamepad.stick);
+            if (game->isPaused)
+                SetTouchInputActionDown(ctx, INPUT_ACTION_PAUSE, false);
+            else UpdateUiTouchInput(ctx, &ui->gamepad.pause, UI_GAMEPAD_PAUSE, UI_INPUT_ON_PRESS);
+            if (ui->gamepad.dpad.enabled) UpdateUiDPad(ctx, &ui->gamepad.dpad);
+            if (ui->gamepad.stick.enabled) UpdateUiAnalogStick(ctx, &ui->gamepad.stick);
         }
     }
 
     // Check input mappings
+    PollInputActions(ctx);
 
     if (pollType & INPUT_POLL_GLOBAL)
     {
-        input.global.fullscreen = IsInputActionPressed(INPUT_ACTION_FULLSCREEN);
-        input.global.debug      = IsInputActionPressed(INPUT_ACTION_DEBUG);
+        input->global.fullscreen = IsInputActionPressed(ctx, INPUT_ACTION_FULLSCREEN);
+        input->global.debug      = IsInputActionPressed(ctx, INPUT_ACTION_DEBUG);
     }
 
-    if ((pollType & INPUT_POLL_MENU) || (ui.currentMenu != UI_MENU_NONE))
+    if ((pollType & INPUT_POLL_MENU) || (ui->currentMenu != UI_MENU_NONE))
     {
-        input.menu.confirm   = IsInputActionPressed(INPUT_ACTION_CONFIRM);
-        input.menu.cancel    = IsInputActionPressed(INPUT_ACTION_CANCEL);
-        input.menu.moveUp    = IsInputActionDown(INPUT_ACTION_MENU_UP);
-        input.menu.moveDown  = IsInputActionDown(INPUT_ACTION_MENU_DOWN);
-        input.menu.moveLeft  = IsInputActionDown(INPUT_ACTION_MENU_LEFT);
-        input.menu.moveRight = IsInputActionDown(INPUT_ACTION_MENU_RIGHT);
+        input->menu.confirm   = IsInputActionPressed(ctx, INPUT_ACTION_CONFIRM);
+        input->menu.cancel    = IsInputActionPressed(ctx, INPUT_ACTION_CANCEL);
+        input->menu.moveUp    = IsInputActionDown(ctx, INPUT_ACTION_MENU_UP);
+        input->menu.moveDown  = IsInputActionDown(ctx, INPUT_ACTION_MENU_DOWN);
+        input->menu.moveLeft  = IsInputActionDown(ctx, INPUT_ACTION_MENU_LEFT);
+        input->menu.moveRight = IsInputActionDown(ctx, INPUT_ACTION_MENU_RIGHT);
     }
 
-    if ((pollType & INPUT_POLL_PLAYER) || (game.currentScreen == SCREEN_GAMEPLAY))
+    if ((pollType & INPUT_POLL_PLAYER) || (game->currentScreen == SCREEN_GAMEPLAY))
     {
-        input.player.pause     = IsInputActionPressed(INPUT_ACTION_PAUSE);
-        input.player.moveUp    = IsInputActionPressed(INPUT_ACTION_UP);
-        input.player.moveDown  = IsInputActionPressed(INPUT_ACTION_DOWN);
-        input.player.moveLeft  = IsInputActionPressed(INPUT_ACTION_LEFT);
-        input.player.moveRight = IsInputActionPressed(INPUT_ACTION_RIGHT);
+        input->player.pause     = IsInputActionPressed(ctx, INPUT_ACTION_PAUSE);
+        input->player.moveUp    = IsInputActionPressed(ctx, INPUT_ACTION_UP);
+        input->player.moveDown  = IsInputActionPressed(ctx, INPUT_ACTION_DOWN);
+        input->player.moveLeft  = IsInputActionPressed(ctx, INPUT_ACTION_LEFT);
+        input->player.moveRight = IsInputActionPressed(ctx, INPUT_ACTION_RIGHT);
     }
 
-    if (input.mouseCancelled || input.mouse.moved)
-        input.mouseCancelled = false;
-    else if (input.mouseCancelled)
-        CancelMouseInput();
+    if (input->mouseCancelled || input->mouse.moved)
+        input->mouseCancelled = false;
+    else if (input->mouseCancelled)
+        CancelMouseInput(ctx);
+
+    if (input->cancelled && (input->anyKeyPressed || input->anyGamepadButtonPressed))
+        input->cancelled = false;
+    else if (input->cancelled)
+        CancelInputActions(ctx);
+}
+
+void CancelMouseInput(GameContext *ctx)
+{
+    InputState *input = &ctx->input;
+
+    input->mouse  = (InputMouseState){ 0 };
+    input->mouseCancelled = true;
+}
+
+void CancelInputActions(GameContext *ctx)
+{
+    InputState *input = &ctx->input;
+
+    input->global  = (InputActionsGlobal){ 0 };
+    input->menu    = (InputActionsMenu){ 0 };
+    input->player  = (InputActionsPlayer){ 0 };
+    input->gamepad = (InputGamepadState){ 0 };
+    input->anyKeyPressed           = false;
+    input->anyGamepadButtonPressed = false;
+    input->anyInputPressed         = false;
+    input->cancelled = true;
+}
+
+void PushInputEvent(GameContext *ctx, InputEvent event)
+{
+    InputState *input = &ctx->input;
 
-    if (input.cancelled && (input.anyKeyPressed || input.anyGamepadButtonPressed))
-        input.cancelled = false;
-    else if (input.cancelled)
-        CancelInputActions();
+    if (input->eventCount < INPUT_MAX_EVENTS)
+        input->events[input->eventCount++] = event;
 }
 
-void CancelMouseInput(void)
+// Turns the queued key events into this frame's presses, once per frame so
+// polling again later in the frame (e.g. ChangeUiMenu()) sees the same presses
+static void DrainInputEvents(GameContext *ctx)
 {
-    input.mouse  = (InputMouseState){ 0 };
-    input.mouseCancelled = true;
+    InputState *input = &ctx->input;
+    InputBindingTable *table = &ctx->inputMaps.bindings;
+
+    input->eventActionsPressed = 0;
+    input->moveEventTime = 0;
+    for (int i = 0; i < input->eventCount; i++)
+    {
+        InputEvent *event = &input->events[i];
+        if (!event->pressed) continue;
+
+        InputActionMask actions = 0;
+        for (int k = 0; k < table->keyCount; k++)
+            if (table->keys[k].code == event->key) actions |= table->keys[k].actions;
+        for (int c = 0; c < table->comboCount; c++)
+            if (((int)table->combos[c].key == event->key) && IsKeyDown(table->combos[c].modifier))
+                actions |= table->combos[c].actions;
+
+        input->eventActionsPressed |= actions;
+        if ((actions & INPUT_PLAYER_MOVE_ACTIONS) && (input->moveEventTime == 0))
+        {
+            input->moveEventTime = event->time;
+            BeginLatencySample(ctx, event->time, GetTime());
+        }
+    }
+    input->eventCount = 0;
 }
 
-void CancelInputActions(void)
+void TrackInputMoveLatency(GameContext *ctx, double eventTime)
 {
-    input.global  = (InputActionsGlobal){ 0 };
-    input.menu    = (InputActionsMenu){ 0 };
-    input.player  = (InputActionsPlayer){ 0 };
-    input.gamepad = (InputGamepadState){ 0 };
-    input.anyKeyPressed           = false;
-    input.anyGamepadButtonPressed = false;
-    input.anyInputPressed         = false;
-    input.cancelled = true;
+    InputState *input = &ctx->input;
+
+    if (eventTime <= 0) return; // move wasn't from a queued event (e.g. gamepad, touch)
+
+    double time = GetTime();
+    input->moveLatency = (float)(time - eventTime);
+    MarkLatencyMove(ctx, eventTime, time);
+    if (input->moveLatencyAvg == 0) input->moveLatencyAvg = input->moveLatency;
+    else input->moveLatencyAvg = Lerp(input->moveLatencyAvg, input->moveLatency, 0.1f);
 }
 // Input Actions
 // ----------------------------------------------------------------------------
@@ -270,80 +403,87 @@ bool IsInputKeyModifier(KeyboardKey key)
     return false;
 }
 
-bool IsInputActionDown(InputAction action)
+void PollInputActions(GameContext *ctx)
 {
-    // Check touch screen button
-    if (input.touchButtonDown[action] == true)
-        return true;
+    InputState *input = &ctx->input;
+    InputBindingTable *table = &ctx->inputMaps.bindings;
+
+    InputActionMask down = 0;
+    InputActionMask pressed = 0;
 
-    // Check controller buttons
-    if (input.gamepad.available)
+    for (int i = 0; i < table->keyCount; i++)
     {
-        GamepadButton *buttons = inputMaps.gamepadButton[action];
-        for (int i = 0; i < INPUT_MAX_MAPS && buttons[i] != 0; i++)
-        {
-            GamepadButton button = buttons[i];
-            if (IsGamepadButtonDown(input.gamepadId, button))
-                return true;
-        }
-        if (IsInputActionAxisDown(action))
-            return true;
+        if (IsKeyDown(table->keys[i].code)) down |= table->keys[i].actions;
+        if (IsKeyPressed(table->keys[i].code)) pressed |= table->keys[i].actions;
     }
-
-    // Check potential key combinations
-    KeyboardKey* keys = inputMaps.key[action];
-    for (int i = 0; i < INPUT_MAX_MAPS && keys[i] != 0; i++)
+    for (int i = 0; i < table->comboCount; i++)
     {
-        KeyboardKey key = keys[i];
+        InputBindingCombo *combo = &table->combos[i];
+        if (!IsKeyDown(combo->modifier)) continue;
+        if (IsKeyDown(combo->key)) down |= combo->actions;
+        if (IsKeyPressed(combo->key)) pressed |= combo->actions;
+    }
 
-        // Check modifier plus next key (only 1 modifier for now)
-        if (IsInputKeyModifier(key))
+    if (input->gamepad.available)
+    {
+        for (int i = 0; i < table->gamepadButtonCount; i++)
         {
-            if ((i + 1 < INPUT_MAX_MAPS) && (keys[i + 1] != 0) &&
-                (!IsInputKeyModifier(keys[i + 1])))
-            {
-                if (IsKeyDown(key) && IsKeyDown(keys[i + 1]))
-                    return true;
-                i++;
-            }
-
-            // Check just the modifier by itself
-            else if (IsKeyDown(key))
-                return true;
+            InputBinding *b = &table->gamepadButtons[i];
+            if (IsGamepadButtonDown(input->gamepadId, b->code)) down |= b->actions;
+            if (IsGamepadButtonPressed(input->gamepadId, b->code)) pressed |= b->actions;
         }
+        down |= input->gamepadAxisDown;
+        pressed |= input->gamepadAxisDown & ~input->gamepadAxisDownPreviousFrame;
+    }
 
-        else if (IsKeyDown(key))
-            return true;
+    for (int i = 0; i < table->mouseButtonCount; i++)
+    {
+        if (IsMouseButtonDown(table->mouseButtons[i].code)) down |= table->mouseButtons[i].actions;
+        if (IsMouseButtonPressed(table->mouseButtons[i].code)) pressed |= table->mouseButtons[i].actions;
     }
 
-    // Check mouse buttons
-    if (IsInputActionMouseDown(action))
-        return true;
+    for (int i = 0; i < INPUT_MAX_ACTIONS; i++)
+    {
+        if (input->touchButtonDown[i]) down |= INPUT_ACTION_BIT(i);
+        if (input->touchButtonPressed[i]) pressed |= INPUT_ACTION_BIT(i);
+    }
 
-    return false;
+    // Queued key events, a press counts even if the key was released before this frame
+    pressed |= input->eventActionsPressed;
+
+    input->actionsDown = down;
+    input->actionsPressed = pressed;
+}
+
+bool IsInputActionDown(GameContext *ctx, InputAction action)
+{
+    return (ctx->input.actionsDown & INPUT_ACTION_BIT(action)) != 0;
 }
 
-bool IsInputActionAxisDown(InputAction action)
+bool IsInputActionAxisDown(GameContext *ctx, InputAction action)
 {
+    InputState *input = &ctx->input;
+    InputActionMaps *inputMaps = &ctx->inputMaps;
+
     // Sticks and triggers
-    GamepadAxis axis = inputMaps.gamepadAxis[action].axis;
-    float deadzone = inputMaps.gamepadAxis[action].deadzone;
+    GamepadAxis axis = inputMaps->gamepadAxis[action].axis;
+    float deadzone = inputMaps->gamepadAxis[action].deadzone;
     float axisValue = 0.0f;
     if (axis == INPUT_GAMEPAD_AXIS_LEFT_X)
         axis = GAMEPAD_AXIS_LEFT_X;
     switch (axis)
     {
-        case GAMEPAD_AXIS_LEFT_X: axisValue = input.gamepad.leftStickX;
+        case GAMEPAD_AXIS_LEFT_X: axisValue = input->gamepad.leftStickX;
                                   break;
-        case GAMEPAD_AXIS_LEFT_Y: axisValue = input.gamepad.leftStickY;
+        case GAMEPAD_AXIS_LEFT_Y: axisValue = input->gamepad.leftStickY;
                                   break;
-        case GAMEPAD_AXIS_RIGHT_X: axisValue = input.gamepad.rightStickX;
+        case GAMEPAD_AXIS_RIGHT_X: axisValue = input->gamepad.rightStickX;
                                    break;
-        case GAMEPAD_AXIS_RIGHT_Y: axisValue = input.gamepad.rightStickY;
+        case GAMEPAD_AXIS_RIGHT_Y: axisValue = input->gamepad.rightStickY;
                                    break;
-        case GAMEPAD_AXIS_LEFT_TRIGGER: axisValue = input.gamepad.leftTrigger;
+        case GAMEPAD_AXIS_LEFT_TRIGGER: axisValue = input->gamepad.leftTrigger;
                                         break;
-        case GAMEPAD_AXIS_RIGHT_TRIGGER: axisValue = input.gamepad.rightTrigger;
+        case GAMEPAD_AXIS_RIGHT_TRIGGER: axisValue = input->gamepad.rightTrigger;
                                          break;
         default: break;
     }
@@ -356,13 +496,13 @@ bool IsInputActionAxisDown(InputAction action)
     return false;
 }
 
-bool IsInputActionMouseDown(InputAction action)
+bool IsInputActionMouseDown(GameContext *ctx, InputAction action)
 {
-    // if (input.touchMode)
+    // if (ctx->input.touchMode)
     //     return false;
 
-    MouseButton* mb = inputMaps.mouse[action];
-    for (int i = 0; i < INPUT_MAX_MAPS && mb[i] != 0; i++)
+    MouseButton* mb = ctx->inputMaps.mouse[action];
+    for (int i = 0; i < INPUT_MAX_MOUSE_MAPS && mb[i] != 0; i++)
     {
         MouseButton button = mb[i];
         if (button == INPUT_MOUSE_LEFT_BUTTON)
@@ -374,73 +514,23 @@ bool IsInputActionMouseDown(InputAction action)
     return false;
 }
 
-bool IsInputActionPressed(InputAction action)
+bool IsInputActionPressed(GameContext *ctx, InputAction action)
 {
-    // Check touch screen button
-    if (input.touchButtonPressed[action] == true)
-        return true;
-
-    // Check controller input
-    if (input.gamepad.available)
-    {
-        // buttons
-        GamepadButton *buttons = inputMaps.gamepadButton[action];
-        for (int i = 0; i < INPUT_MAX_MAPS && buttons[i] != 0; i++)
-        {
-            GamepadButton button = buttons[i];
-            if (IsGamepadButtonPressed(input.gamepadId, button))
-                return true;
-        }
-        if (IsInputActionAxisPressed(action))
-            return true;
-    }
-
-    // Check potential key combinations
-    KeyboardKey* keys = inputMaps.key[action];
-    for (int i = 0; i < INPUT_MAX_MAPS && keys[i] != 0; i++)
-    {
-        KeyboardKey key = keys[i];
-
-        // Check modifier plus next key (only 1 modifier for now)
-        if (IsInputKeyModifier(key))
-        {
-            if ((i + 1 < INPUT_MAX_MAPS) && (keys[i + 1] != 0) &&
-                (!IsInputKeyModifier(keys[i + 1])))
-            {
-                if (IsKeyDown(key) && IsKeyPressed(keys[i + 1]))
-                    return true;
-                i++; // Skip the next key
-            }
-            // Check just the modifier by itself
-            else if (IsKeyPressed(key))
-                return true;
-        }
-
-        // Check a single key
-        else if (IsKeyPressed(key))
-            return true;
-    }
-
-    // Check mouse buttons
-    if (IsInputActionMousePressed(action))
-        return true;
-
-    return false;
+    return (ctx->input.actionsPressed & INPUT_ACTION_BIT(action)) != 0;
 }
 
-bool IsInputActionAxisPressed(InputAction action)
+bool IsInputActionAxisPressed(GameContext *ctx, InputAction action)
 {
-    if (!input.gamepadAxisPressedPreviousFrame[action] &&
-        input.gamepadAxisPressedCurrentFrame[action])
-        return true;
+    InputState *input = &ctx->input;
 
-    return false;
+    InputActionMask pressed = input->gamepadAxisDown & ~input->gamepadAxisDownPreviousFrame;
+    return (pressed & INPUT_ACTION_BIT(action)) != 0;
 }
 
-bool IsInputActionMousePressed(InputAction action)
+bool IsInputActionMousePressed(GameContext *ctx, InputAction action)
 {
-    MouseButton* mb = inputMaps.mouse[action];
-    for (int i = 0; i < INPUT_MAX_MAPS && mb[i] != 0; i++)
+    MouseButton* mb = ctx->inputMaps.mouse[action];
+    for (int i = 0; i < INPUT_MAX_MOUSE_MAPS && mb[i] != 0; i++)
     {
         MouseButton button = mb[i];
         if (button == INPUT_MOUSE_LEFT_BUTTON)
@@ -454,38 +544,45 @@ bool IsInputActionMousePressed(InputAction action)
 
 // Touch / Virtual Input
 // ----------------------------------------------------------------------------
-void SetTouchInputActionDown(InputAction action, bool buttonDown)
+void SetTouchInputActionDown(GameContext *ctx, InputAction action, bool buttonDown)
 {
+    GameState *game = &ctx->game;
+    InputState *input = &ctx->input;
+
     // prevent two buttons with the same action from interfering
-    if (input.touchButtonFrameActive[action] == game.frameCount)
+    if (input->touchButtonFrameActive[action] == game->frameCount)
         return;
     else if (buttonDown)
-        input.touchButtonFrameActive[action] = game.frameCount;
+        input->touchButtonFrameActive[action] = game->frameCount;
 
     // check and set if touch button was pressed (not held)
-    if (buttonDown && !input.touchButtonDown[action])
-        input.touchButtonPressed[action] = true;
+    if (buttonDown && !input->touchButtonDown[action])
+        input->touchButtonPressed[action] = true;
     else
-        input.touchButtonPressed[action] = false;
+        input->touchButtonPressed[action] = false;
 
-    input.touchButtonDown[action] = buttonDown;
+    input->touchButtonDown[action] = buttonDown;
 }
 
-void SetTouchPointButton(int index, int buttonIdx)
+void SetTouchPointButton(GameContext *ctx, int index, int buttonIdx)
 {
-    input.touchPoints[index].currentButton = buttonIdx;
+    ctx->input.touchPoints[index].currentButton = buttonIdx;
 }
 
-bool IsTouchPointTapped(int index)
+bool IsTouchPointTapped(GameContext *ctx, int index)
 {
-    return (input.touchPoints[index].pressedCurrentFrame &&
-            !input.touchPoints[index].pressedPreviousFrame);
+    InputState *input = &ctx->input;
+
+    return (input->touchPoints[index].pressedCurrentFrame &&
+            !input->touchPoints[index].pressedPreviousFrame);
 }
 
-bool IsTouchPointReleased(int index)
+bool IsTouchPointReleased(GameContext *ctx, int index)
 {
-    return (input.touchPoints[index].pressedPreviousFrame &&
-            !input.touchPoints[index].pressedCurrentFrame);
+    InputState *input = &ctx->input;
+
+    return (input->touchPoints[index].pressedPreviousFrame &&
+            !input->touchPoints[index].pressedCurrentFrame);
 }
 
 // bool IsTouchingButton(int index, int buttonId)
@@ -493,24 +590,28 @@ bool IsTouchPointReleased(int index)
 //     return input.touchPoints[index].currentButton == buttonId;
 // }
 
-bool IsTouchingAnyButton(int index)
+bool IsTouchingAnyButton(GameContext *ctx, int index)
 {
-    return input.touchPoints[index].currentButton != -1;
+    return ctx->input.touchPoints[index].currentButton != -1;
 }
 
-int CheckCollisionTouchCircle(Vector2 center, float radius)
+int CheckCollisionTouchCircle(GameContext *ctx, Vector2 center, float radius)
 {
-    for (int i = 0; i < input.touchCount; ++i)
-        if (CheckCollisionPointCircle(input.touchPoints[i].position, center, radius))
+    InputState *input = &ctx->input;
+
+    for (int i = 0; i < input->touchCount; ++i)
+        if (CheckCollisionPointCircle(input->touchPoints[i].position, center, radius))
             return i;
 
     return -1;
 }
 
-int CheckCollisionTouchRec(Rectangle rec)
+int CheckCollisionTouchRec(GameContext *ctx, Rectangle rec)
 {
-    for (int i = 0; i < input.touchCount; ++i)
-        if (CheckCollisionPointRec(input.touchPoints[i].position, rec))
+    InputState *input = &ctx->input;
+
+    for (int i = 0; i < input->touchCount; ++i)
+        if (CheckCollisionPointRec(input->touchPoints[i].position, rec))
             return i;
 
     return -1;
@@ -518,7 +619,7 @@ int CheckCollisionTouchRec(Rectangle rec)
 
 // Other
 // ----------------------------------------------------------------------------
-bool AutoRepeatShouldFire(AutoRepeatSettings *ar, bool fireCondition)
+bool AutoRepeatShouldFire(GameContext *ctx, AutoRepeatSettings *ar, bool fireCondition)
 {
     bool shouldFire = false;
     bool initialPress = (!ar->active && ar->heldTime == 0);
@@ -533,7 +634,7 @@ bool AutoRepeatShouldFire(AutoRepeatSettings *ar, bool fireCondition)
     // Update auto-scroll timer
     if (fireCondition)
     {
-        ar->heldTime += game.frameTime;
+        ar->heldTime += ctx->game.frameTime;
         if (ar->heldTime >= ar->triggerTime)
             ar->active = true;
     }
@@ -8,7 +8,10 @@
 // ----------------------------------------------------------------------------
 #define INPUT_MAX_ACTIONS 16 // Maximum number of game actions, e.g. confirm, pause, move up
 #define INPUT_MAX_MAPS 24 // Maximum number of inputs that can be mapped to an action
+#define INPUT_MAX_MOUSE_MAPS 4 // Maximum number of mouse buttons that can be mapped to an action
+#define INPUT_MAX_BINDINGS 64 // Maximum number of distinct keys/buttons bound across all actions
 #define INPUT_MAX_TOUCH_POINTS 8
+#define INPUT_MAX_EVENTS 64 // Maximum number of queued key events between two frames
 #define INPUT_ANALOG_MENU_DEADZONE 0.5f // Deadzone used for analog stick menu movement
 #define INPUT_ANALOG_GAME_DEADZONE 0.5f // Deadzone used for analog stick game movement
 #define INPUT_TRIGGER_BUTTON_DEADZONE 0.25f // Deadzone used when trigger is used as a button
@@ -18,6 +21,11 @@
 // Same as above, but for GAMEPAD_AXIS_LEFT_X
 #define INPUT_GAMEPAD_AXIS_LEFT_X 6
 
+// Bit for an action in an InputActionMask
+#define INPUT_ACTION_BIT(action) (1u << (action))
+#define INPUT_PLAYER_MOVE_ACTIONS (INPUT_ACTION_BIT(INPUT_ACTION_UP) | INPUT_ACTION_BIT(INPUT_ACTION_DOWN) | \
+                                   INPUT_ACTION_BIT(INPUT_ACTION_LEFT) | INPUT_ACTION_BIT(INPUT_ACTION_RIGHT))
+
 // Aliases (just a personal preference)
 #define GAMEPAD_BUTTON_NORTH  GAMEPAD_BUTTON_RIGHT_FACE_UP
 #define GAMEPAD_BUTTON_SOUTH  GAMEPAD_BUTTON_RIGHT_FACE_DOWN
@@ -127,6 +135,7 @@ typedef struct {
     bool pressedCurrentFrame;
     int id;
     int currentButton; // TODO this should probably just be a bool
+    unsigned int gamepadHits; // touch gamepad controls under this point (UiGamepadControl bits)
 } TouchPoint;
 
 typedef struct {
@@ -135,11 +144,43 @@ typedef struct {
                     // used to map analog stick or trigger as buttons
 } GamepadAxisMap;
 
+typedef unsigned int InputActionMask; // one bit per InputAction, see INPUT_ACTION_BIT()
+
+// Key press/release from the platform layer's window callbacks
+typedef struct {
+    double time;  // when it happened, in GetTime() seconds
+    int key;      // KeyboardKey
+    bool pressed; // false when released
+} InputEvent;
+
+typedef struct {
+    int code; // KeyboardKey, GamepadButton or MouseButton
+    InputActionMask actions; // every action the input is mapped to
+} InputBinding;
+
+typedef struct {
+    KeyboardKey modifier; // held
+    KeyboardKey key;      // pressed
+    InputActionMask actions;
+} InputBindingCombo;
+
+// The action maps compiled into a reverse lookup (input -> actions),
+// so each bound input is read once per frame, see CompileInputBindings()
+typedef struct {
+    InputBinding keys[INPUT_MAX_BINDINGS];
+    InputBinding gamepadButtons[INPUT_MAX_BINDINGS];
+    InputBinding mouseButtons[INPUT_MAX_BINDINGS];
+    InputBindingCombo combos[INPUT_MAX_BINDINGS];
+    int keyCount, gamepadButtonCount, mouseButtonCount, comboCount;
+    InputActionMask axisActions; // actions with a gamepad axis mapped
+} InputBindingTable;
+
 typedef struct {
     KeyboardKey key[INPUT_MAX_ACTIONS][INPUT_MAX_MAPS];
-    MouseButton mouse[INPUT_MAX_ACTIONS][4];
+    MouseButton mouse[INPUT_MAX_ACTIONS][INPUT_MAX_MOUSE_MAPS];
     GamepadButton gamepadButton[INPUT_MAX_ACTIONS][INPUT_MAX_MAPS];
     GamepadAxisMap gamepadAxis[INPUT_MAX_ACTIONS];
+    InputBindingTable bindings; // compiled from the maps above
 } InputActionMaps;
 
 // Tracks input data for the current frame
@@ -150,13 +191,28 @@ typedef struct {
     InputActionsMenu menu;
     InputActionsPlayer player;
 
+    // every action's state for the current frame, see PollInputActions()
+    InputActionMask actionsDown;
+    InputActionMask actionsPressed;
+
+    // key events since the last frame, so a quick tap between two frames isn't lost
+    InputEvent events[INPUT_MAX_EVENTS];
+    int eventCount;
+    InputActionMask eventActionsPressed; // the events' presses, drained once per frame by UpdateInputFrame()
+
+    // input to move latency, from a move key event to the frog starting its hop
+    double moveEventTime;         // this frame's first move press, 0 if none
+    double bufferedMoveEventTime; // for a move buffered during a hop
+    float moveLatency;            // last measured latency in seconds
+    float moveLatencyAvg;
+
     InputMouseState mouse;
 
     InputGamepadState gamepad;
     int gamepadId;
     int gamepadButtonPressed;
-    bool gamepadAxisPressedCurrentFrame[INPUT_MAX_ACTIONS]; // for when an axis is mapped as a button
-    bool gamepadAxisPressedPreviousFrame[INPUT_MAX_ACTIONS];
+    InputActionMask gamepadAxisDown; // for when an axis is mapped as a button
+    InputActionMask gamepadAxisDownPreviousFrame;
     bool anyGamepadButtonPressed;
 
     TouchPoint touchPoints[INPUT_MAX_TOUCH_POINTS];
@@ -181,42 +237,44 @@ typedef struct { // for auto rapid-fire input
     bool active;
 } AutoRepeatSettings;
 
-extern InputState input; // global declaration
-
 // Prototypes
 // ----------------------------------------------------------------------------
 
 // Primary
-void InitDefaultInputSettings(void); // Sets the default control settings and mappings
-void AddInputActionGamepadButton(InputAction action, GamepadButton button);
-void UpdateInputFrame(void);
-void ProcessUserInput(InputPollFlag pollFlag); // Process all user inputs and actions for the current frame
-void CancelMouseInput(void);
-void CancelInputActions(void); // Cancel all user input actions for the current frame
+void InitDefaultInputSettings(GameContext *ctx); // Sets the default control settings and mappings
+void AddInputActionGamepadButton(GameContext *ctx, InputAction action, GamepadButton button);
+void CompileInputBindings(GameContext *ctx); // Rebuilds the binding lookup, call after changing the action maps
+void UpdateInputFrame(GameContext *ctx); // Drains the queued key events, then processes the frame's input
+void ProcessUserInput(GameContext *ctx, InputPollFlag pollFlag); // Process all user inputs and actions for the current frame
+void CancelMouseInput(GameContext *ctx);
+void CancelInputActions(GameContext *ctx); // Cancel all user input actions for the current frame
+void PushInputEvent(GameContext *ctx, InputEvent event); // Queue a key event, called by the platform layer
+void TrackInputMoveLatency(GameContext *ctx, double eventTime); // Measure latency from a move event to now
 
 // Input Actions
+void PollInputActions(GameContext *ctx); // Reads every bound input once and sets all the action bits for this frame
 bool IsInputKeyModifier(KeyboardKey key);
-bool IsInputActionDown(InputAction action);
-bool IsInputActionPressed(InputAction action);
-bool IsInputActionAxisDown(InputAction action);
-bool IsInputActionAxisPressed(InputAction action);
-bool IsInputActionMouseDown(InputAction action);
-bool IsInputActionMousePressed(InputAction action);
+bool IsInputActionDown(GameContext *ctx, InputAction action); // From this frame's PollInputActions()
+bool IsInputActionPressed(GameContext *ctx, InputAction action); // From this frame's PollInputActions()
+bool IsInputActionAxisDown(GameContext *ctx, InputAction action);
+bool IsInputActionAxisPressed(GameContext *ctx, InputAction action);
+bool IsInputActionMouseDown(GameContext *ctx, InputAction action);
+bool IsInputActionMousePressed(GameContext *ctx, InputAction action);
 
 // Touch
-void SetTouchInputActionDown(InputAction action, bool buttonDown); // Set the touch input action to be pressed down or released this frame
-void SetTouchPointButton(int index, int buttonIdx); // Set a touch point's current button id (currently used for touch screen analog stick, which probably needs a redesign/rewrite)
+void SetTouchInputActionDown(GameContext *ctx, InputAction action, bool buttonDown); // Set the touch input action to be pressed down or released this frame
+void SetTouchPointButton(GameContext *ctx, int index, int buttonIdx); // Set a touch point's current button id (currently used for touch screen analog stick, which probably needs a redesign/rewrite)
 
-bool IsTouchPointTapped(int index); // Check if a touch point was tapped (touch equivalent for IsMouseButtonPressed)
-bool IsTouchPointReleased(int index); // Check if a touch point was released (touch equivalent for IsMouseButtonReleased)
+bool IsTouchPointTapped(GameContext *ctx, int index); // Check if a touch point was tapped (touch equivalent for IsMouseButtonPressed)
+bool IsTouchPointReleased(GameContext *ctx, int index); // Check if a touch point was released (touch equivalent for IsMouseButtonReleased)
 // bool IsTouchingButton(int index, int buttonId); // Check if a touch point is on a specific ui button
-bool IsTouchingAnyButton(int index); // Check if a touch point is on any button
+bool IsTouchingAnyButton(GameContext *ctx, int index); // Check if a touch point is on any button
 
-int CheckCollisionTouchCircle(Vector2 center, float radius); // Check if any touch points are within a circle, returns index to touch point or -1
-int CheckCollisionTouchRec(Rectangle rec); // Check if any touch points are within a rectangle, returns index to touch point or -1
+int CheckCollisionTouchCircle(GameContext *ctx, Vector2 center, float radius); // Check if any touch points are within a circle, returns index to touch point or -1
+int CheckCollisionTouchRec(GameContext *ctx, Rectangle rec); // Check if any touch points are within a rectangle, returns index to touch point or -1
 
 // Other
-bool AutoRepeatShouldFire(AutoRepeatSettings *ar, bool fireCondition);
+bool AutoRepeatShouldFire(GameContext *ctx, AutoRepeatSettings *ar, bool fireCondition);
 
 
 #endif // FROGGER_INPUT_HEADER_GUARD
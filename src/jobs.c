@@ -0,0 +1,115 @@
+// EXPLANATION:
+// A small job queue for work that can leave the main thread
+// See header for more documentation/descriptions
+
+#include "common.h" // all project header includes
+
+// Jobs
+// ----------------------------------------------------------------------------
+int AddJob(JobQueue *queue, JobFunc func, void *data)
+{
+    if ((queue->jobCount >= JOB_QUEUE_MAX_JOBS) || (queue->threadCount > 0)) return -1;
+
+    queue->jobs[queue->jobCount] = (Job){ .func = func, .data = data };
+    return queue->jobCount++;
+}
+
+int RunJobs(JobQueue *queue, int maxJobs)
+{
+    int ranCount = 0;
+    while (ranCount < maxJobs)
+    {
+        long job = PLATFORM_ATOMIC_ADD(&queue->nextJob, 1);
+        if (job >= queue->jobCount) break;
+
+        queue->jobs[job].func(queue->jobs[job].data);
+        PLATFORM_ATOMIC_STORE(&queue->jobs[job].isDone, 1); // publishes the job's results
+        ranCount++;
+    }
+    return ranCount;
+}
+
+bool IsJobDone(JobQueue *queue, int job)
+{
+    return PLATFORM_ATOMIC_LOAD(&queue->jobs[job].isDone) != 0;
+}
+
+// Threads
+// ----------------------------------------------------------------------------
+#if !PLATFORM_HAS_THREADS
+void StartJobThreads(JobQueue *queue, int threadCount)
+{
+    (void)queue; (void)threadCount; // the caller runs them with RunJobs()
+}
+
+static void JoinJobThreads(JobQueue *queue)
+{
+    (void)queue;
+}
+#elif defined(_WIN32) // Win32 threads, declared in platform.h
+static unsigned long __stdcall JobThreadMain(void *param)
+{
+    JobQueue *queue = param;
+    RunJobs(queue, queue->jobCount);
+    return 0;
+}
+
+void StartJobThreads(JobQueue *queue, int threadCount)
+{
+    threadCount = (threadCount < queue->jobCount)? threadCount : queue->jobCount;
+    threadCount = (threadCount < JOB_QUEUE_MAX_THREADS)? threadCount : JOB_QUEUE_MAX_THREADS;
+    for (int i = queue->threadCount; i < threadCount; i++)
+    {
+        queue->threads[i] = CreateThread(NULL, 0, JobThreadMain, queue, 0, NULL);
+        if (queue->threads[i] == NULL) break; // the rest run on the caller in WaitJobs()
+        queue->threadCount++;
+    }
+}
+
+static void JoinJobThreads(JobQueue *queue)
+{
+    for (int i = 0; i < queue->threadCount; i++)
+    {
+        WaitForSingleObject(queue->threads[i], 0xFFFFFFFF); // INFINITE
+        CloseHandle(queue->threads[i]);
+    }
+    queue->threadCount = 0;
+}
+#else
+static void *JobThreadMain(void *param)
+{
+    JobQueue *queue = param;
+    RunJobs(queue, queue->jobCount);
+    return NULL;
+}
+
+void StartJobThreads(JobQueue *queue, int threadCount)
+{
+    threadCount = (threadCount < queue->jobCount)? threadCount : queue->jobCount;
+    threadCount = (threadCount < JOB_QUEUE_MAX_THREADS)? threadCount : JOB_QUEUE_MAX_THREADS;
+    for (int i = queue->threadCount; i < threadCount; i++)
+    {
+        if (pthread_create(&queue->threads[i], NULL, JobThreadMain, queue) != 0) break; // the rest run on the caller in WaitJobs()
+        queue->threadCount++;
+    }
+}
+
+static void JoinJobThreads(JobQueue *queue)
+{
+    for (int i = 0; i < queue->threadCount; i++)
+        pthread_join(queue->threads[i], NULL);
+    queue->threadCount = 0;
+}
+#endif
+
+void WaitJobs(JobQueue *queue)
+{
+    RunJobs(queue, queue->jobCount);
+    JoinJobThreads(queue);
+}
+
+void ResetJobQueue(JobQueue *queue)
+{
+    WaitJobs(queue);
+    *queue = (JobQueue){ 0 };
+}
@@ -0,0 +1,55 @@
+// EXPLANATION:
+// A small job queue for work that can leave the main thread
+// Jobs are added up front, then StartJobThreads() starts worker threads that
+// claim them one at a time until the queue is empty, and exit. The caller can
+// check each job and pick up its results as they finish. Jobs must not call
+// anything that needs the main thread, e.g. the GPU context or TextFormat().
+// Without threads (web), the caller runs the jobs itself with RunJobs().
+
+#ifndef FROGGER_JOBS_HEADER_GUARD
+#define FROGGER_JOBS_HEADER_GUARD
+
+#if PLATFORM_HAS_THREADS && !defined(_WIN32)
+    #include <pthread.h>
+#endif
+
+// Macros
+// ----------------------------------------------------------------------------
+#define JOB_QUEUE_MAX_JOBS 64
+#define JOB_QUEUE_MAX_THREADS 8
+
+// Types and Structures
+// ----------------------------------------------------------------------------
+typedef void (*JobFunc)(void *data);
+
+#if PLATFORM_HAS_THREADS && !defined(_WIN32)
+typedef pthread_t JobThread;
+#else
+typedef void *JobThread; // Win32 handle, unused without threads
+#endif
+
+typedef struct {
+    JobFunc func;
+    void *data;
+    volatile long isDone; // set by whichever thread ran the job
+} Job;
+
+typedef struct {
+    Job jobs[JOB_QUEUE_MAX_JOBS];
+    int jobCount;
+    volatile long nextJob; // next job to claim, past jobCount when all are claimed
+
+    JobThread threads[JOB_QUEUE_MAX_THREADS];
+    int threadCount;
+} JobQueue;
+
+// Prototypes
+// ----------------------------------------------------------------------------
+int AddJob(JobQueue *queue, JobFunc func, void *data); // Returns the job's index, -1 if the queue is full or started
+void StartJobThreads(JobQueue *queue, int threadCount); // Start working through the added jobs (no threads on web)
+int RunJobs(JobQueue *queue, int maxJobs); // Claim and run up to maxJobs jobs on this thread, returns how many ran
+bool IsJobDone(JobQueue *queue, int job); // The job's results can be read
+void WaitJobs(JobQueue *queue); // Help run the remaining jobs, then join the threads
+void ResetJobQueue(JobQueue *queue); // Wait, then empty the queue for new jobs
+
+#endif // FROGGER_JOBS_HEADER_GUARD
@@ -0,0 +1,193 @@
+// EXPLANATION:
+// Lane strip renderer, each moving lane is drawn as one scrolling quad
+// See header for more documentation/descriptions
+
+#include "common.h" // all project header includes
+
+// Module Functions Definition
+// ----------------------------------------------------------------------------
+
+// The entity as it's drawn in the game, at frame of its strip
+static void DrawLaneEntity(Texture *atlas, const Entity *e, Rectangle rec, int frame)
+{
+    if (e->type == ENTITY_TYPE_LOG)
+    {
+        int logWidth = (int)(e->rec.width/GRID_UNIT);
+        rec.width = SPRITE_SIZE;
+        for (int i = 0; i < logWidth; i++)
+        {
+            DrawSpriteOnRectangle(atlas, GetLogTileSprite(e, i), rec, 0);
+            rec.x += SPRITE_SIZE;
+        }
+        return;
+    }
+
+    Vector2 spriteFrame = e->spriteFrame;
+    if (e->type == ENTITY_TYPE_TURTLE) spriteFrame.x = (float)frame;
+    DrawSpriteOnRectangle(atlas, GetSpriteFrame(e->sprite, spriteFrame), rec, 0);
+}
+
+void InitLaneStrips(GameContext *ctx)
+{
+    LaneStrips *lanes = &ctx->lanes;
+
+    UnloadLaneStrips(ctx);
+    lanes->isEnabled = LANE_STRIPS_ENABLED;
+}
+
+void ToggleLaneStrips(GameContext *ctx)
+{
+    LaneStrips *lanes = &ctx->lanes;
+
+    lanes->isEnabled = !lanes->isEnabled;
+}
+
+void LayoutLaneStrips(GameContext *ctx)
+{
+    GameState *game = &ctx->game;
+    LaneStrips *lanes = &ctx->lanes;
+
+    lanes->stripCount = 0;
+    lanes->rowCount = 0;
+    lanes->isBaked = false;
+
+    for (int i = 0; i < game->entityCount; i++)
+    {
+        Entity *e = &game->entities[i];
+        e->laneIdx = -1;
+
+        // Only what looks the same all level and moves with its lane
+        if (!(e->flags & ENTITY_FLAG_MOVE) || (e->animate.clip != NULL)) continue;
+
+        int idx = 0;
+        while ((idx < lanes->stripCount) &&
+               ((lanes->strips[idx].y != e->rec.y) || (lanes->strips[idx].speed != e->speed)))
+            idx++;
+
+        if (idx == lanes->stripCount)
+        {
+            if (lanes->stripCount >= LANE_STRIP_MAX) continue; // stays a sprite
+            lanes->strips[lanes->stripCount++] = (LaneStrip){
+                .anchorIdx = i,
+                .frameCount = 1,
+                .y = e->rec.y,
+                .speed = e->speed,
+            };
+        }
+        if (e->type == ENTITY_TYPE_TURTLE) lanes->strips[idx].frameCount = TURTLE_PADDLE_FRAMES;
+        e->laneIdx = idx;
+    }
+
+    for (int i = 0; i < lanes->stripCount; i++)
+    {
+        lanes->strips[i].firstRow = lanes->rowCount;
+        lanes->rowCount += lanes->strips[i].frameCount;
+    }
+}
+
+void UpdateLaneStrips(GameContext *ctx)
+{
+    GameState *game = &ctx->game;
+    LaneStrips *lanes = &ctx->lanes;
+    Texture *atlas = &ctx->ui.textures.atlas;
+
+    if (!lanes->isEnabled || lanes->isBaked || (lanes->stripCount == 0) || (atlas->id == 0)) return;
+
+    // Power of two height, GLES2/WebGL can only repeat those
+    int height = SPRITE_SIZE;
+    while (height < lanes->rowCount*SPRITE_SIZE) height *= 2;
+    if (lanes->texture.texture.height < height)
+    {
+        if (IsRenderTextureValid(lanes->texture))
+            UnloadRenderTexture(lanes->texture);
+        lanes->texture = LoadRenderTexture(LANE_STRIP_WIDTH, height);
+        SetTextureFilter(lanes->texture.texture, TEXTURE_FILTER_POINT);
+        SetTextureWrap(lanes->texture.texture, TEXTURE_WRAP_REPEAT);
+    }
+
+    BeginTextureMode(lanes->texture);
+        ClearBackground(BLANK);
+
+        for (int i = 0; i < game->entityCount; i++)
+        {
+            Entity *e = &game->entities[i];
+            if (e->laneIdx < 0) continue;
+
+            LaneStrip *strip = &lanes->strips[e->laneIdx];
+            float x = GetLaneEntityTexel(ctx, e);
+            float width = roundf(e->rec.width*LANE_STRIP_SCALE);
+
+            for (int frame = 0; frame < strip->frameCount; frame++)
+            {
+                Rectangle rec = { x, (float)((strip->firstRow + frame)*SPRITE_SIZE), width, SPRITE_SIZE };
+                DrawLaneEntity(atlas, e, rec, frame);
+
+                // Past the end of the strip, the rest goes at its start
+                if (rec.x + rec.width > LANE_STRIP_WIDTH)
+                {
+                    rec.x -= LANE_STRIP_WIDTH;
+                    DrawLaneEntity(atlas, e, rec, frame);
+                }
+            }
+        }
+
+    EndTextureMode();
+    lanes->isBaked = true;
+}
+
+bool DrawLaneStrips(GameContext *ctx)
+{
+    GameState *game = &ctx->game;
+    LaneStrips *lanes = &ctx->lanes;
+    Texture *texture = &lanes->texture.texture;
+
+    if (!lanes->isEnabled || !lanes->isBaked) return false;
+
+    int paddleFrame = GetTurtlePaddleFrame(ctx);
+    for (int i = 0; i < lanes->stripCount; i++)
+    {
+        LaneStrip *strip = &lanes->strips[i];
+        int frame = (strip->frameCount > 1)? paddleFrame : 0;
+
+        // Render textures are upside down, the source is flipped back
+        float rowY = (float)((strip->firstRow + frame)*SPRITE_SIZE);
+        Rectangle source = {
+            -GetLaneStripScroll(ctx, strip), texture->height - rowY - SPRITE_SIZE,
+            LANE_STRIP_WIDTH, -SPRITE_SIZE
+        };
+        Rectangle dest = { game->gridStart.x, strip->y, GRID_WIDTH, GRID_UNIT };
+        DrawTexturePro(*texture, source, dest, Vector2Zero(), 0, WHITE);
+    }
+
+    return true;
+}
+
+float GetLaneEntityTexel(GameContext *ctx, const Entity *e)
+{
+    GameState *game = &ctx->game;
+    LaneStrips *lanes = &ctx->lanes;
+
+    // Placed from the anchor's spawn, the layout is whole texels apart
+    Entity *anchor = &game->entities[lanes->strips[e->laneIdx].anchorIdx];
+    float x = fmodf(roundf((e->rec.x - anchor->rec.x)*LANE_STRIP_SCALE), LANE_STRIP_WIDTH);
+    if (x < 0) x += LANE_STRIP_WIDTH;
+    return x;
+}
+
+float GetLaneStripScroll(GameContext *ctx, const LaneStrip *strip)
+{
+    GameState *game = &ctx->game;
+
+    Rectangle anchor = GetEntityRec(ctx, &game->entities[strip->anchorIdx]);
+    return Wrap((anchor.x - game->gridStart.x)*LANE_STRIP_SCALE, 0, LANE_STRIP_WIDTH);
+}
+
+void UnloadLaneStrips(GameContext *ctx)
+{
+    LaneStrips *lanes = &ctx->lanes;
+
+    if (IsRenderTextureValid(lanes->texture))
+        UnloadRenderTexture(lanes->texture);
+    lanes->texture = (RenderTexture){ 0 };
+    lanes->isBaked = false;
+}
@@ -0,0 +1,50 @@
+// EXPLANATION:
+// Lane strip renderer, each moving lane is drawn as one scrolling quad
+// Every entity in a lane moves at the lane's speed and wraps at the grid
+// width, so a lane looks the same at any time, only shifted. When a level
+// starts, each lane's cars, logs, croc bodies and swimming turtles are drawn
+// once into a strip of a texture (one strip per turtle paddle frame), the
+// size of the sprites. Each frame a lane is then one quad, its texture
+// coordinates scrolled by how far the lane moved and wrapped by the texture.
+// Anything animated on its own (sinking turtles, croc heads) and everything
+// outside the lanes is still drawn as sprites on top.
+
+#ifndef FROGGER_LANES_HEADER_GUARD
+#define FROGGER_LANES_HEADER_GUARD
+
+// Macros
+// ----------------------------------------------------------------------------
+#define LANE_STRIP_MAX GRID_RES_Y
+#define LANE_STRIP_WIDTH (GRID_RES_X*SPRITE_SIZE)  // texels, the grid width at sprite size
+#define LANE_STRIP_SCALE (SPRITE_SIZE/GRID_UNIT)   // texels per world unit
+
+// Types and Structures
+// ----------------------------------------------------------------------------
+typedef struct {
+    int anchorIdx;  // entity at texel 0 of the strip, the lane scrolls with it
+    int firstRow;   // SPRITE_SIZE tall texture row of the strip's first frame
+    int frameCount; // TURTLE_PADDLE_FRAMES with swimming turtles, otherwise 1
+    float y, speed; // top of the lane, entities with both are in it
+} LaneStrip;
+
+typedef struct {
+    RenderTexture texture; // all the strips' frames stacked, wraps horizontally
+    LaneStrip strips[LANE_STRIP_MAX];
+    int stripCount;
+    int rowCount;          // texture rows the strips use
+    bool isEnabled;
+    bool isBaked;          // the texture holds the current level's strips
+} LaneStrips;
+
+// Prototypes
+// ----------------------------------------------------------------------------
+void InitLaneStrips(GameContext *ctx);
+void ToggleLaneStrips(GameContext *ctx); // Switch between the lane strips and drawing every entity as sprites
+void LayoutLaneStrips(GameContext *ctx); // Group the level's entities into strips, call after the entities change
+void UpdateLaneStrips(GameContext *ctx); // Bake the strips once the atlas is loaded (can't be nested in texture mode)
+bool DrawLaneStrips(GameContext *ctx);   // Draw every strip, false when they aren't baked and the entities must be drawn instead
+float GetLaneEntityTexel(GameContext *ctx, const Entity *e); // Where the entity is baked in its strip, texels from the anchor
+float GetLaneStripScroll(GameContext *ctx, const LaneStrip *strip); // Texels the strip's texture coordinates are shifted by
+void UnloadLaneStrips(GameContext *ctx);
+
+#endif // FROGGER_LANES_HEADER_GUARD
@@ -0,0 +1,164 @@
+// EXPLANATION:
+// Input latency instrumentation, active while debug mode is on
+// See header for more documentation/descriptions
+
+#include "common.h" // all project header includes
+
+#include <stdlib.h> // qsort
+#include <string.h> // memcpy
+
+static const LatencyPacing latencyPacings[] = {
+    { "config.h",           VSYNC_ENABLED, MAX_FRAMERATE },
+    { "vsync, uncapped",    true,          0 },
+    { "no vsync, 60 fps",   false,         60 },
+    { "no vsync, uncapped", false,         0 },
+};
+#define LATENCY_PACING_COUNT (int)(sizeof(latencyPacings)/sizeof(latencyPacings[0]))
+
+static const char *latencySeriesNames[LATENCY_SERIES_COUNT] = {
+    "poll", "move", "draw", "present", "total"
+};
+
+static int CompareFloat(const void *a, const void *b)
+{
+    float x = *(const float *)a, y = *(const float *)b;
+    return (x > y) - (x < y);
+}
+
+static void UpdateLatencyStats(LatencyTracker *latency)
+{
+    float sorted[LATENCY_MAX_SAMPLES];
+    int count = latency->sampleCount;
+
+    for (int i = 0; i < LATENCY_SERIES_COUNT; i++)
+    {
+        memcpy(sorted, latency->samples[i], count*sizeof(sorted[0]));
+        qsort(sorted, count, sizeof(sorted[0]), CompareFloat);
+        latency->stats[i] = (LatencyStats){
+            .min = sorted[0],
+            .p50 = sorted[(int)(0.50f*(count - 1) + 0.5f)],
+            .p95 = sorted[(int)(0.95f*(count - 1) + 0.5f)],
+            .p99 = sorted[(int)(0.99f*(count - 1) + 0.5f)],
+            .max = sorted[count - 1],
+        };
+    }
+}
+
+static void AddLatencySample(LatencyTracker *latency)
+{
+    double previous = latency->eventTime;
+    for (int i = 0; i < LATENCY_STAGE_COUNT; i++)
+    {
+        latency->samples[i][latency->sampleIdx] = (float)((latency->stageTime[i] - previous)*1000);
+        previous = latency->stageTime[i];
+    }
+    latency->samples[LATENCY_SERIES_TOTAL][latency->sampleIdx] =
+        (float)((latency->stageTime[LATENCY_STAGE_PRESENT] - latency->eventTime)*1000);
+
+    latency->sampleIdx = (latency->sampleIdx + 1) % LATENCY_MAX_SAMPLES;
+    if (latency->sampleCount < LATENCY_MAX_SAMPLES) latency->sampleCount++;
+
+    UpdateLatencyStats(latency);
+}
+
+void BeginLatencySample(GameContext *ctx, double eventTime, double time)
+{
+    LatencyTracker *latency = &ctx->latency;
+
+    if (!ctx->game.isDebugMode) return;
+
+    // Only one move at a time, unless the followed press never became a hop
+    if ((latency->nextStage != LATENCY_STAGE_POLL) &&
+        (time - latency->eventTime < LATENCY_SAMPLE_TIMEOUT))
+        return;
+
+    latency->eventTime = eventTime;
+    latency->stageTime[LATENCY_STAGE_POLL] = time;
+    latency->nextStage = LATENCY_STAGE_MOVE;
+}
+
+void MarkLatencyMove(GameContext *ctx, double eventTime, double time)
+{
+    LatencyTracker *latency = &ctx->latency;
+
+    if ((latency->nextStage != LATENCY_STAGE_MOVE) || (eventTime != latency->eventTime)) return;
+
+    latency->stageTime[LATENCY_STAGE_MOVE] = time;
+    latency->nextStage = LATENCY_STAGE_DRAW;
+}
+
+void MarkLatencyStage(GameContext *ctx, LatencyStage stage, double time)
+{
+    LatencyTracker *latency = &ctx->latency;
+
+    if (!ctx->game.isDebugMode) return;
+
+    if (stage == LATENCY_STAGE_PRESENT)
+    {
+        // Frame times, to see what the pacing setting actually gives
+        if (latency->lastPresentTime > 0)
+        {
+            latency->frameTimeSum += time - latency->lastPresentTime;
+            latency->frameCount++;
+        }
+        latency->lastPresentTime = time;
+    }
+
+    if (stage != latency->nextStage) return;
+
+    latency->stageTime[stage] = time;
+    if (stage == LATENCY_STAGE_PRESENT)
+    {
+        AddLatencySample(latency);
+        latency->nextStage = LATENCY_STAGE_POLL;
+    }
+    else latency->nextStage = (LatencyStage)(stage + 1);
+}
+
+void CycleLatencyPacing(GameContext *ctx)
+{
+    LatencyTracker *latency = &ctx->latency;
+
+    if (!PLATFORM_HAS_FRAME_PACING) return;
+
+    PrintLatencyReport(ctx);
+
+    latency->pacingIdx = (latency->pacingIdx + 1) % LATENCY_PACING_COUNT;
+    ResetLatencyTracker(ctx);
+
+    const LatencyPacing *pacing = GetLatencyPacing(ctx);
+    SetTargetFPS(pacing->maxFramerate);
+    if (pacing->vsync) SetWindowState(FLAG_VSYNC_HINT);
+    else ClearWindowState(FLAG_VSYNC_HINT);
+}
+
+void ResetLatencyTracker(GameContext *ctx)
+{
+    LatencyTracker *latency = &ctx->latency;
+
+    *latency = (LatencyTracker){ .pacingIdx = latency->pacingIdx };
+}
+
+const LatencyPacing *GetLatencyPacing(GameContext *ctx)
+{
+    return &latencyPacings[ctx->latency.pacingIdx];
+}
+
+void PrintLatencyReport(GameContext *ctx)
+{
+    LatencyTracker *latency = &ctx->latency;
+    const LatencyPacing *pacing = GetLatencyPacing(ctx);
+
+    if (latency->sampleCount == 0) return;
+
+    TraceLog(LOG_INFO, "LATENCY: %s (vsync %s, max %i fps, late latch %s): %i moves, %.2f ms avg frame",
+             pacing->name, pacing->vsync? "on" : "off", pacing->maxFramerate,
+             ctx->pacer.enabled? "on" : "off", latency->sampleCount,
+             (latency->frameCount > 0)? latency->frameTimeSum*1000/latency->frameCount : 0.0);
+    for (int i = 0; i < LATENCY_SERIES_COUNT; i++)
+    {
+        LatencyStats *s = &latency->stats[i];
+        TraceLog(LOG_INFO, "LATENCY:     %-8s min %6.2f  p50 %6.2f  p95 %6.2f  p99 %6.2f  max %6.2f ms",
+                 latencySeriesNames[i], s->min, s->p50, s->p95, s->p99, s->max);
+    }
+}
@@ -0,0 +1,65 @@
+// EXPLANATION:
+// Input latency instrumentation, active while debug mode is on
+// Follows one queued move press at a time through the frame: polled by the
+// input, frog hop started in UpdateFrog(), game frame drawn, and EndDrawing()
+// returned (buffer swap and frame limiter wait). Each stage and the whole
+// press to present time are kept as distributions, per frame pacing setting
+// (vsync and max framerate), so the settings from config.h can be compared.
+
+#ifndef FROGGER_LATENCY_HEADER_GUARD
+#define FROGGER_LATENCY_HEADER_GUARD
+
+// Macros
+// ----------------------------------------------------------------------------
+#define LATENCY_MAX_SAMPLES 256     // most recent moves kept per series
+#define LATENCY_SAMPLE_TIMEOUT 1.0  // seconds, drop a press that never became a hop
+#define LATENCY_SERIES_TOTAL LATENCY_STAGE_COUNT // series index of press to present
+#define LATENCY_SERIES_COUNT (LATENCY_STAGE_COUNT + 1)
+
+// Types and Structures
+// ----------------------------------------------------------------------------
+typedef enum {
+    LATENCY_STAGE_POLL,    // key event until the frame's input poll
+    LATENCY_STAGE_MOVE,    // input poll until UpdateFrog() sets the frog's seekPos
+    LATENCY_STAGE_DRAW,    // hop start until the game frame is drawn
+    LATENCY_STAGE_PRESENT, // drawn until EndDrawing() returns
+    LATENCY_STAGE_COUNT
+} LatencyStage;
+
+typedef struct {
+    const char *name;
+    bool vsync;
+    int maxFramerate; // 0 = uncapped
+} LatencyPacing;
+
+typedef struct {
+    float min, p50, p95, p99, max; // milliseconds
+} LatencyStats;
+
+typedef struct {
+    // Move being followed, nextStage == LATENCY_STAGE_POLL when there is none
+    double eventTime;
+    double stageTime[LATENCY_STAGE_COUNT];
+    LatencyStage nextStage;
+
+    // Results for the current pacing setting
+    float samples[LATENCY_SERIES_COUNT][LATENCY_MAX_SAMPLES]; // milliseconds, ring buffer
+    int sampleIdx, sampleCount;
+    LatencyStats stats[LATENCY_SERIES_COUNT];
+    double frameTimeSum, lastPresentTime;
+    int frameCount;
+
+    int pacingIdx; // into the pacing settings, 0 is config.h
+} LatencyTracker;
+
+// Prototypes
+// ----------------------------------------------------------------------------
+void BeginLatencySample(GameContext *ctx, double eventTime, double time); // A move press was polled, follow it if no other move is
+void MarkLatencyMove(GameContext *ctx, double eventTime, double time); // The frog started a hop for the press at eventTime
+void MarkLatencyStage(GameContext *ctx, LatencyStage stage, double time); // The frame reached a draw/present stage, call every frame
+void CycleLatencyPacing(GameContext *ctx); // Report the current pacing setting and switch to the next one (desktop only)
+void ResetLatencyTracker(GameContext *ctx); // Clear the samples, keeping the pacing setting
+const LatencyPacing *GetLatencyPacing(GameContext *ctx);
+void PrintLatencyReport(GameContext *ctx); // Log the distributions for the current pacing setting
+
+#endif // FROGGER_LATENCY_HEADER_GUARD
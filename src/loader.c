@@ -0,0 +1,154 @@
+// EXPLANATION:
+// Asset loading in the background while the logo plays
+// See header for more documentation/descriptions
+
+#include "common.h" // all project header includes
+
+#include <string.h> // strncpy
+
+// Runs on a worker thread, only decodes into memory
+static void DecodeAssetJob(void *data)
+{
+    AssetLoad *load = data;
+
+    switch (load->type)
+    {
+        case ASSET_LOAD_TEXTURE: load->image = DecodeImageAsset(load->fileName); break;
+        case ASSET_LOAD_SOUND:
+            load->wave = DecodeWaveAsset(load->fileName);
+            if (load->wave.data != NULL) WaveFormat(&load->wave, AUDIO_SAMPLE_RATE, 16, 1); // the mixer's format
+            break;
+        case ASSET_LOAD_FONT:    load->font = DecodeFontAsset(load->fileName, load->fontSize); break;
+    }
+}
+
+static void UploadAsset(AssetLoad *load)
+{
+    switch (load->type)
+    {
+        case ASSET_LOAD_TEXTURE: *(Texture *)load->dest = UploadTextureAsset(load->pool, load->image, load->filter); break;
+        case ASSET_LOAD_SOUND:
+            ((GameSound *)load->dest)->wave = AddWaveAsset(load->pool, load->wave);
+            break;
+        case ASSET_LOAD_FONT:    *(Font *)load->dest = UploadFontAsset(load->pool, load->font, load->filter); break;
+    }
+    load->isUploaded = true;
+}
+
+static void QueueAssetLoad(GameContext *ctx, AssetLoad load)
+{
+    AssetLoader *loader = &ctx->loader;
+
+    // The running batch can't take more jobs, finish it first
+    if (loader->isStarted) FinishAssetLoads(ctx);
+
+    if (loader->loadCount == 0) loader->startTime = GetTime();
+
+    AssetLoad *slot = NULL;
+    if (loader->loadCount < ASSET_LOADER_MAX_LOADS)
+    {
+        slot = &loader->loads[loader->loadCount];
+        *slot = load;
+        slot->job = AddJob(&loader->jobs, DecodeAssetJob, slot);
+    }
+    if ((slot == NULL) || (slot->job < 0))
+    {
+        TraceLog(LOG_WARNING, "LOADER: [%s] Too many queued assets, loading it now", load.fileName);
+        DecodeAssetJob(&load);
+        UploadAsset(&load);
+        return;
+    }
+    loader->loadCount++;
+}
+
+void QueueTextureAsset(GameContext *ctx, RaylibAssets *pool, Texture *dest, const char *fileName, TextureFilter filter)
+{
+    if (!IsWindowReady()) return; // no GPU context to upload to
+
+    AssetLoad load = { .type = ASSET_LOAD_TEXTURE, .pool = pool, .dest = dest, .filter = filter };
+    strncpy(load.fileName, fileName, sizeof(load.fileName) - 1);
+    QueueAssetLoad(ctx, load);
+}
+
+void QueueGameSound(GameContext *ctx, RaylibAssets *pool, GameSound *dest, const char *fileName, float volume, int maxVoices, int priority)
+{
+    *dest = (GameSound){ .volume = volume, .maxVoices = maxVoices, .priority = priority };
+    if (!IsAudioDeviceReady()) return; // playing an empty sound is a no-op
+
+    AssetLoad load = { .type = ASSET_LOAD_SOUND, .pool = pool, .dest = dest };
+    strncpy(load.fileName, fileName, sizeof(load.fileName) - 1);
+    QueueAssetLoad(ctx, load);
+}
+
+void QueueFontAsset(GameContext *ctx, RaylibAssets *pool, Font *dest, const char *fileName, int fontSize, TextureFilter filter)
+{
+    if (!IsWindowReady() || (fontSize <= 0)) return;
+
+    AssetLoad load = { .type = ASSET_LOAD_FONT, .pool = pool, .dest = dest, .fontSize = fontSize, .filter = filter };
+    strncpy(load.fileName, fileName, sizeof(load.fileName) - 1);
+    QueueAssetLoad(ctx, load);
+}
+
+static void LogAssetLoadTimes(AssetLoader *loader)
+{
+    TraceLog(LOG_INFO, "LOADER: %i assets loaded in %.1f ms (done %.1f ms after InitWindow())",
+             loader->loadCount, (loader->doneTime - loader->startTime)*1000, loader->doneTime*1000);
+}
+
+void UpdateAssetLoader(GameContext *ctx)
+{
+    AssetLoader *loader = &ctx->loader;
+
+    if (loader->loadCount == 0) return;
+
+    if (!loader->isStarted) StartJobThreads(&loader->jobs, ASSET_LOADER_THREADS);
+    if (!PLATFORM_HAS_THREADS) RunJobs(&loader->jobs, 1); // one decode per frame keeps the logo moving
+    loader->isStarted = true;
+
+    AllocScope allocScope = SetAllocScope(ctx, ALLOC_SCOPE_LEVEL); // the pools grow, like a level load
+    for (int i = 0; i < loader->loadCount; i++)
+    {
+        AssetLoad *load = &loader->loads[i];
+        if (load->isUploaded || !IsJobDone(&loader->jobs, load->job)) continue;
+
+        UploadAsset(load);
+        loader->uploadedCount++;
+    }
+    SetAllocScope(ctx, allocScope);
+
+    if (loader->uploadedCount == loader->loadCount)
+    {
+        loader->doneTime = GetTime();
+        LogAssetLoadTimes(loader);
+        ResetJobQueue(&loader->jobs); // the workers are out of jobs, join them
+        loader->loadCount = loader->uploadedCount = 0;
+        loader->isStarted = false;
+    }
+}
+
+bool IsAssetLoadDone(GameContext *ctx)
+{
+    return ctx->loader.loadCount == 0;
+}
+
+void FinishAssetLoads(GameContext *ctx)
+{
+    AssetLoader *loader = &ctx->loader;
+
+    if (loader->loadCount == 0) return;
+
+    loader->isStarted = true;
+    WaitJobs(&loader->jobs); // runs whatever the workers haven't claimed on this thread
+    UpdateAssetLoader(ctx);
+}
+
+void MarkAssetLoaderPresent(GameContext *ctx, double time)
+{
+    AssetLoader *loader = &ctx->loader;
+
+    if (loader->firstFrameTime > 0) return;
+
+    loader->firstFrameTime = time;
+    TraceLog(LOG_INFO, "LOADER: First frame presented %.1f ms after InitWindow(), %i assets still loading",
+             time*1000, loader->loadCount - loader->uploadedCount);
+}
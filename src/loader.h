@@ -0,0 +1,67 @@
+// EXPLANATION:
+// Asset loading in the background while the logo plays
+// Queued assets are decoded (file read, PNG/WAV/TTF parsing, sound format
+// conversion, font atlas packing) on worker threads from the job queue, see jobs.h. Each frame,
+// UpdateAssetLoader() uploads the ones that finished to the GPU or audio
+// device on the main thread and writes them to their destination, so the
+// first frame isn't held back by decoding. The logo screen waits at its end
+// until IsAssetLoadDone(). Startup times are logged when the loads finish.
+// Music isn't queued, it decodes while it plays, see music.h.
+
+#ifndef FROGGER_LOADER_HEADER_GUARD
+#define FROGGER_LOADER_HEADER_GUARD
+
+// Macros
+// ----------------------------------------------------------------------------
+#define ASSET_LOADER_MAX_LOADS JOB_QUEUE_MAX_JOBS
+#define ASSET_LOADER_THREADS 4
+#define ASSET_LOADER_NAME_MAX 128
+
+// Types and Structures
+// ----------------------------------------------------------------------------
+typedef enum {
+    ASSET_LOAD_TEXTURE,
+    ASSET_LOAD_SOUND,
+    ASSET_LOAD_FONT,
+} AssetLoadType;
+
+typedef struct {
+    AssetLoadType type;
+    char fileName[ASSET_LOADER_NAME_MAX];
+    RaylibAssets *pool; // the uploaded asset is added to this pool
+    void *dest;         // Texture, GameSound or Font written once uploaded
+    TextureFilter filter; // textures and fonts
+    int fontSize;       // fonts
+    int job;            // in the loader's job queue
+    bool isUploaded;
+
+    // Decoded by the job
+    Image image;
+    Wave wave;
+    DecodedFont font;
+} AssetLoad;
+
+typedef struct {
+    JobQueue jobs;
+    AssetLoad loads[ASSET_LOADER_MAX_LOADS];
+    int loadCount, uploadedCount;
+    bool isStarted; // no more jobs can join the batch
+
+    // GetTime(), seconds since InitWindow()
+    double startTime, doneTime, firstFrameTime;
+} AssetLoader;
+
+// Prototypes
+// ----------------------------------------------------------------------------
+// Queue an asset to be loaded into dest, which must stay valid until it's uploaded
+// (dest is left as is when there is no window/audio device, e.g. headless builds)
+void QueueTextureAsset(GameContext *ctx, RaylibAssets *pool, Texture *dest, const char *fileName, TextureFilter filter);
+void QueueGameSound(GameContext *ctx, RaylibAssets *pool, GameSound *dest, const char *fileName, float volume, int maxVoices, int priority);
+void QueueFontAsset(GameContext *ctx, RaylibAssets *pool, Font *dest, const char *fileName, int fontSize, TextureFilter filter);
+
+void UpdateAssetLoader(GameContext *ctx); // Start the workers, then upload the assets that finished decoding, call every frame
+bool IsAssetLoadDone(GameContext *ctx);   // Every queued asset is uploaded
+void FinishAssetLoads(GameContext *ctx);  // Decode and upload everything queued now, before touching the pools or destinations
+void MarkAssetLoaderPresent(GameContext *ctx, double time); // EndDrawing() returned, the first call is the time to first frame
+
+#endif // FROGGER_LOADER_HEADER_GUARD
@@ -2,11 +2,13 @@
 // For the raylib logo animation at start of program
 // See header for more documentation/descriptions
 
-LogoAnimationState logo = { 0 };
+#include "common.h" // all project header includes
 
-void InitRaylibLogo(void)
+void InitRaylibLogo(GameContext *ctx)
 {
-    logo = (LogoAnimationState){
+    LogoAnimationState *logo = &ctx->logo;
+
+    *logo = (LogoAnimationState){
         .positionX = VIRTUAL_WIDTH/2 - RAYLIB_LOGO_WIDTH/2,
         .positionY = VIRTUAL_HEIGHT/2 - RAYLIB_LOGO_WIDTH/2,
 
@@ -23,114 +25,121 @@ void InitRaylibLogo(void)
     };
 }
 
-void UpdateRaylibLogo(void)
+void UpdateRaylibLogo(GameContext *ctx)
 {
+    GameState *game = &ctx->game;
+    LogoAnimationState *logo = &ctx->logo;
+
     const float growSpeed = RAYLIB_LOGO_WIDTH*0.9375f; // Speed that lines grow
     const float letterDelay = 0.2f; // Time between each letter appearing
     const float fadeSpeed = 1.0f; // Fade out in 1 second
 
     // Press any key/button or touch to skip
-    if (input.anyInputPressed)
+    if (ctx->input.anyInputPressed)
     {
-        if ((logo.lettersCount < 6) && (logo.alpha >= 1.0f))
+        if ((logo->lettersCount < 6) && (logo->alpha >= 1.0f))
         {
-            logo.skipped = true;
-            logo.topSideRecWidth = RAYLIB_LOGO_WIDTH;
-            logo.leftSideRecHeight = RAYLIB_LOGO_WIDTH;
-            logo.bottomSideRecWidth = RAYLIB_LOGO_WIDTH;
-            logo.rightSideRecHeight = RAYLIB_LOGO_WIDTH;
-            logo.lettersCount = 10;
-            logo.elapsedTime = 0;
-            logo.state = LOGO_TEXT;
+            logo->skipped = true;
+            logo->topSideRecWidth = RAYLIB_LOGO_WIDTH;
+            logo->leftSideRecHeight = RAYLIB_LOGO_WIDTH;
+            logo->bottomSideRecWidth = RAYLIB_LOGO_WIDTH;
+            logo->rightSideRecHeight = RAYLIB_LOGO_WIDTH;
+            logo->lettersCount = 10;
+            logo->elapsedTime = 0;
+            logo->state = LOGO_TEXT;
         }
         else
         {
-            logo.state = LOGO_END;
-            logo.elapsedTime = 1.0f;
+            logo->state = LOGO_END;
+            logo->elapsedTime = 1.0f;
         }
     }
 
     // Support raylib!
     // https://github.com/sponsors/raysan5 https://www.patreon.com/raylib :)
-    if (logo.skipped == true && logo.elapsedTime < 1.0f)
+    if (logo->skipped == true && logo->elapsedTime < 1.0f)
     {
-        logo.elapsedTime += game.frameTime;
+        logo->elapsedTime += game->frameTime;
         return;
     }
 
-    switch (logo.state)
+    switch (logo->state)
     {
         case LOGO_START: // Small box blinking
-            logo.elapsedTime += game.frameTime;
-            if (logo.elapsedTime >= 2.0f) // 2 seconds delay
+            logo->elapsedTime += game->frameTime;
+            if (logo->elapsedTime >= 2.0f) // 2 seconds delay
             {
-                logo.state = LOGO_GROW1;
-                logo.elapsedTime = 0.0f; // Reset counter... will be used later...
+                logo->state = LOGO_GROW1;
+                logo->elapsedTime = 0.0f; // Reset counter... will be used later...
             }
             break;
 
         case LOGO_GROW1: // Top and left bars growing
-            logo.topSideRecWidth += growSpeed*game.frameTime;
-            logo.leftSideRecHeight += growSpeed*game.frameTime;
+            logo->topSideRecWidth += growSpeed*game->frameTime;
+            logo->leftSideRecHeight += growSpeed*game->frameTime;
 
-            if (logo.topSideRecWidth >= RAYLIB_LOGO_WIDTH)
+            if (logo->topSideRecWidth >= RAYLIB_LOGO_WIDTH)
             {
-                logo.topSideRecWidth = RAYLIB_LOGO_WIDTH;
-                logo.leftSideRecHeight = RAYLIB_LOGO_WIDTH;
-                logo.state = LOGO_GROW2;
-                logo.elapsedTime = 0.0f;
+                logo->topSideRecWidth = RAYLIB_LOGO_WIDTH;
+                logo->leftSideRecHeight = RAYLIB_LOGO_WIDTH;
+                logo->state = LOGO_GROW2;
+                logo->elapsedTime = 0.0f;
             }
             break;
 
         case LOGO_GROW2: // Bottom and right bars growing
-            logo.bottomSideRecWidth += growSpeed*game.frameTime;
-            logo.rightSideRecHeight += growSpeed*game.frameTime;
+            logo->bottomSideRecWidth += growSpeed*game->frameTime;
+            logo->rightSideRecHeight += growSpeed*game->frameTime;
 
-            if (logo.bottomSideRecWidth >= RAYLIB_LOGO_WIDTH)
+            if (logo->bottomSideRecWidth >= RAYLIB_LOGO_WIDTH)
             {
-                logo.bottomSideRecWidth = RAYLIB_LOGO_WIDTH;
-                logo.rightSideRecHeight = RAYLIB_LOGO_WIDTH;
-                logo.state = LOGO_TEXT;
-                logo.elapsedTime = 0.0f;
+                logo->bottomSideRecWidth = RAYLIB_LOGO_WIDTH;
+                logo->rightSideRecHeight = RAYLIB_LOGO_WIDTH;
+                logo->state = LOGO_TEXT;
+                logo->elapsedTime = 0.0f;
             }
             break;
 
         case LOGO_TEXT: // Letters appearing (one by one)
-            logo.elapsedTime += game.frameTime;
+            logo->elapsedTime += game->frameTime;
 
-            if (logo.lettersCount < 10 && logo.elapsedTime >= letterDelay)
+            if (logo->lettersCount < 10 && logo->elapsedTime >= letterDelay)
             {
-                logo.lettersCount++;
-                logo.elapsedTime = 0.0f;
+                logo->lettersCount++;
+                logo->elapsedTime = 0.0f;
             }
 
             // When all letters have appeared, just fade out everything
-            if (logo.lettersCount >= 10)
+            if (logo->lettersCount >= 10)
             {
-                logo.alpha -= fadeSpeed*game.frameTime;
-                if (logo.alpha < EPSILON)
+                logo->alpha -= fadeSpeed*game->frameTime;
+                if (logo->alpha < EPSILON)
                 {
-                    logo.alpha = 0.0f;
-                    logo.state = LOGO_PAUSE;
-                    logo.elapsedTime = 0.0f;
+                    logo->alpha = 0.0f;
+                    logo->state = LOGO_PAUSE;
+                    logo->elapsedTime = 0.0f;
                 }
             }
             break;
 
         case LOGO_PAUSE: // Pause at end of animation
-            logo.elapsedTime += game.frameTime;
-            if (logo.elapsedTime >= 1.5f)
-                logo.state = LOGO_END;
+            logo->elapsedTime += game->frameTime;
+            if (logo->elapsedTime >= 1.5f)
+                logo->state = LOGO_END;
             break;
 
-        case LOGO_END: // Animation is finished
-            game.currentScreen++;
+        case LOGO_END: // Animation is finished, wait for the assets loading behind it
+            if (!IsAssetLoadDone(ctx)) break;
+            LayoutUiHud(ctx); // measured with the loaded game font
+            game->currentScreen++;
             break;
     }
 }
 
-void DrawRaylibLogo(void)
+void DrawRaylibLogo(GameContext *ctx)
 {
+    LogoAnimationState *logo = &ctx->logo;
+
     int lineWidth = (int)(RAYLIB_LOGO_OUTLINE); // DrawRectangle() takes ints, so all this casting is just to remove warnings
     int offsetA   = (int)(RAYLIB_LOGO_WIDTH*0.9375f);
     int offsetB   = (int)(lineWidth*2);
@@ -138,27 +147,27 @@ void DrawRaylibLogo(void)
     int offsetD   = (int)(RAYLIB_LOGO_WIDTH*0.1875f);
     int fontSize  = (int)(RAYLIB_LOGO_FONT_SIZE);
 
-    int rectPosX    = (int)logo.positionX;
-    int rectPosY    = (int)logo.positionY;
-    int topWidth    = (int)logo.topSideRecWidth;
-    int leftHeight  = (int)logo.leftSideRecHeight;
-    int rightHeight = (int)logo.rightSideRecHeight;
-    int bottomWidth = (int)logo.bottomSideRecWidth;
+    int rectPosX    = (int)logo->positionX;
+    int rectPosY    = (int)logo->positionY;
+    int topWidth    = (int)logo->topSideRecWidth;
+    int leftHeight  = (int)logo->leftSideRecHeight;
+    int rightHeight = (int)logo->rightSideRecHeight;
+    int bottomWidth = (int)logo->bottomSideRecWidth;
 
-    Color logoColor = Fade(RAYLIB_LOGO_COLOR, logo.alpha);
+    Color logoColor = Fade(RAYLIB_LOGO_COLOR, logo->alpha);
 
     ClearBackground(RAYLIB_LOGO_BACKGROUND);
 
-    if (logo.state < LOGO_PAUSE)
+    if (logo->state < LOGO_PAUSE)
         DrawText("powered by",
                  (int)((VIRTUAL_WIDTH/2) - (RAYLIB_LOGO_WIDTH/2)),
                  (int)((VIRTUAL_HEIGHT/2) - (RAYLIB_LOGO_WIDTH/2) - offsetB - lineWidth/4),
                  (int)(fontSize/2), logoColor);
 
-    switch (logo.state)
+    switch (logo->state)
     {
         case LOGO_START:
-            if (((int)(logo.elapsedTime*4)) % 2)
+            if (((int)(logo->elapsedTime*4)) % 2)
                 DrawRectangle(rectPosX, rectPosY, lineWidth, lineWidth, logoColor);
             else
                 DrawRectangle(rectPosX, rectPosY, lineWidth, lineWidth, RAYLIB_LOGO_BACKGROUND);
@@ -181,7 +190,7 @@ void DrawRaylibLogo(void)
             DrawRectangle(rectPosX + offsetA, rectPosY + lineWidth, lineWidth, rightHeight - offsetB, logoColor);
             DrawRectangle(rectPosX, rectPosY + offsetA, bottomWidth, lineWidth, logoColor);
 
-            DrawText(TextSubtext("raylib", 0, logo.lettersCount),
+            DrawText(TextSubtext("raylib", 0, logo->lettersCount),
                      VIRTUAL_WIDTH/2 - offsetC, VIRTUAL_HEIGHT/2 + offsetD, fontSize, logoColor);
 
             break;
@@ -40,10 +40,10 @@ typedef struct {
 
 // Prototypes
 // ----------------------------------------------------------------------------
-void InitRaylibLogo(void);   // Initialize the logo animation
-void UpdateRaylibLogo(void); // Update logo animation for the current frame
-                             // Also transitions to title screen when finished
-void DrawRaylibLogo(void);
+void InitRaylibLogo(GameContext *ctx);   // Initialize the logo animation
+void UpdateRaylibLogo(GameContext *ctx); // Update logo animation for the current frame
+                                         // Also transitions to title screen when finished and the assets are loaded
+void DrawRaylibLogo(GameContext *ctx);
 
 #endif // FROGGER_LOGO_HEADER_GUARD
 
@@ -2,43 +2,21 @@
 // The main entry point for the game/program
 // See header files for overall layout and explanations
 
-#define uint unsigned int
-
 #include "common.h" // all project header includes
 
-// Platform layer
-#if defined(PLATFORM_WEB)
-    #include "platform_web.c"
-#elif defined(PLATFORM_DESKTOP)
-    #include "platform_desktop.c"
-#endif
-
-#include "rl_utils.c" // raylib convenience
-
-// Modules
-#include "render.c"
-#include "input.c"
-#include "logo.c"
-#include "ui_callbacks.c"
-#include "ui.c"
-
-// Game code
-#include "frogger.c"
-
-// Globals
-GameState  game;
-InputState input;
-UiState    ui;
-RenderData viewport;
+#define uint unsigned int // after system headers, glibc already typedefs uint
 
 // Local Functions Declaration
-void UpdateDrawFrame(void); // main game loop
+void UpdateDrawFrame(GameContext *ctx); // main game loop
 
 // Main entry point
 int main(void)
 {
     // Initialization
     // ----------------------------------------------------------------------------
+    static GameContext context = { 0 }; // all game state, too big for the stack
+    GameContext *ctx = &context;
+    BindAllocTracker(ctx);
 
     // New window
     uint windowFlags = FLAG_MSAA_4X_HINT;
@@ -47,12 +25,17 @@ int main(void)
     InitWindow(INITIAL_WIDTH, INITIAL_HEIGHT, WINDOW_TITLE);
     SetWindowMinSize(320, 240);
     InitAudioDevice();
-
-    InitViewport();
-    InitRaylibLogo();
-    InitUiState();
-    InitGameState();
-    InitDefaultInputSettings();
+    MountAssetArchive(ASSET_ARCHIVE_FILE);
+    InitAudioMixer(ctx);
+
+    InitViewport(ctx);
+    InitRaylibLogo(ctx);
+    InitUiState(ctx);
+    InitGameState(ctx);
+    InitDefaultInputSettings(ctx);
+    InitFramePacer(ctx);
+    InitLaneStrips(ctx);
+    PlatformHookInputEvents(ctx);
 
     // Debug exit:
     // SetExitKey(KEY_NULL);
@@ -60,71 +43,95 @@ int main(void)
     SetMasterVolume(0.15f);
 
     // Start game loop
-    PlatformRunGameLoop(UpdateDrawFrame);
+    PlatformRunGameLoop(UpdateDrawFrame, ctx);
 
     // De-Initialization
     // ----------------------------------------------------------------------------
-    FreeGameState();
-    FreeUiState();
+    PrintLatencyReport(ctx);
+    PrintFrameArenaReport(ctx);
+    PrintAllocReport(ctx);
+    FreeFrameArena(ctx);
+    CloseAudioMixer(ctx);
+    FreeGameState(ctx);
+    FreeUiState(ctx);
     CloseAudioDevice();
-    UnloadShader(viewport.shader);
-    UnloadRenderTexture(viewport.renderTarget);
+    UnloadShader(ctx->viewport.shader);
+    UnloadRenderTexture(ctx->viewport.renderTarget);
+    UnmountAssetArchive(); // after the assets, music streams from it
     CloseWindow(); // close window and OpenGL context
 
     return 0;
 }
 
 // Update game data and draw elements to the screen for the current frame
-void UpdateDrawFrame(void)
+void UpdateDrawFrame(GameContext *ctx)
 {
+    GameState *game = &ctx->game;
+    InputState *input = &ctx->input;
+    RenderData *viewport = &ctx->viewport;
+
     // Update
     // ----------------------------------------------------------------------------
 
-    UpdateInputFrame();
+    ResetFrameArena(ctx); // last frame's scratch memory is gone from here on
+    UpdateAssetLoader(ctx); // upload the assets decoded since last frame
+    SetAllocScope(ctx, ALLOC_SCOPE_INPUT);
+    UpdateInputFrame(ctx);
+    SetAllocScope(ctx, ALLOC_SCOPE_UPDATE);
 
     // Global input checks
-    if (input.global.fullscreen)
+    if (input->global.fullscreen)
     {
         // Borderless Windowed is generally nicer to use on desktop
         ToggleBorderlessWindowed();
-        CancelInputActions(); // clear input until a new press
+        CancelInputActions(ctx); // clear input until a new press
     }
 
     // Debug:
     if (IsKeyDown(KEY_LEFT_SHIFT) && IsKeyPressed(KEY_S))
     {
-        viewport.shaderEnabled = !viewport.shaderEnabled;
-        CancelInputActions();
+        viewport->shaderEnabled = !viewport->shaderEnabled;
+        CancelInputActions(ctx);
     }
 
+    // Report input latency and try the next vsync/framerate setting
+    if (game->isDebugMode && IsKeyPressed(KEY_F4))
+        CycleLatencyPacing(ctx);
+
+    if (game->isDebugMode && IsKeyPressed(KEY_F5))
+        ToggleFramePacer(ctx);
+
+    if (game->isDebugMode && IsKeyPressed(KEY_F6))
+        ToggleLaneStrips(ctx);
+
     if (IsKeyPressed(KEY_LEFT_BRACKET))
     {
-        game.camera.zoom -= 0.01f;
+        game->camera.zoom -= 0.01f;
     }
 
     if (IsKeyPressed(KEY_RIGHT_BRACKET))
     {
-        game.camera.zoom += 0.01f;
+        game->camera.zoom += 0.01f;
     }
 
     // Global updates
-    game.isFullscreen = (IsWindowFullscreen() ||
+    game->isFullscreen = (IsWindowFullscreen() ||
                        IsWindowState(FLAG_BORDERLESS_WINDOWED_MODE));
-    game.frameTime = GetFrameTime();
-    game.frameCount++;
+    game->frameTime = GetFrameTime();
+    game->frameCount++;
 
     // Update window data for proper aspect ratio, cameras, and shaders
-    UpdateWindowRenderFrame();
-    UpdateWindowShader();
+    UpdateWindowRenderFrame(ctx);
+    UpdateWindowShader(ctx);
 
     // Update for current screen
-    switch(game.currentScreen)
+    switch(game->currentScreen)
     {
-        case SCREEN_LOGO:     UpdateRaylibLogo();
+        case SCREEN_LOGO:     UpdateRaylibLogo(ctx);
                               break;
-        case SCREEN_TITLE:    UpdateUiFrame();
+        case SCREEN_TITLE:    UpdateUiFrame(ctx);
                               break;
-        case SCREEN_GAMEPLAY: UpdateGameFrame();
+        case SCREEN_GAMEPLAY: UpdateGameFrame(ctx);
                               break;
         default: break;
     }
@@ -132,45 +139,60 @@ void UpdateDrawFrame(void)
     // Draw
     // ----------------------------------------------------------------------------
 
+    SetAllocScope(ctx, ALLOC_SCOPE_DRAW);
+
+    // Redraw the cached UI layer if the HUD or menus changed (can't be nested in texture mode)
+    if (game->currentScreen != SCREEN_LOGO) UpdateUiLayer(ctx);
+
+    // Bake the level's moving lanes (same, can't be nested)
+    if (game->currentScreen == SCREEN_GAMEPLAY) UpdateLaneStrips(ctx);
+
     // Draw to render texture
-    BeginTextureMode(viewport.renderTarget);
-        BeginMode2D(game.camera);
+    BeginTextureMode(viewport->renderTarget);
+        BeginMode2D(game->camera);
 
-            switch(game.currentScreen)
+            switch(game->currentScreen)
             {
-                case SCREEN_LOGO:     DrawRaylibLogo();
+                case SCREEN_LOGO:     DrawRaylibLogo(ctx);
                                       break;
                 case SCREEN_TITLE:    ClearBackground(BG_COLOR);
-                                      DrawUiFrame();
+                                      DrawUiFrame(ctx);
                                       break;
-                case SCREEN_GAMEPLAY: DrawGameFrame();
-                                      DrawUiFrame();
+                case SCREEN_GAMEPLAY: DrawGameFrame(ctx);
+                                      DrawUiFrame(ctx);
                                       break;
                 default: break;
             }
 
         EndMode2D();
-    EndTextureMode();
+    EndTextureMode(); // submits the game frame's draw batch
+    MarkLatencyStage(ctx, LATENCY_STAGE_DRAW, GetTime());
 
     // Draw render texture
     BeginDrawing();
         ClearBackground(BLACK);
         // Draw full-screen shader effect
-        if (viewport.shaderEnabled) BeginShaderMode(viewport.shader);
+        if (viewport->shaderEnabled) BeginShaderMode(viewport->shader);
 
-            DrawTexturePro(viewport.renderTarget.texture,
+            DrawTexturePro(viewport->renderTarget.texture,
                            (Rectangle){ 0, 0,
-                           (float)viewport.renderTarget.texture.width,
-                           (float)-viewport.renderTarget.texture.height },
-                           (Rectangle){ viewport.x, viewport.y,
-                           viewport.width, viewport.height },
+                           (float)viewport->renderTarget.texture.width,
+                           (float)-viewport->renderTarget.texture.height },
+                           (Rectangle){ viewport->x, viewport->y,
+                           viewport->width, viewport->height },
                            Vector2Zero(), 0, WHITE);
 
-        if (viewport.shaderEnabled) EndShaderMode();
+        if (viewport->shaderEnabled) EndShaderMode();
 
         // Draw touch screen gamepad on screen edges
-        DrawUiGamepad();
+        DrawUiGamepad(ctx);
+
+    MarkFramePacerWorkDone(ctx, GetTime());
+    EndDrawing(); // swaps buffers, waits for the target framerate, then polls input
+    MarkLatencyStage(ctx, LATENCY_STAGE_PRESENT, GetTime());
+    MarkAssetLoaderPresent(ctx, GetTime());
 
-    EndDrawing();
+    SetAllocScope(ctx, ALLOC_SCOPE_OTHER);
+    EndAllocFrame(ctx);
 }
 
@@ -0,0 +1,248 @@
+// EXPLANATION:
+// Streaming music from QOA files, with a gapless intro before the loop
+// See header for more documentation/descriptions
+
+#include "common.h" // all project header includes
+
+#include <string.h> // memcmp, memcpy
+
+// QOA decoder
+// ----------------------------------------------------------------------------
+#define QOA_FILE_HEADER_SIZE 8
+#define QOA_FRAME_HEADER_SIZE 8
+#define QOA_LMS_SIZE 16 // per channel
+
+// Residual for each scale factor and quantized value, the same table the
+// reference decoder computes: round(scaleFactor*{0.75, -0.75, 2.5, -2.5, 4.5, -4.5, 7, -7})
+static const int qoaDequantTable[16][8] = {
+    {    1,    -1,    3,    -3,    5,    -5,     7,     -7 },
+    {    5,    -5,   18,   -18,   32,   -32,    49,    -49 },
+    {   16,   -16,   53,   -53,   95,   -95,   147,   -147 },
+    {   34,   -34,  113,  -113,  203,  -203,   315,   -315 },
+    {   63,   -63,  210,  -210,  378,  -378,   588,   -588 },
+    {  104,  -104,  345,  -345,  621,  -621,   966,   -966 },
+    {  158,  -158,  528,  -528,  950,  -950,  1477,  -1477 },
+    {  228,  -228,  760,  -760, 1368, -1368,  2128,  -2128 },
+    {  316,  -316, 1053, -1053, 1895, -1895,  2947,  -2947 },
+    {  422,  -422, 1405, -1405, 2529, -2529,  3934,  -3934 },
+    {  548,  -548, 1828, -1828, 3290, -3290,  5117,  -5117 },
+    {  696,  -696, 2320, -2320, 4176, -4176,  6496,  -6496 },
+    {  868,  -868, 2893, -2893, 5207, -5207,  8099,  -8099 },
+    { 1064, -1064, 3548, -3548, 6386, -6386,  9933,  -9933 },
+    { 1286, -1286, 4288, -4288, 7718, -7718, 12005, -12005 },
+    { 1536, -1536, 5120, -5120, 9216, -9216, 14336, -14336 },
+};
+
+typedef struct {
+    int history[QOA_LMS_LEN];
+    int weights[QOA_LMS_LEN];
+} QoaLms;
+
+static unsigned long long ReadQoaU64(const unsigned char *bytes)
+{
+    unsigned long long value = 0;
+    for (int i = 0; i < 8; i++) value = (value << 8) | bytes[i];
+    return value;
+}
+
+static int PredictQoaLms(QoaLms *lms)
+{
+    int prediction = 0;
+    for (int i = 0; i < QOA_LMS_LEN; i++) prediction += lms->weights[i]*lms->history[i];
+    return prediction >> 13;
+}
+
+static void UpdateQoaLms(QoaLms *lms, int sample, int residual)
+{
+    int delta = residual >> 4;
+    for (int i = 0; i < QOA_LMS_LEN; i++) lms->weights[i] += (lms->history[i] < 0)? -delta : delta;
+    for (int i = 0; i < QOA_LMS_LEN - 1; i++) lms->history[i] = lms->history[i + 1];
+    lms->history[QOA_LMS_LEN - 1] = sample;
+}
+
+// Decode the QOA frame at the decoder's offset into its samples, false at the end or on bad data
+static bool DecodeQoaFrame(QoaDecoder *qoa)
+{
+    const unsigned char *bytes = qoa->data + qoa->offset;
+    int remaining = qoa->size - qoa->offset;
+    if (remaining < QOA_FRAME_HEADER_SIZE) return false;
+
+    unsigned long long header = ReadQoaU64(bytes);
+    int channels = (int)(header >> 56);
+    int sampleCount = (int)((header >> 16) & 0xffff);
+    int frameSize = (int)(header & 0xffff);
+    int sliceCount = (sampleCount + QOA_SLICE_LEN - 1)/QOA_SLICE_LEN;
+    if ((channels != qoa->channels) || (sampleCount == 0) || (sampleCount > QOA_FRAME_LEN) ||
+        (frameSize != QOA_FRAME_HEADER_SIZE + channels*(QOA_LMS_SIZE + sliceCount*8)) || (frameSize > remaining))
+        return false;
+
+    QoaLms lms[MUSIC_MAX_CHANNELS];
+    const unsigned char *p = bytes + QOA_FRAME_HEADER_SIZE;
+    for (int c = 0; c < channels; c++)
+    {
+        unsigned long long history = ReadQoaU64(p);
+        unsigned long long weights = ReadQoaU64(p + 8);
+        p += QOA_LMS_SIZE;
+        for (int i = 0; i < QOA_LMS_LEN; i++)
+        {
+            lms[c].history[i] = (short)(history >> 48);
+            lms[c].weights[i] = (short)(weights >> 48);
+            history <<= 16;
+            weights <<= 16;
+        }
+    }
+
+    for (int sliceStart = 0; sliceStart < sampleCount; sliceStart += QOA_SLICE_LEN)
+    {
+        int sliceEnd = (sliceStart + QOA_SLICE_LEN < sampleCount)? sliceStart + QOA_SLICE_LEN : sampleCount;
+        for (int c = 0; c < channels; c++)
+        {
+            unsigned long long slice = ReadQoaU64(p);
+            p += 8;
+            const int *dequant = qoaDequantTable[slice >> 60];
+            for (int i = sliceStart; i < sliceEnd; i++)
+            {
+                int residual = dequant[(slice >> 57) & 7];
+                int sample = PredictQoaLms(&lms[c]) + residual;
+                sample = (sample < -32768)? -32768 : (sample > 32767)? 32767 : sample;
+                slice <<= 3;
+
+                qoa->samples[i*channels + c] = (short)sample;
+                UpdateQoaLms(&lms[c], sample, residual);
+            }
+        }
+    }
+
+    qoa->offset += frameSize;
+    qoa->sampleCount = sampleCount;
+    qoa->sampleIdx = 0;
+    return true;
+}
+
+bool OpenQoaDecoder(QoaDecoder *qoa, const char *fileName)
+{
+    *qoa = (QoaDecoder){ 0 };
+
+    int size = 0;
+    const unsigned char *data = GetAssetArchiveEntry(fileName, &size);
+    if (data == NULL) data = qoa->ownedData = LoadFileData(fileName, &size);
+    if (data == NULL) return false;
+    qoa->data = data;
+    qoa->size = size;
+
+    // The format is read from the first frame, every frame has to match it
+    if ((size >= QOA_FILE_HEADER_SIZE + QOA_FRAME_HEADER_SIZE) && !memcmp(data, "qoaf", 4))
+    {
+        unsigned long long frameHeader = ReadQoaU64(data + QOA_FILE_HEADER_SIZE);
+        qoa->frameCount = (unsigned int)(ReadQoaU64(data) & 0xffffffff);
+        qoa->channels = (int)(frameHeader >> 56);
+        qoa->sampleRate = (int)((frameHeader >> 32) & 0xffffff);
+    }
+    if ((qoa->frameCount == 0) || (qoa->channels < 1) || (qoa->channels > MUSIC_MAX_CHANNELS) || (qoa->sampleRate == 0))
+    {
+        TraceLog(LOG_WARNING, "MUSIC: [%s] Not a QOA file, or not %i channels at most", fileName, MUSIC_MAX_CHANNELS);
+        CloseQoaDecoder(qoa);
+        return false;
+    }
+
+    qoa->offset = QOA_FILE_HEADER_SIZE;
+    return true;
+}
+
+int ReadQoaDecoder(QoaDecoder *qoa, short *samples, int frameCount)
+{
+    int readCount = 0;
+    while (readCount < frameCount)
+    {
+        if ((qoa->sampleIdx >= qoa->sampleCount) && !DecodeQoaFrame(qoa)) break;
+
+        int count = qoa->sampleCount - qoa->sampleIdx;
+        if (count > frameCount - readCount) count = frameCount - readCount;
+        memcpy(samples + readCount*qoa->channels, qoa->samples + qoa->sampleIdx*qoa->channels,
+               count*qoa->channels*sizeof(short));
+        qoa->sampleIdx += count;
+        readCount += count;
+    }
+    return readCount;
+}
+
+void RewindQoaDecoder(QoaDecoder *qoa)
+{
+    qoa->offset = QOA_FILE_HEADER_SIZE;
+    qoa->sampleCount = qoa->sampleIdx = 0;
+}
+
+void CloseQoaDecoder(QoaDecoder *qoa)
+{
+    UnloadFileData(qoa->ownedData);
+    *qoa = (QoaDecoder){ 0 };
+}
+
+// Game music
+// ----------------------------------------------------------------------------
+bool LoadGameMusic(GameMusic *music, const char *introFileName, float introVolume, const char *loopFileName, float loopVolume)
+{
+    *music = (GameMusic){ .introVolume = introVolume, .loopVolume = loopVolume };
+    if (!IsAudioDeviceReady()) return false;
+
+    QoaDecoder *intro = &music->intro, *loop = &music->loop;
+    if (!OpenQoaDecoder(intro, introFileName) || !OpenQoaDecoder(loop, loopFileName) ||
+        (intro->channels != loop->channels) || (intro->sampleRate != AUDIO_SAMPLE_RATE) || (loop->sampleRate != AUDIO_SAMPLE_RATE))
+    {
+        TraceLog(LOG_WARNING, "MUSIC: [%s] [%s] Couldn't load, or not matching %i Hz files", introFileName, loopFileName, AUDIO_SAMPLE_RATE);
+        UnloadGameMusic(music);
+        return false;
+    }
+    music->isLoaded = true;
+
+    music->compressedBytes = intro->size + loop->size;
+    music->pcmBytes = (int)((intro->frameCount + loop->frameCount)*loop->channels*sizeof(short));
+    TraceLog(LOG_INFO, "MUSIC: %i KB of QOA for %i KB of 16-bit audio (%.1fx smaller), %.1f s intro, %.1f s loop",
+             music->compressedBytes/1024, music->pcmBytes/1024, (float)music->pcmBytes/music->compressedBytes,
+             (float)intro->frameCount/intro->sampleRate, (float)loop->frameCount/loop->sampleRate);
+    return true;
+}
+
+void RewindGameMusic(GameMusic *music)
+{
+    RewindQoaDecoder(&music->intro);
+    RewindQoaDecoder(&music->loop);
+    music->isInLoop = false;
+}
+
+// Goes from the end of the intro or loop straight to the start of the loop
+void MixGameMusic(GameMusic *music, float *mix, int frameCount)
+{
+    if (!music->isLoaded) return;
+
+    int channels = music->loop.channels;
+    while (frameCount > 0)
+    {
+        QoaDecoder *section = music->isInLoop? &music->loop : &music->intro;
+        float volume = (music->isInLoop? music->loopVolume : music->introVolume)/channels;
+
+        int count = ReadQoaDecoder(section, music->buffer, (frameCount < MUSIC_MIX_FRAMES)? frameCount : MUSIC_MIX_FRAMES);
+        for (int i = 0; i < count; i++)
+        {
+            int sample = 0;
+            for (int c = 0; c < channels; c++) sample += music->buffer[i*channels + c];
+            mix[i] += sample*volume;
+        }
+        mix += count;
+        frameCount -= count;
+
+        if (count == 0)
+        {
+            if (music->isInLoop && (section->offset == QOA_FILE_HEADER_SIZE)) return; // bad loop data, don't spin on it
+            music->isInLoop = true;
+            RewindQoaDecoder(&music->loop);
+        }
+    }
+}
+
+void UnloadGameMusic(GameMusic *music)
+{
+    CloseQoaDecoder(&music->intro);
+    CloseQoaDecoder(&music->loop);
+    music->isLoaded = false;
+}
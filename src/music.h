@@ -0,0 +1,70 @@
+// EXPLANATION:
+// Streaming music from QOA files, with a gapless intro before the loop
+// QOA ("Quite OK Audio") stores 16-bit audio in ~3.2 bits per sample, so the
+// music is about a fifth of its WAV size on disk and in the web download.
+// Only the compressed files are kept in memory (mapped from the asset archive
+// when mounted). The audio mixer (audio.h) decodes as it plays, on the audio
+// thread, and the intro's last sample is followed by the loop's first in the
+// same mix, so there is no gap or polling for the end.
+//
+// QOA layout (big endian, see https://qoaformat.org):
+// file header: "qoaf", u32 samples per channel
+// frames: u8 channels, u24 sample rate, u16 samples per channel, u16 frame size
+//         per channel 4 x s16 LMS history and 4 x s16 LMS weights
+//         slices of 64 bits, interleaved per channel: 4 bit scale factor,
+//         20 x 3 bit quantized residuals
+
+#ifndef FROGGER_MUSIC_HEADER_GUARD
+#define FROGGER_MUSIC_HEADER_GUARD
+
+// Macros
+// ----------------------------------------------------------------------------
+#define QOA_SLICE_LEN 20
+#define QOA_SLICES_PER_FRAME 256
+#define QOA_FRAME_LEN (QOA_SLICE_LEN*QOA_SLICES_PER_FRAME)
+#define QOA_LMS_LEN 4
+
+#define MUSIC_MAX_CHANNELS 2 // mixed down to mono
+#define MUSIC_MIX_FRAMES 512   // decoded per step while mixing
+
+// Types and Structures
+// ----------------------------------------------------------------------------
+typedef struct {
+    const unsigned char *data; // whole QOA file
+    int size;
+    unsigned char *ownedData;  // loaded loose file, NULL when data is in the asset archive
+
+    int channels, sampleRate;
+    unsigned int frameCount; // samples per channel in the file
+    int offset;              // bytes, next QOA frame to decode
+
+    // Current QOA frame, decoded and interleaved
+    short samples[QOA_FRAME_LEN*MUSIC_MAX_CHANNELS];
+    int sampleCount, sampleIdx; // per channel
+} QoaDecoder;
+
+typedef struct {
+    bool isLoaded;
+    QoaDecoder intro, loop;
+    float introVolume, loopVolume;
+    bool isInLoop; // the intro has played
+    short buffer[MUSIC_MIX_FRAMES*MUSIC_MAX_CHANNELS];
+
+    int compressedBytes, pcmBytes; // startup bytes, and what they'd be as WAV
+} GameMusic;
+
+// Prototypes
+// ----------------------------------------------------------------------------
+bool OpenQoaDecoder(QoaDecoder *qoa, const char *fileName); // From the mounted asset archive or a loose file
+int ReadQoaDecoder(QoaDecoder *qoa, short *samples, int frameCount); // Decode up to frameCount frames, returns fewer at the end
+void RewindQoaDecoder(QoaDecoder *qoa);
+void CloseQoaDecoder(QoaDecoder *qoa);
+
+// Music is left unloaded when there is no audio device, e.g. headless builds
+// (played with PlayGameMusic(), see audio.h)
+bool LoadGameMusic(GameMusic *music, const char *introFileName, float introVolume, const char *loopFileName, float loopVolume);
+void RewindGameMusic(GameMusic *music); // Back to the start of the intro
+void MixGameMusic(GameMusic *music, float *mix, int frameCount); // Decode and add frameCount mono frames to mix
+void UnloadGameMusic(GameMusic *music);
+
+#endif // FROGGER_MUSIC_HEADER_GUARD
@@ -0,0 +1,84 @@
+// EXPLANATION:
+// Just-in-time frame pacing with late-latched input
+// See header for more documentation/descriptions
+
+#include "common.h" // all project header includes
+
+void InitFramePacer(GameContext *ctx)
+{
+    FramePacer *pacer = &ctx->pacer;
+
+    *pacer = (FramePacer){
+        .enabled = LATE_LATCH_INPUT && PLATFORM_HAS_FRAME_PACING,
+        .margin = FRAME_PACER_MIN_MARGIN,
+    };
+}
+
+void ToggleFramePacer(GameContext *ctx)
+{
+    FramePacer *pacer = &ctx->pacer;
+
+    if (!PLATFORM_HAS_FRAME_PACING) return;
+
+    PrintLatencyReport(ctx);
+    ResetLatencyTracker(ctx);
+
+    bool enabled = !pacer->enabled;
+    InitFramePacer(ctx);
+    pacer->enabled = enabled;
+}
+
+double GetFramePacerSleep(GameContext *ctx, double vsyncPeriod, double time)
+{
+    FramePacer *pacer = &ctx->pacer;
+
+    pacer->vsyncPeriod = vsyncPeriod;
+    pacer->sleepTime = 0;
+    if (!pacer->enabled || (vsyncPeriod <= 0) || (pacer->presentTime <= 0)) return 0;
+
+    // The last present was at a vblank, aim to finish just before the next one
+    double deadline = pacer->presentTime + vsyncPeriod;
+    double sleep = deadline - pacer->predictedWork - pacer->margin - time;
+    if (sleep < FRAME_PACER_MIN_SLEEP) return 0;
+
+    pacer->sleepTime = (float)sleep;
+    return sleep;
+}
+
+void MarkFramePacerWorkStart(GameContext *ctx, double time)
+{
+    ctx->pacer.workStart = time;
+}
+
+void MarkFramePacerWorkDone(GameContext *ctx, double time)
+{
+    FramePacer *pacer = &ctx->pacer;
+
+    if (pacer->workStart <= 0) return;
+
+    pacer->workTimes[pacer->workIdx] = (float)(time - pacer->workStart);
+    pacer->workIdx = (pacer->workIdx + 1) % FRAME_PACER_HISTORY;
+
+    pacer->predictedWork = 0;
+    for (int i = 0; i < FRAME_PACER_HISTORY; i++)
+        if (pacer->workTimes[i] > pacer->predictedWork) pacer->predictedWork = pacer->workTimes[i];
+}
+
+void MarkFramePacerPresent(GameContext *ctx, double time)
+{
+    FramePacer *pacer = &ctx->pacer;
+
+    // A present more than a period and a half later skipped a vblank,
+    // leave more room next time, otherwise slowly take the room back
+    if (pacer->enabled && (pacer->vsyncPeriod > 0) && (pacer->presentTime > 0))
+    {
+        if (time - pacer->presentTime > pacer->vsyncPeriod*1.5)
+        {
+            pacer->missedCount++;
+            pacer->margin = fminf(pacer->margin + FRAME_PACER_MISS_MARGIN, (float)pacer->vsyncPeriod/2);
+        }
+        else pacer->margin = fmaxf(pacer->margin*0.995f, FRAME_PACER_MIN_MARGIN);
+    }
+
+    pacer->presentTime = time;
+}
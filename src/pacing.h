@@ -0,0 +1,45 @@
+// EXPLANATION:
+// Just-in-time frame pacing with late-latched input
+// With vsync, EndDrawing() returns right after a vblank, and raylib polls
+// input there. The frame is then updated, drawn and held until the next
+// vblank, so input is most of a frame old when it's shown. The pacer
+// predicts how long update+draw takes from recent frames and sleeps first,
+// then the platform layer polls input again, so the frame finishes just
+// before the vblank. It only acts while vsync paces the game.
+
+#ifndef FROGGER_PACING_HEADER_GUARD
+#define FROGGER_PACING_HEADER_GUARD
+
+// Macros
+// ----------------------------------------------------------------------------
+#define FRAME_PACER_HISTORY 32          // frames of work time, the slowest is the prediction
+#define FRAME_PACER_MIN_MARGIN 0.0015f  // seconds to spare before the vblank
+#define FRAME_PACER_MISS_MARGIN 0.001f  // extra margin after each missed vblank
+#define FRAME_PACER_MIN_SLEEP 0.0005    // shorter sleeps aren't worth it
+
+// Types and Structures
+// ----------------------------------------------------------------------------
+typedef struct {
+    bool enabled;
+
+    double vsyncPeriod;  // 0 while vsync isn't pacing frames
+    double workStart, presentTime;
+    float workTimes[FRAME_PACER_HISTORY]; // seconds, ring buffer
+    int workIdx;
+
+    float predictedWork; // seconds, slowest recent frame
+    float margin;        // seconds, grows after a missed vblank and shrinks back
+    float sleepTime;     // last frame's sleep before input
+    int missedCount;     // vblanks missed since enabled
+} FramePacer;
+
+// Prototypes
+// ----------------------------------------------------------------------------
+void InitFramePacer(GameContext *ctx);
+void ToggleFramePacer(GameContext *ctx); // Report latency so far and switch late latching on/off
+double GetFramePacerSleep(GameContext *ctx, double vsyncPeriod, double time); // How long to wait before polling input, 0 = start the frame now
+void MarkFramePacerWorkStart(GameContext *ctx, double time); // Input was polled, update+draw start
+void MarkFramePacerWorkDone(GameContext *ctx, double time);  // Update+draw finished, call before EndDrawing()
+void MarkFramePacerPresent(GameContext *ctx, double time);   // EndDrawing() returned
+
+#endif // FROGGER_PACING_HEADER_GUARD
@@ -0,0 +1,65 @@
+// EXPLANATION:
+// Asset packer, builds the archive the game loads its assets from
+// Reads each file and writes them all into one archive with an index,
+// see archive.h for the layout. Built and run by `make pack`.
+//
+// Usage: frogger_pack <archive> <files...>
+// Files are stored under the path given, which is the path the game loads
+// them by (e.g. assets/audio/frog_hop.wav).
+
+#include "common.h" // all project header includes
+
+#include <stdio.h>
+
+// Main entry point
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "usage: %s <archive> <files...>\n", argv[0]);
+        return 1;
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+
+    int count = argc - 2;
+    const char **fileNames = (const char **)&argv[2];
+    const unsigned char **fileData = MemAlloc(count*sizeof(fileData[0]));
+    int *fileSizes = MemAlloc(count*sizeof(fileSizes[0]));
+    int status = 0;
+
+    for (int i = 0; (i < count) && (status == 0); i++)
+    {
+        fileData[i] = LoadFileData(fileNames[i], &fileSizes[i]);
+        if (fileData[i] == NULL)
+        {
+            fprintf(stderr, "failed to read %s\n", fileNames[i]);
+            status = 1;
+        }
+    }
+
+    int size = 0;
+    unsigned char *archive = NULL;
+    if (status == 0)
+    {
+        archive = PackAssetArchive(fileNames, fileData, fileSizes, count, &size);
+        if (archive == NULL)
+        {
+            fprintf(stderr, "file names must be unique and shorter than %i characters\n", ASSET_ARCHIVE_NAME_SIZE);
+            status = 1;
+        }
+    }
+
+    if ((status == 0) && !SaveFileData(argv[1], archive, size))
+    {
+        fprintf(stderr, "failed to write %s\n", argv[1]);
+        status = 1;
+    }
+    if (status == 0) printf("%s: %i files, %i bytes\n", argv[1], count, size);
+
+    for (int i = 0; i < count; i++) UnloadFileData((unsigned char *)fileData[i]);
+    MemFree(archive);
+    MemFree(fileData);
+    MemFree(fileSizes);
+    return status;
+}
@@ -0,0 +1,74 @@
+// EXPLANATION:
+// Platform layer interface, one of platform_desktop.c, platform_web.c or
+// platform_headless.c is compiled into the program to implement it
+// Headless tools share the desktop settings, so they can link the same
+// module object files as the desktop game
+
+#ifndef FROGGER_PLATFORM_HEADER_GUARD
+#define FROGGER_PLATFORM_HEADER_GUARD
+
+// Macros
+// ----------------------------------------------------------------------------
+#if defined(PLATFORM_WEB)
+    #define GLSL_VERSION 100
+    #define PLATFORM_TITLE_PADDING UI_MENU_FONT_SIZE
+    #define PLATFORM_HAS_ANALOG_TRIGGERS 0
+    #define PLATFORM_CAN_EXIT 0
+    #define PLATFORM_HAS_FRAME_PACING 0 // the browser paces frames
+    #define PLATFORM_HAS_THREADS 0      // built without pthreads, jobs run on the main thread
+#else // PLATFORM_DESKTOP or PLATFORM_HEADLESS
+    #define GLSL_VERSION 330
+    #define PLATFORM_TITLE_PADDING 0.0f
+    #define PLATFORM_HAS_ANALOG_TRIGGERS 1
+    #define PLATFORM_CAN_EXIT 1
+    #define PLATFORM_HAS_FRAME_PACING 1 // vsync and max framerate can change at runtime
+    #define PLATFORM_HAS_THREADS 1
+#endif
+
+#if defined(_MSC_VER)
+    #define PLATFORM_THREAD_LOCAL __declspec(thread)
+#else
+    #define PLATFORM_THREAD_LOCAL __thread
+#endif
+
+// Atomics on volatile longs (C99 has none, so compiler builtins)
+#if defined(_MSC_VER)
+    long _InterlockedExchangeAdd(long volatile *addend, long value);
+    #pragma intrinsic(_InterlockedExchangeAdd)
+    #define PLATFORM_ATOMIC_ADD(ptr, value) _InterlockedExchangeAdd((ptr), (value))
+    #define PLATFORM_ATOMIC_LOAD(ptr) (*(ptr)) // volatile accesses are acquire/release with /volatile:ms
+    #define PLATFORM_ATOMIC_STORE(ptr, value) (*(ptr) = (value))
+#else
+    #define PLATFORM_ATOMIC_ADD(ptr, value) __atomic_fetch_add((ptr), (value), __ATOMIC_ACQ_REL)
+    #define PLATFORM_ATOMIC_LOAD(ptr) __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+    #define PLATFORM_ATOMIC_STORE(ptr, value) __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+#endif
+
+// Win32 API used by the platform layer, jobs and tools, declared here since
+// windows.h clashes with raylib names (e.g. Rectangle, CloseWindow, DrawText)
+#if defined(_WIN32)
+    __declspec(dllimport) void *__stdcall CreateThread(void *attributes, size_t stackSize,
+        unsigned long (__stdcall *start)(void *), void *param, unsigned long flags, unsigned long *threadId);
+    __declspec(dllimport) unsigned long __stdcall WaitForSingleObject(void *handle, unsigned long milliseconds);
+    __declspec(dllimport) int __stdcall CloseHandle(void *handle);
+    __declspec(dllimport) void *__stdcall CreateFileA(const char *fileName, unsigned long access, unsigned long shareMode,
+        void *security, unsigned long creation, unsigned long flags, void *templateFile);
+    __declspec(dllimport) int __stdcall GetFileSizeEx(void *file, long long *size);
+    __declspec(dllimport) void *__stdcall CreateFileMappingA(void *file, void *security, unsigned long protect,
+        unsigned long maxSizeHigh, unsigned long maxSizeLow, const char *name);
+    __declspec(dllimport) void *__stdcall MapViewOfFile(void *mapping, unsigned long access,
+        unsigned long offsetHigh, unsigned long offsetLow, size_t size);
+    __declspec(dllimport) int __stdcall UnmapViewOfFile(const void *address);
+    __declspec(dllimport) int __stdcall QueryPerformanceCounter(long long *count);
+    __declspec(dllimport) int __stdcall QueryPerformanceFrequency(long long *frequency);
+#endif
+
+// Prototypes
+// ----------------------------------------------------------------------------
+unsigned int PlatformWindowFlags(void); // Window flags to add for this platform
+void PlatformRunGameLoop(void (*UpdateDrawFrame)(GameContext *ctx), GameContext *ctx); // Runs until the game should close (not available headless)
+void PlatformHookInputEvents(GameContext *ctx); // Queues timestamped key events from the window (not available headless)
+const unsigned char *PlatformMapFile(const char *fileName, int *size); // Read-only view of a whole file (memory mapped on desktop), NULL if it can't be opened
+void PlatformUnmapFile(const unsigned char *data, int size);
+
+#endif // FROGGER_PLATFORM_HEADER_GUARD
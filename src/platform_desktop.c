@@ -1,24 +1,139 @@
 // EXPLANATION:
 // Contains code which is specific to the DESKTOP platform
 
-#define GLSL_VERSION 330
-#define PLATFORM_TITLE_PADDING 0.0f
-#define PLATFORM_HAS_ANALOG_TRIGGERS 1
-#define PLATFORM_CAN_EXIT 1
+#include "common.h" // all project header includes
 
-uint PlatformWindowFlags(void)
+// raylib links GLFW in statically, so declare just what's needed instead of including glfw3.h
+typedef struct GLFWwindow GLFWwindow;
+typedef void (*GLFWkeyfun)(GLFWwindow *window, int key, int scancode, int action, int mods);
+GLFWkeyfun glfwSetKeyCallback(GLFWwindow *window, GLFWkeyfun callback);
+void glfwPollEvents(void);
+#define GLFW_PRESS 1
+#define GLFW_REPEAT 2
+
+static double PlatformVsyncPeriod(GameContext *ctx);
+
+unsigned int PlatformWindowFlags(void)
 {
-    uint addedWindowFlags = FLAG_WINDOW_RESIZABLE;
+    unsigned int addedWindowFlags = FLAG_WINDOW_RESIZABLE;
     if (VSYNC_ENABLED) addedWindowFlags |= FLAG_VSYNC_HINT;
     return addedWindowFlags;
 }
 
-void PlatformRunGameLoop(void (*UpdateDrawFrame)(void))
+void PlatformRunGameLoop(void (*UpdateDrawFrame)(GameContext *ctx), GameContext *ctx)
 {
     if (MAX_FRAMERATE > 0)
         SetTargetFPS(MAX_FRAMERATE);
 
     // Main game loop
-    while (!WindowShouldClose() && !game.shouldExit)
-        UpdateDrawFrame();
+    while (!WindowShouldClose() && !ctx->game.shouldExit)
+    {
+        // Late latch: wait out the part of the vblank interval the frame won't need,
+        // then poll input again. glfwPollEvents() keeps raylib's previous key state
+        // from EndDrawing(), so presses from either poll still count as pressed.
+        // (gamepads are only read by raylib's own poll)
+        double sleep = GetFramePacerSleep(ctx, PlatformVsyncPeriod(ctx), GetTime());
+        if (sleep > 0)
+        {
+            WaitTime(sleep);
+            glfwPollEvents();
+        }
+
+        MarkFramePacerWorkStart(ctx, GetTime());
+        UpdateDrawFrame(ctx);
+        MarkFramePacerPresent(ctx, GetTime());
+    }
+}
+
+// Time between vblanks while vsync paces the game, 0 otherwise
+static double PlatformVsyncPeriod(GameContext *ctx)
+{
+    int refreshRate = GetMonitorRefreshRate(GetCurrentMonitor());
+    int maxFramerate = GetLatencyPacing(ctx)->maxFramerate;
+
+    if (!IsWindowState(FLAG_VSYNC_HINT) || (refreshRate <= 0)) return 0;
+    if ((maxFramerate > 0) && (maxFramerate < refreshRate)) return 0; // raylib's frame limiter paces instead
+
+    return 1.0/refreshRate;
+}
+
+// Input events
+// ----------------------------------------------------------------------------
+static GameContext *eventContext; // GLFW callbacks have no user data
+static GLFWkeyfun raylibKeyCallback;
+
+// Called from glfwPollEvents() at the end of EndDrawing(), once per key event
+static void PlatformKeyCallback(GLFWwindow *window, int key, int scancode, int action, int mods)
+{
+    if (action != GLFW_REPEAT)
+        PushInputEvent(eventContext, (InputEvent){ GetTime(), key, (action == GLFW_PRESS) });
+
+    raylibKeyCallback(window, key, scancode, action, mods); // raylib still tracks key state
+}
+
+void PlatformHookInputEvents(GameContext *ctx)
+{
+    eventContext = ctx;
+    raylibKeyCallback = glfwSetKeyCallback(GetWindowHandle(), PlatformKeyCallback);
+}
+
+// Files
+// ----------------------------------------------------------------------------
+#if defined(_WIN32) // Win32 file mapping, declared in platform.h
+#define PLATFORM_GENERIC_READ 0x80000000UL
+#define PLATFORM_FILE_SHARE_READ 0x1UL
+#define PLATFORM_OPEN_EXISTING 3UL
+#define PLATFORM_PAGE_READONLY 0x02UL
+#define PLATFORM_FILE_MAP_READ 0x4UL
+
+const unsigned char *PlatformMapFile(const char *fileName, int *size)
+{
+    void *file = CreateFileA(fileName, PLATFORM_GENERIC_READ, PLATFORM_FILE_SHARE_READ, NULL, PLATFORM_OPEN_EXISTING, 0, NULL);
+    if (file == (void *)(long long)-1) return NULL; // INVALID_HANDLE_VALUE
+
+    long long fileSize = 0;
+    void *mapping = NULL;
+    if (GetFileSizeEx(file, &fileSize) && (fileSize > 0) && (fileSize < 0x7fffffff))
+        mapping = CreateFileMappingA(file, NULL, PLATFORM_PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file); // the mapping keeps the file open
+
+    if (mapping == NULL) return NULL;
+    const unsigned char *data = MapViewOfFile(mapping, PLATFORM_FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping); // and the view keeps the mapping
+
+    *size = (int)fileSize;
+    return data;
+}
+
+void PlatformUnmapFile(const unsigned char *data, int size)
+{
+    (void)size;
+    UnmapViewOfFile(data);
+}
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+const unsigned char *PlatformMapFile(const char *fileName, int *size)
+{
+    int file = open(fileName, O_RDONLY);
+    if (file < 0) return NULL;
+
+    struct stat info;
+    void *data = MAP_FAILED;
+    if ((fstat(file, &info) == 0) && (info.st_size > 0) && (info.st_size < 0x7fffffff))
+        data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file); // the mapping keeps the file open
+
+    if (data == MAP_FAILED) return NULL;
+    *size = (int)info.st_size;
+    return data;
+}
+
+void PlatformUnmapFile(const unsigned char *data, int size)
+{
+    munmap((void *)data, (size_t)size);
 }
+#endif
@@ -0,0 +1,28 @@
+// EXPLANATION:
+// Contains code which is specific to HEADLESS builds (benchmarks, tests)
+// There is no window or audio device, so assets are left unloaded and
+// the game is stepped directly instead of by a platform game loop
+
+#include "common.h" // all project header includes
+
+unsigned int PlatformWindowFlags(void)
+{
+    // Only used if a tool opens a window anyway (e.g. to benchmark drawing)
+    return FLAG_WINDOW_HIDDEN;
+}
+
+// Files
+// ----------------------------------------------------------------------------
+// Nothing is streamed from files headless, so they're just read
+const unsigned char *PlatformMapFile(const char *fileName, int *size)
+{
+    if (!FileExists(fileName)) return NULL;
+
+    return LoadFileData(fileName, size);
+}
+
+void PlatformUnmapFile(const unsigned char *data, int size)
+{
+    (void)size;
+    UnloadFileData((unsigned char *)data);
+}
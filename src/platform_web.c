@@ -1,25 +1,96 @@
 // EXPLANATION:
 // Contains code which is specific to the WEB platform
 
-#include <emscripten/emscripten.h>
+#include "common.h" // all project header includes
 
-#define GLSL_VERSION 100
-#define PLATFORM_TITLE_PADDING UI_MENU_FONT_SIZE
-#define PLATFORM_HAS_ANALOG_TRIGGERS 0
-#define PLATFORM_CAN_EXIT 0
+#include <emscripten/emscripten.h>
+#include <emscripten/html5.h>
 
-uint PlatformWindowFlags(void)
+unsigned int PlatformWindowFlags(void)
 {
     // No additional flags for web
     return 0;
 }
 
-void PlatformRunGameLoop(void (*UpdateDrawFrame)(void))
+static void (*webUpdateDrawFrame)(GameContext *ctx);
+
+static void PlatformWebLoopStep(void *ctx)
+{
+    webUpdateDrawFrame(ctx);
+}
+
+void PlatformRunGameLoop(void (*UpdateDrawFrame)(GameContext *ctx), GameContext *ctx)
 {
     // Let emscripten handle the framerate because setting a specific one is kinda janky
     // Generally, it will use whatever the monitor's refresh rate is
     const int fps = 0;
     const int infiniteLoop = 1;
 
-    emscripten_set_main_loop(UpdateDrawFrame, fps, infiniteLoop);
+    webUpdateDrawFrame = UpdateDrawFrame;
+    emscripten_set_main_loop_arg(PlatformWebLoopStep, ctx, fps, infiniteLoop);
+}
+
+// Input events
+// ----------------------------------------------------------------------------
+// raylib's GLFW window isn't reachable on web, so listen to the DOM key events as well
+
+// DOM keyCode to raylib KeyboardKey, for the keys the game can map (0 if unknown)
+static int PlatformWebKeyCode(const EmscriptenKeyboardEvent *event)
+{
+    unsigned int code = event->keyCode;
+    bool right = (event->location == DOM_KEY_LOCATION_RIGHT);
+
+    if (((code >= 'A') && (code <= 'Z')) || ((code >= '0') && (code <= '9')) || (code == ' '))
+        return (int)code; // same as ASCII
+    if ((code >= 112) && (code <= 123))
+        return KEY_F1 + (int)(code - 112);
+
+    switch (code)
+    {
+        case 8:  return KEY_BACKSPACE;
+        case 9:  return KEY_TAB;
+        case 13: return KEY_ENTER;
+        case 16: return right? KEY_RIGHT_SHIFT : KEY_LEFT_SHIFT;
+        case 17: return right? KEY_RIGHT_CONTROL : KEY_LEFT_CONTROL;
+        case 18: return right? KEY_RIGHT_ALT : KEY_LEFT_ALT;
+        case 27: return KEY_ESCAPE;
+        case 37: return KEY_LEFT;
+        case 38: return KEY_UP;
+        case 39: return KEY_RIGHT;
+        case 40: return KEY_DOWN;
+        default: return 0;
+    }
+}
+
+// Called by the browser as soon as the event is dispatched, between frames
+static EM_BOOL PlatformWebKeyCallback(int eventType, const EmscriptenKeyboardEvent *event, void *ctx)
+{
+    int key = PlatformWebKeyCode(event);
+    if ((key != 0) && !event->repeat)
+        PushInputEvent(ctx, (InputEvent){ GetTime(), key, (eventType == EMSCRIPTEN_EVENT_KEYDOWN) });
+
+    return EM_FALSE; // let GLFW handle it too
+}
+
+void PlatformHookInputEvents(GameContext *ctx)
+{
+    emscripten_set_keydown_callback(EMSCRIPTEN_EVENT_TARGET_WINDOW, ctx, EM_FALSE, PlatformWebKeyCallback);
+    emscripten_set_keyup_callback(EMSCRIPTEN_EVENT_TARGET_WINDOW, ctx, EM_FALSE, PlatformWebKeyCallback);
+}
+
+// Files
+// ----------------------------------------------------------------------------
+// The archive is preloaded into the in-memory file system as one blob (see the Makefile),
+// so reading it is just a copy
+const unsigned char *PlatformMapFile(const char *fileName, int *size)
+{
+    if (!FileExists(fileName)) return NULL;
+
+    return LoadFileData(fileName, size);
+}
+
+void PlatformUnmapFile(const unsigned char *data, int size)
+{
+    (void)size;
+    UnloadFileData((unsigned char *)data);
 }
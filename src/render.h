@@ -17,14 +17,13 @@ typedef struct {
     bool shaderEnabled;
 } RenderData;
 
-extern RenderData viewport; // global declaration
-
 // Prototypes
 // ----------------------------------------------------------------------------
-void InitViewport(void);
-void InitRenderTexture(void);
-void InitScreenShader(void);
-void UpdateWindowRenderFrame(void); // update window for aspect ratio, cameras, and shaders
+void InitViewport(GameContext *ctx);
+void InitRenderTexture(GameContext *ctx);
+void InitScreenShader(GameContext *ctx);
+void UpdateWindowRenderFrame(GameContext *ctx); // update window for aspect ratio, cameras, and shaders
+void UpdateWindowShader(GameContext *ctx); // update screen shader uniforms
 
 #endif // FROGGER_RENDER_HEADER_GUARD
 
@@ -2,18 +2,106 @@
 // Utilities for making raylib even nicer to use
 // See header for more documentation/descriptions
 
+#include "common.h" // all project header includes
+
+#include <string.h> // strncpy, strncmp
+
+#define RL_UTILS_FONT_SIZE 32 // what LoadFont() bakes TTF fonts at
+
 // Asset manager
 // - track assets in a list, and then free all assets in that list
+// - load from the mounted asset archive's bytes when it has the file, see archive.h
+// - decoding only touches memory, so it can run on any thread (see loader.h),
+//   uploading needs the main thread's GPU context and audio device
 // ----------------------------------------------------------------------------
-Texture LoadTextureAssetEx(RaylibAssets *pool, char* fileName, TextureFilter filter)
+Image DecodeImageAsset(const char *fileName)
+{
+    int size = 0;
+    const unsigned char *data = GetAssetArchiveEntry(fileName, &size);
+    if (data != NULL) return LoadImageFromMemory(GetFileExtension(fileName), data, size);
+
+    return LoadImage(fileName);
+}
+
+Wave DecodeWaveAsset(const char *fileName)
+{
+    int size = 0;
+    const unsigned char *data = GetAssetArchiveEntry(fileName, &size);
+    if (data != NULL) return LoadWaveFromMemory(GetFileExtension(fileName), data, size);
+
+    return LoadWave(fileName);
+}
+
+// Same as LoadFontFromMemory() in raylib 5.5, up to the texture upload
+// (the glyph images are left as rasterized, they're only used by ImageDrawText())
+DecodedFont DecodeFontAsset(const char *fileName, int fontSize)
+{
+    DecodedFont decoded = { 0 };
+
+    int size = 0;
+    unsigned char *fileData = NULL;
+    const unsigned char *data = GetAssetArchiveEntry(fileName, &size);
+    if (data == NULL) data = fileData = LoadFileData(fileName, &size);
+    if (data == NULL) return decoded;
+
+    Font *font = &decoded.font;
+    font->baseSize = fontSize;
+    font->glyphCount = 95; // ASCII 32..126, raylib's default set
+    font->glyphs = LoadFontData(data, size, fontSize, NULL, font->glyphCount, FONT_DEFAULT);
+    if (font->glyphs != NULL)
+    {
+        font->glyphPadding = 4; // raylib's FONT_TTF_DEFAULT_CHARS_PADDING
+        decoded.atlas = GenImageFontAtlas(font->glyphs, &font->recs, font->glyphCount, fontSize, font->glyphPadding, 0);
+    }
+
+    UnloadFileData(fileData);
+    return decoded;
+}
+
+Texture UploadTextureAsset(RaylibAssets *pool, Image image, TextureFilter filter)
 {
-    Texture t = LoadTexture(fileName);
+    Texture t = LoadTextureFromImage(image);
+    UnloadImage(image);
     SetTextureFilter(t, filter);
     arrput(pool->textures, t);
     return t;
 }
 
-Texture LoadTextureAsset(RaylibAssets *pool, char* fileName)
+Sound UploadSoundAsset(RaylibAssets *pool, Wave wave, float volume)
+{
+    Sound s = LoadSoundFromWave(wave);
+    UnloadWave(wave);
+    SetSoundVolume(s, volume);
+    arrput(pool->sounds, s);
+    return s;
+}
+
+Wave AddWaveAsset(RaylibAssets *pool, Wave wave)
+{
+    arrput(pool->waves, wave);
+    return wave;
+}
+
+Font UploadFontAsset(RaylibAssets *pool, DecodedFont decoded, TextureFilter filter)
+{
+    Font f = decoded.font;
+    if (f.glyphs == NULL) return (Font){ 0 };
+
+    f.texture = LoadTextureFromImage(decoded.atlas);
+    UnloadImage(decoded.atlas);
+    SetTextureFilter(f.texture, filter);
+    arrput(pool->fonts, f);
+    return f;
+}
+
+Texture LoadTextureAssetEx(RaylibAssets *pool, const char *fileName, TextureFilter filter)
+{
+    if (!IsWindowReady()) return (Texture){ 0 }; // no GPU context to upload to
+
+    return UploadTextureAsset(pool, DecodeImageAsset(fileName), filter);
+}
+
+Texture LoadTextureAsset(RaylibAssets *pool, const char *fileName)
 {
     TextureFilter defaultFilter = TEXTURE_FILTER_BILINEAR;
     return LoadTextureAssetEx(pool, fileName, defaultFilter);
@@ -21,20 +109,58 @@ Texture LoadTextureAsset(RaylibAssets *pool, char* fileName)
 
 Sound LoadSoundAsset(RaylibAssets *pool, const char *fileName, float volume)
 {
-    Sound s = LoadSound(fileName);
-    SetSoundVolume(s, volume);
-    arrput(pool->sounds, s);
-    return s;
+    if (!IsAudioDeviceReady()) return (Sound){ 0 }; // playing an empty sound is a no-op
+
+    return UploadSoundAsset(pool, DecodeWaveAsset(fileName), volume);
 }
 
 Music LoadMusicAsset(RaylibAssets *pool, const char *fileName, float volume)
 {
-    Music m = LoadMusicStream(fileName);
+    if (!IsAudioDeviceReady()) return (Music){ 0 };
+
+    // Streamed from the archive's bytes while it plays, no copy
+    int size = 0;
+    const unsigned char *data = GetAssetArchiveEntry(fileName, &size);
+    Music m = (data != NULL)? LoadMusicStreamFromMemory(GetFileExtension(fileName), data, size) : LoadMusicStream(fileName);
     SetMusicVolume(m, volume);
     arrput(pool->music, m);
     return m;
 }
 
+Font LoadFontAsset(RaylibAssets *pool, const char *fileName)
+{
+    return LoadFontAssetEx(pool, fileName, RL_UTILS_FONT_SIZE);
+}
+
+Font LoadFontAssetEx(RaylibAssets *pool, const char *fileName, int fontSize)
+{
+    if (!IsWindowReady() || (fontSize <= 0)) return (Font){ 0 };
+
+    return UploadFontAsset(pool, DecodeFontAsset(fileName, fontSize), TEXTURE_FILTER_POINT);
+}
+
+Shader LoadShaderAsset(const char *fsFileName)
+{
+    // Archive files are NUL terminated, so shader code is used in place
+    int size = 0;
+    const unsigned char *data = GetAssetArchiveEntry(fsFileName, &size);
+    if (data != NULL) return LoadShaderFromMemory(NULL, (const char *)data);
+
+    return LoadShader(NULL, fsFileName);
+}
+
+void UnloadFontAsset(RaylibAssets *pool, Font font)
+{
+    for (int i = 0; i < arrlen(pool->fonts); i++)
+    {
+        if (pool->fonts[i].texture.id != font.texture.id) continue;
+
+        UnloadFont(pool->fonts[i]);
+        arrdelswap(pool->fonts, i);
+        return;
+    }
+}
+
 void FreeRaylibAssets(RaylibAssets *pool)
 {
     for (int i = 0; i < arrlen(pool->textures); i++)
@@ -43,23 +169,103 @@ void FreeRaylibAssets(RaylibAssets *pool)
     for (int i = 0; i < arrlen(pool->sounds); i++)
         UnloadSound(pool->sounds[i]);
 
+    for (int i = 0; i < arrlen(pool->waves); i++)
+        UnloadWave(pool->waves[i]);
+
     for (int i = 0; i < arrlen(pool->music); i++)
         UnloadMusicStream(pool->music[i]);
 
+    for (int i = 0; i < arrlen(pool->fonts); i++)
+        UnloadFont(pool->fonts[i]);
+
     arrfree(pool->textures);
     arrfree(pool->sounds);
+    arrfree(pool->waves);
     arrfree(pool->music);
+    arrfree(pool->fonts);
+}
+
+// Text
+// ----------------------------------------------------------------------------
+Vector2 MeasureFontText(Font font, const char *text, float fontSize, float spacing)
+{
+    // raylib 5.5 only checks for a missing font texture once the GPU is ready,
+    // so measuring without a window would read an empty glyph array
+    if (font.glyphs == NULL) return Vector2Zero();
+
+    return MeasureTextEx(font, text, fontSize, spacing);
+}
+
+// Same layout as DrawTextEx() in raylib 5.5 (single line)
+static void ShapeTextRun(TextRun *run, Font font, const char *text, Vector2 position, float fontSize, float spacing)
+{
+    *run = (TextRun){
+        .position = position,
+        .fontSize = fontSize,
+        .spacing = spacing,
+        .fontTextureId = font.texture.id,
+        .fontBaseSize = font.baseSize,
+    };
+    strncpy(run->text, text, TEXT_RUN_MAX_GLYPHS - 1);
+    if (font.glyphs == NULL) return; // unloaded font, nothing to draw
+
+    float scale = fontSize/(float)font.baseSize;
+    float padding = (float)font.glyphPadding;
+    float offsetX = 0;
+    for (int i = 0; run->text[i] != '\0';)
+    {
+        int codepointSize = 0;
+        int codepoint = GetCodepointNext(&run->text[i], &codepointSize);
+        int index = GetGlyphIndex(font, codepoint);
+        i += codepointSize;
+
+        Rectangle rec = font.recs[index];
+        GlyphInfo glyph = font.glyphs[index];
+        if ((codepoint != ' ') && (codepoint != '\t'))
+        {
+            run->quads[run->quadCount++] = (TextGlyphQuad){
+                .src = { rec.x - padding, rec.y - padding, rec.width + 2*padding, rec.height + 2*padding },
+                .dest = { position.x + offsetX + (glyph.offsetX - padding)*scale,
+                          position.y + (glyph.offsetY - padding)*scale,
+                          (rec.width + 2*padding)*scale, (rec.height + 2*padding)*scale },
+            };
+        }
+
+        if (glyph.advanceX == 0) offsetX += rec.width*scale + spacing;
+        else offsetX += (float)glyph.advanceX*scale + spacing;
+    }
+}
+
+bool UpdateTextRun(TextRun *run, Font font, const char *text, Vector2 position, float fontSize, float spacing)
+{
+    bool isChanged = (run->fontTextureId != font.texture.id) || (run->fontBaseSize != font.baseSize) ||
+                     (run->fontSize != fontSize) || (run->spacing != spacing) ||
+                     (run->position.x != position.x) || (run->position.y != position.y) ||
+                     strncmp(run->text, text, TEXT_RUN_MAX_GLYPHS - 1);
+    if (isChanged) ShapeTextRun(run, font, text, position, fontSize, spacing);
+
+    return isChanged;
+}
+
+void DrawTextRun(TextRun *run, Font font, const char *text, Vector2 position, float fontSize, float spacing, Color tint)
+{
+    UpdateTextRun(run, font, text, position, fontSize, spacing);
+    for (int i = 0; i < run->quadCount; i++)
+        DrawTexturePro(font.texture, run->quads[i].src, run->quads[i].dest, Vector2Zero(), 0, tint);
 }
 
 // Draw sprites
 // ----------------------------------------------------------------------------
+Rectangle GetSpriteFrame(Sprite sprite, Vector2 frame)
+{
+    Rectangle rec = sprite.rec;
+    rec.x += frame.x*sprite.stride.x;
+    rec.y += frame.y*sprite.stride.y;
+    return rec;
+}
+
 void DrawSpriteOnRectangle(Texture *sprite, Rectangle src, Rectangle rect, float angle)
 {
-    // prevent bordering sprites in the atlas from bleeding over
-    src.x += 0.05f;
-    src.y += 0.05f;
-    src.width -= 0.1f;
-    src.height -= 0.1f;
     DrawTexturePro(*sprite, src, rect, Vector2Zero(), angle, WHITE);
 }
 
@@ -72,11 +278,5 @@ void DrawSpriteOnCircle(Texture *sprite, Rectangle src,
     };
     Vector2 spriteOrigin = { radius, radius };
 
-    // prevent bordering sprites in the atlas from bleeding over
-    src.x += 0.05f;
-    src.y += 0.05f;
-    src.width -= 0.1f;
-    src.height -= 0.1f;
-
     DrawTexturePro(*sprite, src, spriteDest, spriteOrigin, angle, WHITE);
 }
@@ -4,25 +4,75 @@
 #ifndef FROGGER_RL_UTIL_HEADER_GUARD
 #define FROGGER_RL_UTIL_HEADER_GUARD
 
+// Macros
+// ----------------------------------------------------------------------------
+#define TEXT_RUN_MAX_GLYPHS 64
+
 // Types and Structures
 // ----------------------------------------------------------------------------
 typedef struct { // keep track of raylib resources to free together
     Texture *textures;
     Sound *sounds;
+    Wave *waves; // played by the game's own mixer, see audio.h
     Music *music;
+    Font *fonts;
 } RaylibAssets;
 
+typedef struct { // font decoded in memory, the atlas isn't a texture yet
+    Font font;
+    Image atlas;
+} DecodedFont;
+
+typedef struct { // sprite in the atlas, see sprites.h
+    Rectangle rec;  // first frame
+    Vector2 stride; // to the next frame across and down
+} Sprite;
+
+typedef struct {
+    Rectangle src, dest;
+} TextGlyphQuad;
+
+typedef struct { // text laid out into glyph quads, only redone when the text or its style changes
+    TextGlyphQuad quads[TEXT_RUN_MAX_GLYPHS];
+    int quadCount;
+
+    // what the quads were laid out for
+    char text[TEXT_RUN_MAX_GLYPHS];
+    Vector2 position;
+    float fontSize, spacing;
+    unsigned int fontTextureId;
+    int fontBaseSize;
+} TextRun;
+
 // Prototypes
 // ----------------------------------------------------------------------------
 
 // Asset manager
-Texture LoadTextureAssetEx(RaylibAssets *pool, char* fileName, TextureFilter filter);
-Texture LoadTextureAsset(RaylibAssets *pool, char* fileName);
+// (assets are left empty when there is no window/audio device, e.g. headless builds)
+Image DecodeImageAsset(const char *fileName); // Decode functions are safe on any thread
+Wave DecodeWaveAsset(const char *fileName);
+DecodedFont DecodeFontAsset(const char *fileName, int fontSize); // Rasterize the glyphs and pack the atlas image
+Texture UploadTextureAsset(RaylibAssets *pool, Image image, TextureFilter filter); // Upload functions take ownership of
+Sound UploadSoundAsset(RaylibAssets *pool, Wave wave, float volume);               // the decoded data, main thread only
+Font UploadFontAsset(RaylibAssets *pool, DecodedFont decoded, TextureFilter filter);
+Wave AddWaveAsset(RaylibAssets *pool, Wave wave); // Keep decoded samples in the pool, nothing to upload
+Texture LoadTextureAssetEx(RaylibAssets *pool, const char *fileName, TextureFilter filter);
+Texture LoadTextureAsset(RaylibAssets *pool, const char *fileName);
 Sound LoadSoundAsset(RaylibAssets *pool, const char *fileName, float volume);
 Music LoadMusicAsset(RaylibAssets *pool, const char *fileName, float volume);
+Font LoadFontAsset(RaylibAssets *pool, const char *fileName);
+Font LoadFontAssetEx(RaylibAssets *pool, const char *fileName, int fontSize); // Bake the font's glyphs at a pixel size
+void UnloadFontAsset(RaylibAssets *pool, Font font); // Unload a font and remove it from the pool
+Shader LoadShaderAsset(const char *fsFileName); // Fragment shader with the default vertex shader (not pooled)
 void FreeRaylibAssets(RaylibAssets *pool);
 
+// Text
+Vector2 MeasureFontText(Font font, const char *text, float fontSize, float spacing); // MeasureTextEx(), but returns zero size for an unloaded font
+bool UpdateTextRun(TextRun *run, Font font, const char *text, Vector2 position, float fontSize, float spacing); // Lay out the glyphs again if anything changed, returns true if it did
+void DrawTextRun(TextRun *run, Font font, const char *text, Vector2 position, float fontSize, float spacing, Color tint); // DrawTextEx(), but reuses the run's glyph layout while nothing changed
+
 // Draw sprites
+Rectangle GetSpriteFrame(Sprite sprite, Vector2 frame); // Source rectangle of a frame, e.g. { 2, 1 } is third across, second down
 void DrawSpriteOnRectangle(Texture *sprite, Rectangle src, Rectangle rect, float angle); // Draw a sprite on a rectangle
 void DrawSpriteOnCircle(Texture *sprite, Rectangle src, // Draw a sprite centered on a circle (radius acts as sprite scaling)
                         Vector2 center, float radius, float angle);
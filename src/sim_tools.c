@@ -0,0 +1,225 @@
+// EXPLANATION:
+// Shared code for the headless tools (bench.c, tests.c, soak.c)
+// See header for more documentation/descriptions
+
+#include "common.h" // all project header includes
+#include "sim_tools.h"
+
+#define INVARIANT_EPSILON 0.01f
+
+// Local Functions Declaration
+// ----------------------------------------------------------------------------
+static Entity *FindRiddenPlatform(GameContext *ctx);
+static int CountOpenWinZones(GameContext *ctx);
+static unsigned int NextBotRandom(unsigned int *state);
+static bool IsBotTargetSafe(GameContext *ctx, Vector2 target);
+
+// Clock
+// ----------------------------------------------------------------------------
+#if defined(_WIN32) // performance counter, declared in platform.h
+double GetClockTimeNs(void)
+{
+    long long count, frequency;
+    QueryPerformanceCounter(&count);
+    QueryPerformanceFrequency(&frequency);
+    return (double)count*1e9/(double)frequency;
+}
+#else
+#include <time.h>
+
+double GetClockTimeNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec*1e9 + (double)ts.tv_nsec;
+}
+#endif
+
+// Invariants
+// ----------------------------------------------------------------------------
+void TakeInvariantSnapshot(GameContext *ctx, InvariantSnapshot *snapshot)
+{
+    GameState *game = &ctx->game;
+
+    *snapshot = (InvariantSnapshot){
+        .score = game->score,
+        .lives = game->lives,
+        .level = game->level,
+        .isGameOver = game->isGameOver,
+        .isGameWon = game->isGameWon,
+        .frogPosition = game->frog->position,
+    };
+
+    if (game->frog->isOnPlatform && !game->frog->isMoving && !game->frog->isDead)
+        snapshot->riddenPlatform = FindRiddenPlatform(ctx);
+    if (snapshot->riddenPlatform)
+        snapshot->rideOffset = game->frog->position.x - GetEntityRec(ctx, snapshot->riddenPlatform).x;
+}
+
+#define INVARIANT(cond) do { if (!(cond)) return #cond; } while (0)
+
+// Returns the failed invariant as text, or NULL if they all hold
+const char *CheckGameInvariants(GameContext *ctx, const InvariantSnapshot *prev)
+{
+    GameState *game = &ctx->game;
+
+    bool levelChanged = (game->level != prev->level) || (prev->isGameOver && !game->isGameOver) ||
+                        (prev->isGameWon && !game->isGameWon);
+
+    // Bookkeeping is consistent
+    INVARIANT(game->winCount == CountOpenWinZones(ctx));
+    INVARIANT((game->lives >= 0) && (game->lives <= 4));
+    INVARIANT(game->level >= 1);
+    INVARIANT(game->hiScore >= prev->score); // hiScore catches up at the start of the next tick
+    INVARIANT(game->frog == &game->entities[game->entityCount - 1]);
+
+    // Score never goes down, except when a game over restarts the game
+    if (game->score < prev->score)
+        INVARIANT(prev->isGameOver && (game->score == 0) && (game->lives == 4));
+    // Losing a life doesn't cost points
+    if (game->lives < prev->lives)
+        INVARIANT(game->score >= prev->score);
+
+    // Frog stays on the grid, crossing an edge wraps it around and kills it
+    INVARIANT(game->frog->position.x >= game->gridStart.x - game->frog->radius - INVARIANT_EPSILON);
+    INVARIANT(game->frog->position.x <= game->gridStart.x + GRID_WIDTH + game->frog->radius + INVARIANT_EPSILON);
+    if (!levelChanged && (fabsf(game->frog->position.x - prev->frogPosition.x) > GRID_WIDTH/2))
+        INVARIANT(game->frog->isDead);
+
+    // Frog never drifts off the platform it's riding, unless the platform wraps
+    if (prev->riddenPlatform && !levelChanged && !game->frog->isDead && !game->frog->isMoving &&
+        Vector2Equals(game->frog->seekPos, game->frog->position))
+    {
+        float drift = fabsf(game->frog->position.x - GetEntityRec(ctx, prev->riddenPlatform).x - prev->rideOffset);
+        INVARIANT((drift < INVARIANT_EPSILON) || (fabsf(drift - GRID_WIDTH) < INVARIANT_EPSILON));
+    }
+
+    return NULL;
+}
+
+// Find the platform the frog is riding (same lane speed, overlapping the frog)
+static Entity *FindRiddenPlatform(GameContext *ctx)
+{
+    GameState *game = &ctx->game;
+
+    for (int i = 0; i < game->entityCount; i++)
+    {
+        Entity *e = &game->entities[i];
+        if (!(e->flags & ENTITY_FLAG_PLATFORM) || (e->speed != game->frog->platformMove))
+            continue;
+        Rectangle rec = GetEntityRec(ctx, e);
+        float slack = fabsf(e->speed*game->frameTime) + INVARIANT_EPSILON;
+        for (int wrap = -1; wrap <= 1; wrap++)
+        {
+            float x = rec.x + wrap*GRID_WIDTH;
+            if ((game->frog->position.x >= x - slack) && (game->frog->position.x <= x + rec.width + slack) &&
+                (game->frog->position.y >= rec.y) && (game->frog->position.y <= rec.y + rec.height))
+                return e;
+        }
+    }
+    return NULL;
+}
+
+static int CountOpenWinZones(GameContext *ctx)
+{
+    GameState *game = &ctx->game;
+
+    int count = 0;
+    for (int i = 0; i < game->entityCount; i++)
+        if ((game->entities[i].type == ENTITY_TYPE_WIN) && !game->entities[i].isWin)
+            count++;
+    return count;
+}
+
+// Bot input
+// ----------------------------------------------------------------------------
+
+// Sets this tick's player input, botState is the bot's own random state (nonzero)
+void SetBotInput(GameContext *ctx, BotInputMode mode, unsigned int *botState)
+{
+    GameState *game = &ctx->game;
+    InputState *input = &ctx->input;
+
+    input->player = (InputActionsPlayer){ 0 };
+    int choice = (int)(NextBotRandom(botState) % 64);
+
+    switch (mode)
+    {
+        case BOT_INPUT_RANDOM:
+        {
+            input->player.moveUp    = (choice < 3);
+            input->player.moveDown  = (choice >= 3) && (choice < 6);
+            input->player.moveLeft  = (choice >= 6) && (choice < 9);
+            input->player.moveRight = (choice >= 9) && (choice < 12);
+        } break;
+
+        case BOT_INPUT_HOP:
+        {
+            input->player.moveUp    = (choice < 6);
+            input->player.moveLeft  = (choice == 6);
+            input->player.moveRight = (choice == 7);
+            input->player.moveDown  = (choice == 8);
+        } break;
+
+        case BOT_INPUT_GREEDY:
+        {
+            if (game->frog->isMoving || game->frog->isDead) break;
+
+            Vector2 up = { game->frog->position.x, game->frog->position.y - GRID_UNIT };
+            if (IsBotTargetSafe(ctx, up)) input->player.moveUp = true;
+            else if (choice == 0) input->player.moveLeft = true; // sometimes wander to find a gap
+            else if (choice == 1) input->player.moveRight = true;
+        } break;
+
+        default: break;
+    }
+}
+
+static unsigned int NextBotRandom(unsigned int *state)
+{
+    unsigned int x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+// Whether the frog would survive landing at target, judging by where things are now
+// and where they'll be about half a second later
+static bool IsBotTargetSafe(GameContext *ctx, Vector2 target)
+{
+    GameState *game = &ctx->game;
+
+    bool inWater = CheckCollisionPointRec(target, game->background.water);
+    bool onPlatform = false;
+
+    for (int i = 0; i < game->entityCount; i++)
+    {
+        Entity *e = &game->entities[i];
+        if (e->type == ENTITY_TYPE_FROG) continue;
+
+        Rectangle rec = GetEntityRec(ctx, e);
+        float travel = e->speed*0.5f;
+        if (e->flags & ENTITY_FLAG_KILL)
+        {
+            // grow hostiles by how far they'll move
+            if (travel < 0) rec.x += travel;
+            rec.width += fabsf(travel);
+            Rectangle wrapped = { rec.x + ((rec.x < game->gridStart.x)? GRID_WIDTH : -GRID_WIDTH), rec.y, rec.width, rec.height };
+            if (CheckCollisionCircleRec(target, game->frog->radius, rec) ||
+                CheckCollisionCircleRec(target, game->frog->radius, wrapped))
+                return false;
+        }
+        if ((e->type == ENTITY_TYPE_WIN) && !e->isWin && CheckCollisionPointRec(target, rec))
+            onPlatform = true; // the top row counts as water, except for the open win zones
+        if (inWater && (e->flags & ENTITY_FLAG_PLATFORM) && !(e->isSinking && (GetEntityAnimationFrame(ctx, e) >= TURTLE_SUNK_FRAME - 1)))
+        {
+            // platforms must still be under the frog after moving
+            Rectangle later = { rec.x + travel, rec.y, rec.width, rec.height };
+            if (CheckCollisionPointRec(target, rec) && CheckCollisionPointRec(target, later))
+                onPlatform = true;
+        }
+    }
+
+    return !inWater || onPlatform;
+}
@@ -0,0 +1,34 @@
+// EXPLANATION:
+// Shared code for the headless tools (bench.c, tests.c, soak.c):
+// a monotonic clock, game rule invariants checked after every simulation
+// tick, and bot input to drive the frog
+
+#ifndef FROGGER_SIM_TOOLS_HEADER_GUARD
+#define FROGGER_SIM_TOOLS_HEADER_GUARD
+
+// Types and Structures
+// ----------------------------------------------------------------------------
+
+// Game values from before a tick, to compare against after it
+typedef struct {
+    int score, lives, level;
+    bool isGameOver, isGameWon;
+    Vector2 frogPosition;
+    Entity *riddenPlatform; // NULL if the frog isn't riding one
+    float rideOffset;
+} InvariantSnapshot;
+
+typedef enum {
+    BOT_INPUT_RANDOM, // presses any move at random
+    BOT_INPUT_HOP,    // random, but mostly hopping up the screen
+    BOT_INPUT_GREEDY, // hops up when the next row looks safe
+} BotInputMode;
+
+// Prototypes
+// ----------------------------------------------------------------------------
+double GetClockTimeNs(void); // Monotonic clock in nanoseconds
+void TakeInvariantSnapshot(GameContext *ctx, InvariantSnapshot *snapshot);
+const char *CheckGameInvariants(GameContext *ctx, const InvariantSnapshot *prev); // Returns the failed invariant as text, or NULL if they all hold
+void SetBotInput(GameContext *ctx, BotInputMode mode, unsigned int *botState); // Sets this tick's player input, botState is the bot's own random state (nonzero)
+
+#endif // FROGGER_SIM_TOOLS_HEADER_GUARD
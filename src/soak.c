@@ -0,0 +1,311 @@
+// EXPLANATION:
+// Soak runner: plays many headless games at once to shake out rare bugs
+// Each worker thread runs its own game context with its own seed, driven by
+// bot input, and checks the game rule invariants after every tick.
+//
+// Usage: frogger_soak [--threads <n>] [--ticks <n>] [--game-ticks <n>]
+//                     [--seed <n>] [--input random|hop|greedy]
+// A game is restarted with the next seed after a failure (invariant or crash)
+// or after --game-ticks. Every failure is printed with a command to replay it.
+
+#include "common.h" // all project header includes
+
+#include <setjmp.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sim_tools.h" // invariants, bot input and timer
+
+// Soak settings
+#define SOAK_DEFAULT_THREADS 4
+#define SOAK_DEFAULT_TICKS 2000000     // per worker
+#define SOAK_DEFAULT_GAME_TICKS 200000 // ~55 minutes of play at 60fps
+#define SOAK_DEFAULT_SEED 1
+#define SOAK_MAX_THREADS 256
+#define SOAK_MAX_REPORTS 8             // failures kept per worker
+#define SOAK_FRAME_TIME (1.0f/60.0f)
+
+#if defined(_WIN32)
+    #define SOAK_SETJMP(env) setjmp(env)
+    #define SOAK_LONGJMP(env) longjmp(env, 1)
+    typedef jmp_buf SoakJumpBuffer;
+#else
+    #define SOAK_SETJMP(env) sigsetjmp(env, 1) // also restores the signal mask
+    #define SOAK_LONGJMP(env) siglongjmp(env, 1)
+    typedef sigjmp_buf SoakJumpBuffer;
+#endif
+
+// Types and Structures
+// ----------------------------------------------------------------------------
+typedef struct {
+    unsigned int seed;
+    long long tick; // tick within that seed's game
+    const char *reason;
+} SoakFailure;
+
+typedef struct {
+    int index;
+    unsigned int seed; // seed of the current game
+
+    long long ticks, gameTicks;
+    int games, gameOvers, levelsWon, maxLevel, maxScore;
+    int violations, crashes;
+    SoakFailure failures[SOAK_MAX_REPORTS];
+    int failureCount;
+
+    SoakJumpBuffer crashJump;
+    volatile bool isCrashJumpSet;
+} SoakWorker;
+
+typedef struct {
+    int threads;
+    long long ticks, gameTicks;
+    unsigned int seed;
+    BotInputMode inputMode;
+} SoakSettings;
+
+// Local Functions Declaration
+// ----------------------------------------------------------------------------
+static void RunSoakWorker(SoakWorker *worker);
+static void StartSoakGame(GameContext *ctx, SoakWorker *worker, unsigned int seed);
+static void RecordSoakFailure(SoakWorker *worker, long long tick, const char *reason);
+static void SoakCrashHandler(int sig);
+static void RunSoakThreads(SoakWorker *workers, int count);
+
+static SoakSettings settings = {
+    .threads = SOAK_DEFAULT_THREADS,
+    .ticks = SOAK_DEFAULT_TICKS,
+    .gameTicks = SOAK_DEFAULT_GAME_TICKS,
+    .seed = SOAK_DEFAULT_SEED,
+    .inputMode = BOT_INPUT_GREEDY,
+};
+static const char *inputModeNames[] = { "random", "hop", "greedy" };
+static PLATFORM_THREAD_LOCAL SoakWorker *currentWorker; // for the crash handler
+
+// Main entry point
+int main(int argc, char **argv)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasValue = (i + 1 < argc);
+        if (!strcmp(argv[i], "--threads") && hasValue) settings.threads = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--ticks") && hasValue) settings.ticks = atoll(argv[++i]);
+        else if (!strcmp(argv[i], "--game-ticks") && hasValue) settings.gameTicks = atoll(argv[++i]);
+        else if (!strcmp(argv[i], "--seed") && hasValue) settings.seed = (unsigned int)strtoul(argv[++i], NULL, 10);
+        else if (!strcmp(argv[i], "--input") && hasValue)
+        {
+            const char *mode = argv[++i];
+            int found = -1;
+            for (int m = 0; m < (int)(sizeof(inputModeNames)/sizeof(inputModeNames[0])); m++)
+                if (!strcmp(mode, inputModeNames[m])) found = m;
+            if (found >= 0) settings.inputMode = (BotInputMode)found;
+            else settings.threads = 0; // show usage
+        }
+        else settings.threads = 0;
+    }
+    if ((settings.threads < 1) || (settings.threads > SOAK_MAX_THREADS) ||
+        (settings.ticks < 1) || (settings.gameTicks < 1))
+    {
+        fprintf(stderr, "usage: %s [--threads <n>] [--ticks <n>] [--game-ticks <n>]\n"
+                        "       %*s [--seed <n>] [--input random|hop|greedy]\n",
+                argv[0], (int)strlen(argv[0]), "");
+        return 1;
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+
+    signal(SIGSEGV, SoakCrashHandler);
+    signal(SIGFPE, SoakCrashHandler);
+    signal(SIGILL, SoakCrashHandler);
+    signal(SIGABRT, SoakCrashHandler);
+
+    printf("soak: %i threads x %lld ticks, %s input, seeds from %u\n",
+           settings.threads, settings.ticks, inputModeNames[settings.inputMode], settings.seed);
+    fflush(stdout);
+
+    static SoakWorker workers[SOAK_MAX_THREADS];
+    for (int i = 0; i < settings.threads; i++)
+        workers[i] = (SoakWorker){ .index = i };
+
+    double start = GetClockTimeNs();
+    RunSoakThreads(workers, settings.threads);
+    double elapsed = GetClockTimeNs() - start;
+
+    // Aggregate results
+    // ----------------------------------------------------------------------------
+    long long ticks = 0;
+    int games = 0, gameOvers = 0, levelsWon = 0, maxLevel = 0, maxScore = 0, violations = 0, crashes = 0;
+    for (int i = 0; i < settings.threads; i++)
+    {
+        SoakWorker *w = &workers[i];
+        ticks += w->ticks;
+        games += w->games;
+        gameOvers += w->gameOvers;
+        levelsWon += w->levelsWon;
+        violations += w->violations;
+        crashes += w->crashes;
+        if (w->maxLevel > maxLevel) maxLevel = w->maxLevel;
+        if (w->maxScore > maxScore) maxScore = w->maxScore;
+
+        for (int f = 0; f < w->failureCount; f++)
+        {
+            SoakFailure *failure = &w->failures[f];
+            printf("FAIL worker %i, seed %u, tick %lld: %s\n", i, failure->seed, failure->tick, failure->reason);
+            printf("     replay: %s --threads 1 --seed %u --ticks %lld --game-ticks %lld --input %s\n",
+                   argv[0], failure->seed, failure->tick + 1, settings.gameTicks, inputModeNames[settings.inputMode]);
+        }
+    }
+
+    printf("ticks:      %lld (%.0f game hours)\n", ticks, (double)ticks*SOAK_FRAME_TIME/3600.0);
+    printf("games:      %i, %i game overs, %i levels won, best level %i, best score %i\n",
+           games, gameOvers, levelsWon, maxLevel, maxScore);
+    printf("failures:   %i invariant violations, %i crashes\n", violations, crashes);
+    printf("throughput: %.2f Mticks/s total, %.0f ns/tick per thread\n",
+           (double)ticks/elapsed*1e3, elapsed*settings.threads/(double)ticks);
+
+    return ((violations + crashes) == 0)? 0 : 1;
+}
+
+// Worker
+// ----------------------------------------------------------------------------
+static void RunSoakWorker(SoakWorker *worker)
+{
+    GameContext *ctx = calloc(1, sizeof(GameContext)); // each worker has its own game
+    GameState *game = &ctx->game;
+
+    currentWorker = worker;
+    InitUiState(ctx);
+    InitDefaultInputSettings(ctx);
+
+    unsigned int botState = 0;
+    StartSoakGame(ctx, worker, settings.seed + (unsigned int)worker->index);
+
+    // A crash jumps back here, the game state can't be trusted so it's dropped
+    if (SOAK_SETJMP(worker->crashJump))
+    {
+        worker->crashes++;
+        game->levelArena = (Arena){ 0 }; // leaked on purpose, may be corrupt
+        game->assets = (RaylibAssets){ 0 };
+        StartSoakGame(ctx, worker, worker->seed + (unsigned int)settings.threads);
+    }
+    worker->isCrashJumpSet = true;
+
+    while (worker->ticks < settings.ticks)
+    {
+        if (worker->gameTicks == 0) botState = worker->seed*2654435761u + 1;
+
+        SetBotInput(ctx, settings.inputMode, &botState);
+
+        InvariantSnapshot prev;
+        TakeInvariantSnapshot(ctx, &prev);
+        game->frameCount++;
+        UpdateGameSimulation(ctx);
+
+        worker->ticks++;
+        worker->gameTicks++;
+        if (game->isGameOver && !prev.isGameOver) worker->gameOvers++;
+        if (game->isGameWon && !prev.isGameWon) worker->levelsWon++;
+        if (game->level > worker->maxLevel) worker->maxLevel = game->level;
+        if (game->score > worker->maxScore) worker->maxScore = game->score;
+
+        const char *failed = CheckGameInvariants(ctx, &prev);
+        if (failed)
+        {
+            worker->violations++;
+            RecordSoakFailure(worker, worker->gameTicks - 1, failed);
+            StartSoakGame(ctx, worker, worker->seed + (unsigned int)settings.threads);
+        }
+        else if (worker->gameTicks >= settings.gameTicks)
+            StartSoakGame(ctx, worker, worker->seed + (unsigned int)settings.threads);
+    }
+
+    worker->isCrashJumpSet = false;
+
+    FreeGameState(ctx);
+    FreeUiState(ctx);
+    free(ctx);
+}
+
+// Start a fresh, deterministic game on level 1
+static void StartSoakGame(GameContext *ctx, SoakWorker *worker, unsigned int seed)
+{
+    GameState *game = &ctx->game;
+
+    FreeGameState(ctx);
+    InitGameStateEx(ctx, seed);
+    game->currentScreen = SCREEN_GAMEPLAY;
+    game->frameTime = SOAK_FRAME_TIME;
+    game->waitTimer = 0;
+    ctx->ui.currentMenu = UI_MENU_NONE;
+
+    worker->seed = seed;
+    worker->gameTicks = 0;
+    worker->games++;
+}
+
+static void RecordSoakFailure(SoakWorker *worker, long long tick, const char *reason)
+{
+    if (worker->failureCount >= SOAK_MAX_REPORTS) return;
+    worker->failures[worker->failureCount++] = (SoakFailure){ worker->seed, tick, reason };
+}
+
+// Runs on the crashing thread, so it can find the worker and jump back into its loop
+static void SoakCrashHandler(int sig)
+{
+    signal(sig, SoakCrashHandler); // some platforms reset the handler
+
+    SoakWorker *worker = currentWorker;
+    if (!worker || !worker->isCrashJumpSet)
+    {
+        signal(sig, SIG_DFL);
+        raise(sig);
+        return;
+    }
+
+    const char *reason = (sig == SIGSEGV)? "crash: segmentation fault" :
+                         (sig == SIGFPE)?  "crash: floating point exception" :
+                         (sig == SIGILL)?  "crash: illegal instruction" : "crash: abort";
+    RecordSoakFailure(worker, worker->gameTicks, reason);
+    SOAK_LONGJMP(worker->crashJump);
+}
+
+// Threads
+// ----------------------------------------------------------------------------
+#if defined(_WIN32) // Win32 threads, declared in platform.h
+static unsigned long __stdcall SoakThreadMain(void *param)
+{
+    RunSoakWorker(param);
+    return 0;
+}
+
+static void RunSoakThreads(SoakWorker *workers, int count)
+{
+    static void *threads[SOAK_MAX_THREADS];
+    for (int i = 0; i < count; i++)
+        threads[i] = CreateThread(NULL, 0, SoakThreadMain, &workers[i], 0, NULL);
+    for (int i = 0; i < count; i++)
+    {
+        WaitForSingleObject(threads[i], 0xFFFFFFFF); // INFINITE
+        CloseHandle(threads[i]);
+    }
+}
+#else
+#include <pthread.h>
+
+static void *SoakThreadMain(void *param)
+{
+    RunSoakWorker(param);
+    return NULL;
+}
+
+static void RunSoakThreads(SoakWorker *workers, int count)
+{
+    static pthread_t threads[SOAK_MAX_THREADS];
+    for (int i = 0; i < count; i++)
+        pthread_create(&threads[i], NULL, SoakThreadMain, &workers[i]);
+    for (int i = 0; i < count; i++)
+        pthread_join(threads[i], NULL);
+}
+#endif
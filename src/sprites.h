@@ -0,0 +1,36 @@
+// EXPLANATION:
+// Sprite atlas rectangles, generated by `make atlas` from art/sprites/, don't edit
+// Each sprite is its first frame in the atlas and the step to the next frame
+// across and down, see GetSpriteFrame() and src/atlas.c
+
+#ifndef FROGGER_SPRITES_HEADER_GUARD
+#define FROGGER_SPRITES_HEADER_GUARD
+
+// Macros
+// ----------------------------------------------------------------------------
+#define SPRITE_ATLAS_FILE "assets/textures/sprites.png"
+#define SPRITE_ATLAS_WIDTH  256
+#define SPRITE_ATLAS_HEIGHT 128
+
+#define SPRITE_CAR              CLITERAL(Sprite){ {   36,   58,   16,   16 }, {   19,   19 } } // 1x1 frames
+#define SPRITE_CAR_RACER_1      CLITERAL(Sprite){ {   55,   58,   16,   16 }, {   19,   19 } } // 1x1 frames
+#define SPRITE_CAR_RACER_2      CLITERAL(Sprite){ {   74,   58,   16,   16 }, {   19,   19 } } // 1x1 frames
+#define SPRITE_CAR_TRACTOR      CLITERAL(Sprite){ {   93,   58,   16,   16 }, {   19,   19 } } // 1x1 frames
+#define SPRITE_CAR_TRUCK        CLITERAL(Sprite){ {  191,   39,   32,   16 }, {   35,   19 } } // 1x1 frames
+#define SPRITE_CROC             CLITERAL(Sprite){ {    1,   58,   32,   16 }, {   35,   19 } } // 1x1 frames
+#define SPRITE_CROC_HEAD        CLITERAL(Sprite){ {  115,   39,   16,   16 }, {   19,   19 } } // 2x1 frames
+#define SPRITE_FLY              CLITERAL(Sprite){ {  112,   58,   16,   16 }, {   19,   19 } } // 1x1 frames
+#define SPRITE_FROG             CLITERAL(Sprite){ {  115,    1,   16,   16 }, {   19,   19 } } // 3x1 frames
+#define SPRITE_FROG_DEAD        CLITERAL(Sprite){ {  131,   58,   16,   16 }, {   19,   19 } } // 1x1 frames
+#define SPRITE_FROG_DYING       CLITERAL(Sprite){ {    1,    1,   16,   16 }, {   19,   19 } } // 3x2 frames
+#define SPRITE_GRASS_GREEN      CLITERAL(Sprite){ {   58,    1,   16,   24 }, {   19,   27 } } // 3x1 frames
+#define SPRITE_GRASS_PURPLE     CLITERAL(Sprite){ {  150,   58,   16,   16 }, {   19,   19 } } // 1x1 frames
+#define SPRITE_LEVEL            CLITERAL(Sprite){ {  188,   58,    8,    8 }, {   11,   11 } } // 1x1 frames
+#define SPRITE_LIFE             CLITERAL(Sprite){ {  199,   58,    8,    8 }, {   11,   11 } } // 1x1 frames
+#define SPRITE_LOG              CLITERAL(Sprite){ {  172,    1,   16,   16 }, {   19,   19 } } // 3x1 frames
+#define SPRITE_SCORE            CLITERAL(Sprite){ {  169,   58,   16,   16 }, {   19,   19 } } // 1x1 frames
+#define SPRITE_TURTLE           CLITERAL(Sprite){ {    1,   39,   16,   16 }, {   19,   19 } } // 3x1 frames
+#define SPRITE_TURTLE_SINK      CLITERAL(Sprite){ {   58,   39,   16,   16 }, {   19,   19 } } // 3x1 frames
+#define SPRITE_WIN_FROG         CLITERAL(Sprite){ {  153,   39,   16,   16 }, {   19,   19 } } // 2x1 frames
+
+#endif // FROGGER_SPRITES_HEADER_GUARD
@@ -0,0 +1,1120 @@
+// EXPLANATION:
+// Unit and property tests for the game rules
+// Builds the game modules headless and steps UpdateGameSimulation() directly
+//
+// Usage: frogger_tests [--ticks <n>] [--seed <n>] [--steady-frames <n>]
+// Property tests run randomized input for many ticks over several seeds,
+// a failure prints the seed and tick so it can be replayed with --seed.
+// The steady state test plays --steady-frames frames after a warmup and
+// fails on any heap allocation outside level transitions (level wins and
+// game over restarts).
+
+#include "common.h" // all project header includes
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sim_tools.h" // invariants, bot input and timer
+
+// Test settings
+#define TEST_FRAME_TIME (1.0f/60.0f)
+#define TEST_PROPERTY_SEEDS 8
+#define TEST_PROPERTY_TICKS 250000 // per seed
+#define TEST_STEADY_WARMUP_FRAMES 600
+#define TEST_STEADY_FRAMES 36000 // ten minutes of play
+#define TEST_STEADY_WIN_FRAMES 3600 // the bot can't win a level, so one is won for it every minute
+
+// Test harness
+// ----------------------------------------------------------------------------
+static int testsRun = 0;
+static int testsFailed = 0;
+static bool currentTestFailed = false;
+
+#define TEST_ASSERT(cond) do { \
+        if (!(cond)) { TestFail(__FILE__, __LINE__, #cond); return; } \
+    } while (0)
+
+#define RUN_TEST(func) RunTest(#func, func)
+
+static void TestFail(const char *file, int line, const char *expression)
+{
+    printf("    %s:%i: assertion failed: %s\n", file, line, expression);
+    currentTestFailed = true;
+}
+
+// Each test gets a fresh game context of its own
+static void RunTest(const char *name, void (*func)(GameContext *ctx))
+{
+    GameContext *ctx = calloc(1, sizeof(GameContext));
+    InitUiState(ctx);
+    InitDefaultInputSettings(ctx);
+
+    currentTestFailed = false;
+    func(ctx);
+    BindAllocTracker(NULL); // in case the test counted allocations
+
+    FreeGameState(ctx);
+    FreeUiState(ctx);
+    free(ctx);
+
+    testsRun++;
+    if (currentTestFailed) testsFailed++;
+    printf("%s %s\n", currentTestFailed? "FAIL" : "ok  ", name);
+}
+
+// Start a fresh, deterministic game on level 1 with no input
+static void ResetGame(GameContext *ctx, unsigned int seed)
+{
+    GameState *game = &ctx->game;
+
+    FreeGameState(ctx);
+    InitGameStateEx(ctx, seed);
+    game->currentScreen = SCREEN_GAMEPLAY;
+    game->frameTime = TEST_FRAME_TIME;
+    game->waitTimer = 0;
+    ctx->ui.currentMenu = UI_MENU_NONE;
+    ctx->input.player = (InputActionsPlayer){ 0 };
+}
+
+static void StepGame(GameContext *ctx, int ticks)
+{
+    for (int i = 0; i < ticks; i++)
+    {
+        ctx->game.frameCount++;
+        UpdateGameSimulation(ctx);
+        ctx->input.player = (InputActionsPlayer){ 0 }; // presses only last one frame
+    }
+}
+
+static Entity *FindEntity(GameContext *ctx, EntityType type, int row)
+{
+    GameState *game = &ctx->game;
+
+    float rowY = GetGridPosition(ctx, 0, row).y;
+    for (int i = 0; i < game->entityCount; i++)
+        if ((game->entities[i].type == type) && (game->entities[i].rec.y == rowY))
+            return &game->entities[i];
+    return NULL;
+}
+
+static Vector2 RecCenter(Rectangle rec)
+{
+    return (Vector2){ rec.x + rec.width/2, rec.y + rec.height/2 };
+}
+
+// Unit tests
+// ----------------------------------------------------------------------------
+static void TestNewGameState(GameContext *ctx)
+{
+    GameState *game = &ctx->game;
+
+    ResetGame(ctx, 1);
+    TEST_ASSERT(game->level == 1);
+    TEST_ASSERT(game->lives == 4);
+    TEST_ASSERT(game->score == 0);
+    TEST_ASSERT(game->winCount == 5);
+    TEST_ASSERT(game->frog == &game->entities[game->entityCount - 1]);
+    TEST_ASSERT(Vector2Equals(game->frog->position, game->spawnPos));
+}
+
+static void TestFrogHopScoresOncePerRow(GameContext *ctx)
+{
+    GameState *game = &ctx->game;
+    InputState *input = &ctx->input;
+
+    ResetGame(ctx, 1);
+    input->player.moveUp = true;
+    StepGame(ctx, 60);
+    TEST_ASSERT(!game->frog->isMoving);
+    TEST_ASSERT(FloatEquals(game->frog->position.y, game->spawnPos.y - GRID_UNIT));
+    TEST_ASSERT(game->score == 10);
+    TEST_ASSERT(game->rowsTravelled == 1);
+
+    // going back down and up again doesn't score the same row twice
+    input->player.moveDown = true;
+    StepGame(ctx, 60);
+    input->player.moveUp = true;
+    StepGame(ctx, 60);
+    TEST_ASSERT(game->score == 10);
+}
+
+static void TestFrogCantHopOffBottom(GameContext *ctx)
+{
+    GameState *game = &ctx->game;
+
+    ResetGame(ctx, 1);
+    ctx->input.player.moveDown = true;
+    StepGame(ctx, 60);
+    TEST_ASSERT(Vector2Equals(game->frog->position, game->spawnPos));
+    TEST_ASSERT(!game->frog->isMoving);
+}
+
+static void TestKillFrog(GameContext *ctx)
+{
+    GameState *game = &ctx->game;
+
+    ResetGame(ctx, 1);
+    KillFrog(ctx);
+    TEST_ASSERT(game->frog->isDead);
+    TEST_ASSERT(game->lives == 3);
+    TEST_ASSERT(FloatEquals(game->frog->spriteFrame.y, 1)); // land death
+    TEST_ASSERT(GetEntityAnimationFrame(ctx, game->frog) == 0);
+    StepGame(ctx, (int)(1.0f/TEST_FRAME_TIME));
+    TEST_ASSERT(GetEntityAnimationFrame(ctx, game->frog) == FROG_DEAD_FRAME); // held until the respawn
+
+    // respawns after the death timer
+    StepGame(ctx, (int)(1.0f/TEST_FRAME_TIME));
+    TEST_ASSERT(!game->frog->isDead);
+    TEST_ASSERT(Vector2Equals(game->frog->position, game->spawnPos));
+    TEST_ASSERT(game->lives == 3);
+}
+
+static void TestCarKillsFrog(GameContext *ctx)
+{
+    GameState *game = &ctx->game;
+
+    ResetGame(ctx, 1);
+    Entity *car = FindEntity(ctx, ENTITY_TYPE_CAR, 9);
+    TEST_ASSERT(car != NULL);
+    game->frog->position = RecCenter(GetEntityRec(ctx, car));
+    UpdateHostile(ctx, car);
+    TEST_ASSERT(game->frog->isDead);
+    TEST_ASSERT(game->lives == 3);
+
+    // can't die twice
+    UpdateHostile(ctx, car);
+    TEST_ASSERT(game->lives == 3);
+}
+
+static void TestCrocBitesWithMouthOpen(GameContext *ctx)
+{
+    GameState *game = &ctx->game;
+
+    ResetGame(ctx, 1);
+    game->level = 2;
+    CreateNextLevel(ctx);
+    Entity *head = NULL;
+    for (int i = 0; i < game->entityCount; i++)
+        if ((game->entities[i].type == ENTITY_TYPE_CROC) && (game->entities[i].animate.clip != NULL)) head = &game->entities[i];
+    TEST_ASSERT(head != NULL);
+
+    game->frog->position = RecCenter(GetEntityRec(ctx, head));
+    UpdateHostile(ctx, head); // starts with its mouth closed
+    TEST_ASSERT(!game->frog->isDead);
+
+    game->levelTime = head->animate.length*1.5f;
+    TEST_ASSERT(GetEntityAnimationFrame(ctx, head) == -1); // open
+    game->frog->position = RecCenter(GetEntityRec(ctx, head)); // it swam on meanwhile
+    UpdateHostile(ctx, head);
+    TEST_ASSERT(game->frog->isDead);
+}
+
+static void TestFrogDrownsInWater(GameContext *ctx)
+{
+    GameState *game = &ctx->game;
+
+    ResetGame(ctx, 1);
+    game->frog->position = RecCenter(game->background.water);
+    game->frog->position.x = game->gridStart.x + GRID_UNIT/2; // column 0 on row 7 is water
+    game->frog->position.y = GetGridPosition(ctx, 0, 7).y + GRID_UNIT/2;
+    UpdateFrog(ctx);
+    TEST_ASSERT(game->frog->isDead);
+    TEST_ASSERT(game->frog->isDrowned);
+    TEST_ASSERT(game->lives == 3);
+}
+
+static void TestUpdatePlatform(GameContext *ctx)
+{
+    GameState *game = &ctx->game;
+
+    ResetGame(ctx, 1);
+    Entity *log = FindEntity(ctx, ENTITY_TYPE_LOG, 3);
+    TEST_ASSERT(log != NULL);
+    game->frog->position = RecCenter(GetEntityRec(ctx, log));
+    UpdatePlatform(ctx, log);
+    TEST_ASSERT(game->frog->isOnPlatform);
+    TEST_ASSERT(FloatEquals(game->frog->platformMove, log->speed));
+
+    // riding the log moves the frog along with it
+    float frogX = game->frog->position.x;
+    UpdateFrog(ctx);
+    TEST_ASSERT(FloatEquals(game->frog->position.x, frogX + log->speed*game->frameTime));
+}
+
+static void TestSunkTurtleIsNotAPlatform(GameContext *ctx)
+{
+    GameState *game = &ctx->game;
+
+    ResetGame(ctx, 1);
+    Entity *turtle = NULL;
+    for (int i = 0; i < game->entityCount; i++)
+        if (game->entities[i].isSinking) turtle = &game->entities[i];
+    TEST_ASSERT(turtle != NULL);
+
+    game->frog->position = RecCenter(GetEntityRec(ctx, turtle));
+    UpdatePlatform(ctx, turtle);
+    TEST_ASSERT(game->frog->isOnPlatform); // swimming at the start of the level
+
+    // the animation is a function of the level time, skip ahead until it's fully underwater
+    for (int i = 0; (i < 1000) && (GetEntityAnimationFrame(ctx, turtle) != TURTLE_SUNK_FRAME); i++)
+        game->levelTime += 0.01;
+    TEST_ASSERT(GetEntityAnimationFrame(ctx, turtle) == TURTLE_SUNK_FRAME);
+    game->frog->position = RecCenter(GetEntityRec(ctx, turtle));
+    game->frog->isOnPlatform = false;
+    UpdatePlatform(ctx, turtle);
+    TEST_ASSERT(!game->frog->isOnPlatform);
+}
+
+static void TestWinZoneScoring(GameContext *ctx)
+{
+    GameState *game = &ctx->game;
+
+    ResetGame(ctx, 1);
+    Entity *zone = &game->entities[game->fly.entityIdx[0]];
+    TEST_ASSERT(zone->type == ENTITY_TYPE_WIN);
+
+    game->frog->position = RecCenter(zone->rec);
+    UpdateWinZone(ctx, zone, game->fly.entityIdx[0]);
+    TEST_ASSERT(zone->isWin);
+    TEST_ASSERT(zone->flags & ENTITY_FLAG_KILL); // occupied zones are lethal
+    TEST_ASSERT(game->score == 50);
+    TEST_ASSERT(game->winCount == 4);
+    TEST_ASSERT(Vector2Equals(game->frog->position, game->spawnPos));
+
+    // entering with the fly there is worth 200 more
+    Entity *flyZone = &game->entities[game->fly.entityIdx[1]];
+    game->fly.idx = 2;
+    game->frog->position = RecCenter(flyZone->rec);
+    UpdateWinZone(ctx, flyZone, game->fly.entityIdx[1]);
+    TEST_ASSERT(game->score == 50 + 250);
+    TEST_ASSERT(flyZone->scoreTimer > 0);
+    TEST_ASSERT(game->winCount == 3);
+}
+
+static void TestLevelWin(GameContext *ctx)
+{
+    GameState *game = &ctx->game;
+
+    ResetGame(ctx, 1);
+    game->winCount = 0;
+    StepGame(ctx, 1);
+    TEST_ASSERT(game->isGameWon);
+    StepGame(ctx, (int)(5.0f/TEST_FRAME_TIME));
+    TEST_ASSERT(!game->isGameWon);
+    TEST_ASSERT(game->level == 2);
+    TEST_ASSERT(game->winCount == 5);
+}
+
+static void TestGameOverResets(GameContext *ctx)
+{
+    GameState *game = &ctx->game;
+
+    ResetGame(ctx, 1);
+    game->score = 1230;
+    game->level = 3;
+    game->lives = 0;
+    StepGame(ctx, 1);
+    TEST_ASSERT(game->isGameOver);
+    TEST_ASSERT(game->hiScore == 1230);
+    StepGame(ctx, (int)(5.0f/TEST_FRAME_TIME));
+    TEST_ASSERT(!game->isGameOver);
+    TEST_ASSERT(game->level == 1);
+    TEST_ASSERT(game->lives == 4);
+    TEST_ASSERT(game->score == 0);
+    TEST_ASSERT(game->hiScore == 1230);
+}
+
+static void TestLevelArenaIsReused(GameContext *ctx)
+{
+    GameState *game = &ctx->game;
+
+    ResetGame(ctx, 1);
+    TEST_ASSERT(game->entityCount == CountLevelEntities(1));
+
+    // Visit both layouts once, then level changes reuse the same memory
+    game->level = 2;
+    CreateNextLevel(ctx);
+    TEST_ASSERT(game->entityCount == CountLevelEntities(2));
+    Region *regions = game->levelArena.begin;
+    Region *lastRegion = game->levelArena.end;
+
+    for (int level = 1; level <= 4; level++)
+    {
+        game->level = level;
+        CreateNextLevel(ctx);
+        TEST_ASSERT(game->entityCount == game->entityCapacity);
+        TEST_ASSERT(game->frog == &game->entities[game->entityCount - 1]);
+        TEST_ASSERT(game->levelArena.begin == regions);
+        TEST_ASSERT(game->levelArena.end == lastRegion);
+    }
+}
+
+static void TestEntityRecWraps(GameContext *ctx)
+{
+    GameState *game = &ctx->game;
+    Rectangle recs[2];
+
+    ResetGame(ctx, 1);
+    Entity *car = FindEntity(ctx, ENTITY_TYPE_CAR, 10);
+    TEST_ASSERT((car != NULL) && (car->speed > 0));
+    Rectangle spawn = car->rec;
+
+    // placed from the level time, the entity itself is never written
+    game->levelTime = 2;
+    TEST_ASSERT(FloatEquals(GetEntityRec(ctx, car).x, spawn.x + car->speed*2));
+    StepGame(ctx, 60);
+    TEST_ASSERT(car->rec.x == spawn.x);
+
+    // straddling the right edge, on both sides
+    game->levelTime = (game->gridStart.x + GRID_WIDTH - spawn.width/2 - spawn.x)/car->speed;
+    TEST_ASSERT(GetEntityRecs(ctx, car, recs) == 2);
+    TEST_ASSERT(fabsf(recs[0].x - (game->gridStart.x + GRID_WIDTH - spawn.width/2)) < 0.001f);
+    TEST_ASSERT(FloatEquals(recs[1].x, recs[0].x - GRID_WIDTH));
+
+    // fully past the right edge, back on the left side
+    game->levelTime = (game->gridStart.x + GRID_WIDTH + 1 - spawn.x)/car->speed;
+    TEST_ASSERT(GetEntityRecs(ctx, car, recs) == 1);
+    TEST_ASSERT(fabsf(recs[0].x - (game->gridStart.x + 1)) < 0.001f);
+}
+
+static void TestGridWrapCopies(GameContext *ctx)
+{
+    GameState *game = &ctx->game;
+
+    ResetGame(ctx, 1);
+    float left = game->gridStart.x;
+    float right = left + GRID_WIDTH;
+    float offsets[2];
+
+    // inside the grid, a single copy
+    TEST_ASSERT(GetGridWrapOffsets(ctx, left + GRID_UNIT, GRID_UNIT, offsets) == 1);
+    TEST_ASSERT(offsets[0] == 0);
+
+    // across the right edge, the part past it shows on the left
+    TEST_ASSERT(GetGridWrapOffsets(ctx, right - GRID_UNIT/2, GRID_UNIT, offsets) == 2);
+    TEST_ASSERT((offsets[0] == 0) && (offsets[1] == -GRID_WIDTH));
+
+    // across the left edge, the part past it shows on the right
+    TEST_ASSERT(GetGridWrapOffsets(ctx, left - GRID_UNIT/2, GRID_UNIT, offsets) == 2);
+    TEST_ASSERT((offsets[0] == 0) && (offsets[1] == GRID_WIDTH));
+
+    // fully outside, only the copy on the other side
+    TEST_ASSERT(GetGridWrapOffsets(ctx, left - GRID_UNIT*2, GRID_UNIT, offsets) == 1);
+    TEST_ASSERT(offsets[0] == GRID_WIDTH);
+    TEST_ASSERT(GetGridWrapOffsets(ctx, right + GRID_UNIT, GRID_UNIT, offsets) == 1);
+    TEST_ASSERT(offsets[0] == -GRID_WIDTH);
+}
+
+// Each lane strip entity is drawn where GetEntityRec() places it: its baked
+// texel scrolled by the strip, at level start and after moving for a while
+static void TestLaneStripsMatchEntities(GameContext *ctx)
+{
+    GameState *game = &ctx->game;
+    LaneStrips *lanes = &ctx->lanes;
+
+    for (int level = 1; level <= 2; level++)
+    {
+        ResetGame(ctx, 1);
+        game->level = level;
+        CreateNextLevel(ctx);
+        TEST_ASSERT(lanes->stripCount == 10); // row 3 in level 2 is logs and a croc in one lane
+
+        for (int pass = 0; pass < 2; pass++)
+        {
+            if (pass == 1) StepGame(ctx, 60*60);
+
+            for (int i = 0; i < game->entityCount; i++)
+            {
+                Entity *e = &game->entities[i];
+                bool isStatic = (e->flags & ENTITY_FLAG_MOVE) && (e->animate.clip == NULL);
+                TEST_ASSERT(isStatic == (e->laneIdx >= 0));
+                if (e->laneIdx < 0) continue;
+
+                LaneStrip *strip = &lanes->strips[e->laneIdx];
+                TEST_ASSERT((strip->y == e->rec.y) && (strip->speed == e->speed));
+
+                float scroll = GetLaneStripScroll(ctx, strip);
+                TEST_ASSERT((scroll >= 0) && (scroll < LANE_STRIP_WIDTH));
+
+                // texels from the grid's left edge, drawn and simulated
+                float drawn = Wrap(GetLaneEntityTexel(ctx, e) + scroll, 0, LANE_STRIP_WIDTH);
+                float placed = Wrap((GetEntityRec(ctx, e).x - game->gridStart.x)*LANE_STRIP_SCALE, 0, LANE_STRIP_WIDTH);
+                float error = fabsf(drawn - placed);
+                TEST_ASSERT(fminf(error, LANE_STRIP_WIDTH - error) < 0.01f);
+            }
+        }
+    }
+}
+
+// Finds the actions bound to a key in the compiled lookup, or 0
+static InputActionMask FindKeyBinding(GameContext *ctx, KeyboardKey key)
+{
+    InputBindingTable *table = &ctx->inputMaps.bindings;
+
+    for (int i = 0; i < table->keyCount; i++)
+        if (table->keys[i].code == (int)key)
+            return table->keys[i].actions;
+    return 0;
+}
+
+static void TestInputBindingTable(GameContext *ctx)
+{
+    InputBindingTable *table = &ctx->inputMaps.bindings;
+
+    // keys shared by several actions are listed once
+    TEST_ASSERT(FindKeyBinding(ctx, KEY_W) == (INPUT_ACTION_BIT(INPUT_ACTION_MENU_UP) | INPUT_ACTION_BIT(INPUT_ACTION_UP)));
+    TEST_ASSERT(FindKeyBinding(ctx, KEY_ESCAPE) == (INPUT_ACTION_BIT(INPUT_ACTION_CANCEL) | INPUT_ACTION_BIT(INPUT_ACTION_PAUSE)));
+
+    // a key in a combination isn't bound by itself
+    TEST_ASSERT(FindKeyBinding(ctx, KEY_ENTER) == INPUT_ACTION_BIT(INPUT_ACTION_CONFIRM));
+    TEST_ASSERT(FindKeyBinding(ctx, KEY_LEFT_ALT) == 0);
+    TEST_ASSERT(table->comboCount == 4);
+    TEST_ASSERT((table->combos[0].modifier == KEY_LEFT_ALT) && (table->combos[0].key == KEY_ENTER));
+    TEST_ASSERT(table->combos[0].actions == INPUT_ACTION_BIT(INPUT_ACTION_FULLSCREEN));
+
+    // changing the maps recompiles the lookup
+    int buttonCount = table->gamepadButtonCount;
+    AddInputActionGamepadButton(ctx, INPUT_ACTION_PAUSE, GAMEPAD_BUTTON_L2);
+    TEST_ASSERT(table->gamepadButtonCount == buttonCount + 1);
+    TEST_ASSERT(table->axisActions & INPUT_ACTION_BIT(INPUT_ACTION_UP));
+}
+
+// A key tapped and released between two frames still moves the frog
+static void TestQueuedTapIsNotLost(GameContext *ctx)
+{
+    GameState *game = &ctx->game;
+    InputState *input = &ctx->input;
+
+    ResetGame(ctx, 1);
+    PushInputEvent(ctx, (InputEvent){ 1.0, KEY_UP, true });
+    PushInputEvent(ctx, (InputEvent){ 1.01, KEY_UP, false });
+    UpdateInputFrame(ctx);
+    TEST_ASSERT(input->player.moveUp);
+    TEST_ASSERT(input->moveEventTime == 1.0);
+    TEST_ASSERT(input->eventCount == 0);
+
+    game->frameCount++;
+    UpdateGameSimulation(ctx);
+    TEST_ASSERT(game->frog->isMoving);
+
+    // the queue is drained, so the next frame has no press
+    UpdateInputFrame(ctx);
+    TEST_ASSERT(!input->player.moveUp);
+    TEST_ASSERT(input->moveEventTime == 0);
+}
+
+// A menu change polls the input again, the frame's queued tap is still pressed
+static void TestQueuedTapSurvivesMenuChange(GameContext *ctx)
+{
+    InputState *input = &ctx->input;
+
+    ResetGame(ctx, 1);
+    PushInputEvent(ctx, (InputEvent){ 1.0, KEY_UP, true });
+    PushInputEvent(ctx, (InputEvent){ 1.01, KEY_UP, false });
+    PushInputEvent(ctx, (InputEvent){ 1.02, KEY_ENTER, true });
+    PushInputEvent(ctx, (InputEvent){ 1.03, KEY_ENTER, false });
+    UpdateInputFrame(ctx);
+    TEST_ASSERT(input->player.moveUp);
+
+    ChangeUiMenu(ctx, UI_MENU_PAUSE);
+    TEST_ASSERT(input->menu.confirm);
+    TEST_ASSERT(input->player.moveUp);
+    TEST_ASSERT(input->moveEventTime == 1.0);
+
+    ChangeUiMenu(ctx, UI_MENU_NONE);
+    UpdateInputFrame(ctx);
+    TEST_ASSERT(!input->menu.confirm);
+    TEST_ASSERT(!input->player.moveUp);
+}
+
+// A move press is followed through each frame stage in order
+static void TestLatencyStages(GameContext *ctx)
+{
+    LatencyTracker *latency = &ctx->latency;
+
+    ResetGame(ctx, 1);
+    *latency = (LatencyTracker){ 0 };
+    ctx->game.isDebugMode = true;
+
+    BeginLatencySample(ctx, 1.000, 1.004);
+    MarkLatencyStage(ctx, LATENCY_STAGE_DRAW, 1.005); // no hop yet, ignored
+    MarkLatencyMove(ctx, 0.5, 1.006);                 // hop from another press, ignored
+    MarkLatencyMove(ctx, 1.000, 1.008);
+    BeginLatencySample(ctx, 1.010, 1.010);            // already following a move
+    MarkLatencyStage(ctx, LATENCY_STAGE_DRAW, 1.012);
+    MarkLatencyStage(ctx, LATENCY_STAGE_PRESENT, 1.020);
+
+    TEST_ASSERT(latency->sampleCount == 1);
+    TEST_ASSERT(latency->nextStage == LATENCY_STAGE_POLL);
+    TEST_ASSERT(fabsf(latency->stats[LATENCY_STAGE_POLL].p50 - 4.0f) < 0.01f);
+    TEST_ASSERT(fabsf(latency->stats[LATENCY_STAGE_MOVE].p50 - 4.0f) < 0.01f);
+    TEST_ASSERT(fabsf(latency->stats[LATENCY_STAGE_DRAW].p50 - 4.0f) < 0.01f);
+    TEST_ASSERT(fabsf(latency->stats[LATENCY_STAGE_PRESENT].p50 - 8.0f) < 0.01f);
+    TEST_ASSERT(fabsf(latency->stats[LATENCY_SERIES_TOTAL].p50 - 20.0f) < 0.01f);
+
+    // off outside debug mode
+    ctx->game.isDebugMode = false;
+    BeginLatencySample(ctx, 2.0, 2.0);
+    TEST_ASSERT(latency->nextStage == LATENCY_STAGE_POLL);
+}
+
+// The HUD score text follows the score, and is only rewritten when it changes
+static void TestHudScoreText(GameContext *ctx)
+{
+    GameState *game = &ctx->game;
+    UiState *ui = &ctx->ui;
+
+    ResetGame(ctx, 1);
+    UpdateUiHud(ctx);
+    TEST_ASSERT(!strcmp(ui->scoreNum.text, "0"));
+
+    game->score = 120;
+    UpdateUiHud(ctx);
+    TEST_ASSERT(!strcmp(ui->scoreNum.text, "120"));
+    TEST_ASSERT(ui->hudScore == 120);
+
+    strcpy(ui->scoreNum.text, "x"); // unchanged score, the text is left alone
+    UpdateUiHud(ctx);
+    TEST_ASSERT(!strcmp(ui->scoreNum.text, "x"));
+}
+
+// Text runs lay out glyphs like DrawTextEx(), and only again when something changes
+static void TestTextRunLayout(GameContext *ctx)
+{
+    (void)ctx;
+    GlyphInfo glyphs[3] = { { .value = ' ', .advanceX = 4 }, { .value = 'A', .offsetY = 1 }, { .value = 'B', .advanceX = 6 } };
+    Rectangle recs[3] = { { 0, 0, 4, 8 }, { 10, 0, 5, 8 }, { 20, 0, 6, 8 } };
+    Font font = { .baseSize = 8, .glyphCount = 3, .glyphPadding = 0, .texture.id = 1, .recs = recs, .glyphs = glyphs };
+    TextRun run = { 0 };
+
+    TEST_ASSERT(UpdateTextRun(&run, font, "A B", (Vector2){ 100, 50 }, 16, 2));
+    TEST_ASSERT(run.quadCount == 2); // no quad for the space
+    TEST_ASSERT((run.quads[0].dest.x == 100) && (run.quads[0].dest.y == 52) && (run.quads[0].dest.width == 10));
+    TEST_ASSERT(run.quads[0].src.x == 10);
+    TEST_ASSERT(run.quads[1].dest.x == 100 + (10 + 2) + (8 + 2)); // 'A' has no advance, uses its width
+    TEST_ASSERT(run.quads[1].src.x == 20);
+
+    TEST_ASSERT(!UpdateTextRun(&run, font, "A B", (Vector2){ 100, 50 }, 16, 2));
+    TEST_ASSERT(UpdateTextRun(&run, font, "AB", (Vector2){ 100, 50 }, 16, 2));
+    TEST_ASSERT(UpdateTextRun(&run, font, "AB", (Vector2){ 100, 50 }, 32, 2));
+}
+
+typedef struct { Sprite sprite; int cols, rows; } AtlasFrames;
+
+static void CheckAtlasFrames(const AtlasFrames *sprites, int count, Rectangle atlas)
+{
+    for (int i = 0; i < count; i++)
+    {
+        for (int frame = 0; frame < sprites[i].cols*sprites[i].rows; frame++)
+        {
+            Rectangle rec = GetSpriteFrame(sprites[i].sprite, (Vector2){ (float)(frame%sprites[i].cols), (float)(frame/sprites[i].cols) });
+            Rectangle border = { rec.x - 1, rec.y - 1, rec.width + 2, rec.height + 2 }; // extruded edge
+            TEST_ASSERT((border.x >= 0) && (border.y >= 0) &&
+                        (border.x + border.width <= atlas.width) && (border.y + border.height <= atlas.height));
+
+            for (int j = 0; j < i; j++)
+            {
+                Rectangle other = sprites[j].sprite.rec; // all its frames and their borders, without the last gap
+                other.x -= 1;
+                other.y -= 1;
+                other.width = sprites[j].cols*sprites[j].sprite.stride.x - 1;
+                other.height = sprites[j].rows*sprites[j].sprite.stride.y - 1;
+                TEST_ASSERT(!CheckCollisionRecs(border, other));
+            }
+        }
+    }
+}
+
+// Every frame the game steps to stays inside its atlas, clear of every other sprite's frames
+static void TestSpriteFramesInAtlas(GameContext *ctx)
+{
+    (void)ctx;
+    AtlasFrames sprites[] = {
+        { SPRITE_FROG, 3, 1 }, { SPRITE_FROG_DYING, 3, 2 }, { SPRITE_FROG_DEAD, 1, 1 }, { SPRITE_TURTLE, 3, 1 },
+        { SPRITE_TURTLE_SINK, 3, 1 }, { SPRITE_LOG, 3, 1 }, { SPRITE_CROC, 1, 1 }, { SPRITE_CROC_HEAD, 2, 1 },
+        { SPRITE_CAR, 1, 1 }, { SPRITE_CAR_TRUCK, 1, 1 }, { SPRITE_GRASS_GREEN, 3, 1 }, { SPRITE_GRASS_PURPLE, 1, 1 },
+        { SPRITE_WIN_FROG, 2, 1 }, { SPRITE_FLY, 1, 1 }, { SPRITE_SCORE, 1, 1 }, { SPRITE_LIFE, 1, 1 },
+        { SPRITE_LEVEL, 1, 1 },
+    };
+    AtlasFrames controls[] = {
+        { CONTROL_DPAD, 1, 1 }, { CONTROL_PAUSE, 1, 1 }, { CONTROL_ANALOG_BASE, 1, 1 }, { CONTROL_ANALOG_STICK, 1, 1 },
+    };
+
+    CheckAtlasFrames(sprites, (int)(sizeof(sprites)/sizeof(sprites[0])),
+                     (Rectangle){ 0, 0, SPRITE_ATLAS_WIDTH, SPRITE_ATLAS_HEIGHT });
+    CheckAtlasFrames(controls, (int)(sizeof(controls)/sizeof(controls[0])),
+                     (Rectangle){ 0, 0, CONTROL_ATLAS_WIDTH, CONTROL_ATLAS_HEIGHT });
+}
+
+// Packed files are found by name, aligned and NUL terminated, and bad archives are refused
+static void TestAssetArchive(GameContext *ctx)
+{
+    (void)ctx;
+    const char *names[3] = { "assets/b.fs", "assets/a.wav", "assets/c.png" };
+    const unsigned char *files[3] = { (const unsigned char *)"void main() {}", (const unsigned char *)"RIFF", (const unsigned char *)"\x89PNG\0x" };
+    int sizes[3] = { 14, 4, 6 };
+
+    int size = 0;
+    unsigned char *data = PackAssetArchive(names, files, sizes, 3, &size);
+    AssetArchive archive;
+    TEST_ASSERT(OpenAssetArchive(&archive, data, size));
+    TEST_ASSERT(archive.entryCount == 3);
+    TEST_ASSERT(!strcmp(archive.entries[0].name, "assets/a.wav")); // sorted
+
+    for (int i = 0; i < 3; i++)
+    {
+        int fileSize = 0;
+        const unsigned char *file = FindAssetArchiveEntry(&archive, names[i], &fileSize);
+        TEST_ASSERT((file != NULL) && (fileSize == sizes[i]));
+        TEST_ASSERT(!memcmp(file, files[i], sizes[i]) && (file[fileSize] == '\0'));
+        TEST_ASSERT((file - data) % ASSET_ARCHIVE_ALIGN == 0);
+    }
+    TEST_ASSERT(FindAssetArchiveEntry(&archive, "assets/missing.wav", &size) == NULL);
+
+    TEST_ASSERT(!OpenAssetArchive(&archive, data, size - 1)); // truncated
+    data[0] = 'X';
+    TEST_ASSERT(!OpenAssetArchive(&archive, data, size));
+    MemFree(data);
+
+    const char *duplicates[2] = { "assets/a.wav", "assets/a.wav" };
+    TEST_ASSERT(PackAssetArchive(duplicates, files, sizes, 2, &size) == NULL);
+
+    // Unsorted input where sorting changes the padding, the size must follow the sorted layout
+    const char *unsorted[2] = { "b", "a" };
+    const unsigned char *aligned[2] = { (const unsigned char *)"fifteen bytes..", (const unsigned char *)"sixteen bytes..." };
+    int alignedSizes[2] = { 15, 16 };
+    data = PackAssetArchive(unsorted, aligned, alignedSizes, 2, &size);
+    TEST_ASSERT(OpenAssetArchive(&archive, data, size));
+    const AssetArchiveEntry *last = &archive.entries[archive.entryCount - 1];
+    TEST_ASSERT((int)(last->offset + last->size + 1) == size);
+    for (int i = 0; i < 2; i++)
+    {
+        int fileSize = 0;
+        const unsigned char *file = FindAssetArchiveEntry(&archive, unsorted[i], &fileSize);
+        TEST_ASSERT((file != NULL) && (fileSize == alignedSizes[i]) && !memcmp(file, aligned[i], fileSize));
+    }
+    MemFree(data);
+}
+
+// The streaming decoder gives raylib's samples, in any read sizes and again after a rewind
+static void TestQoaDecoder(GameContext *ctx)
+{
+    (void)ctx;
+    const char *fileName = "assets/audio/music_intro.qoa";
+    static QoaDecoder qoa; // too big for the stack
+    TEST_ASSERT(OpenQoaDecoder(&qoa, fileName));
+    TEST_ASSERT((qoa.channels == 1) && (qoa.sampleRate == 44100));
+
+    Wave wave = LoadWave(fileName);
+    TEST_ASSERT(wave.frameCount == qoa.frameCount);
+    short *samples = MemAlloc(qoa.frameCount*sizeof(short));
+    for (int pass = 0; pass < 2; pass++)
+    {
+        int readSize = (pass == 0)? 777 : QOA_FRAME_LEN + 1; // across QOA frame edges
+        int count = 0, read = 0;
+        while ((read = ReadQoaDecoder(&qoa, samples + count, readSize)) > 0) count += read;
+        TEST_ASSERT(count == (int)qoa.frameCount);
+        TEST_ASSERT(!memcmp(samples, wave.data, count*sizeof(short)));
+        RewindQoaDecoder(&qoa);
+    }
+    MemFree(samples);
+    UnloadWave(wave);
+    CloseQoaDecoder(&qoa);
+}
+
+// Pushed sounds are mixed on the other side of the queue, and a full queue drops events
+static void TestAudioMixerQueue(GameContext *ctx)
+{
+    AudioMixer *mixer = &ctx->audio;
+
+    short samples[4] = { 1000, 2000, -3000, 4000 };
+    GameSound sound = { .wave = { .frameCount = 4, .sampleRate = AUDIO_SAMPLE_RATE, .sampleSize = 16, .channels = 1, .data = samples },
+                        .volume = 0.5f };
+    short out[6] = { 0 };
+
+    *mixer = (AudioMixer){ 0 };
+    PlayGameSound(ctx, &sound); // no mixer, dropped before the queue
+    TEST_ASSERT(mixer->queue.writeIdx == 0);
+
+    mixer->isEnabled = true; // mixed by hand instead of by a stream
+    PlayGameSound(ctx, &sound);
+    MixAudioFrames(mixer, out, 3);
+    TEST_ASSERT((out[0] == 500) && (out[1] == 1000) && (out[2] == -1500));
+    PlayGameSound(ctx, &sound); // restarts it
+    PlayGameSound(ctx, &sound);
+    MixAudioFrames(mixer, out, 6);
+    TEST_ASSERT((out[0] == 500) && (out[3] == 2000) && (out[4] == 0) && (out[5] == 0));
+
+    for (int i = 0; i < AUDIO_EVENT_QUEUE_SIZE + 2; i++) PlayGameSound(ctx, &sound);
+    TEST_ASSERT(mixer->droppedCount == 2);
+    MixAudioFrames(mixer, out, 1);
+    TEST_ASSERT(mixer->queue.readIdx == mixer->queue.writeIdx);
+
+    *mixer = (AudioMixer){ 0 };
+}
+
+static int CountAudioVoices(AudioMixer *mixer, const GameSound *sound)
+{
+    int count = 0;
+    for (int i = 0; i < AUDIO_MIXER_VOICES; i++) count += (mixer->voices[i].sound == sound);
+    return count;
+}
+
+// Instances are capped per sound, a full pool gives way to higher priorities only
+static void TestAudioVoiceStealing(GameContext *ctx)
+{
+    AudioMixer *mixer = &ctx->audio;
+
+    short samples[100] = { 0 };
+    Wave wave = { .frameCount = 100, .sampleRate = AUDIO_SAMPLE_RATE, .sampleSize = 16, .channels = 1, .data = samples };
+    GameSound hop = { .wave = wave, .volume = 1.0f, .maxVoices = 2, .priority = AUDIO_PRIORITY_LOW };
+    GameSound low = { .wave = wave, .volume = 1.0f, .maxVoices = AUDIO_MIXER_VOICES, .priority = AUDIO_PRIORITY_LOW };
+    GameSound high = { .wave = wave, .volume = 1.0f, .maxVoices = AUDIO_MIXER_VOICES, .priority = AUDIO_PRIORITY_HIGH };
+    short out[1];
+
+    *mixer = (AudioMixer){ .isEnabled = true };
+    for (int i = 0; i < 3; i++)
+    {
+        PlayGameSound(ctx, &hop);
+        MixAudioFrames(mixer, out, 1);
+    }
+    TEST_ASSERT(CountAudioVoices(mixer, &hop) == 2); // the third restarted the oldest
+    TEST_ASSERT((mixer->stolenCount == 0) && (mixer->skippedCount == 0));
+
+    for (int i = 0; i < AUDIO_MIXER_VOICES - 2; i++) PlayGameSound(ctx, &low);
+    MixAudioFrames(mixer, out, 1);
+    TEST_ASSERT(mixer->voiceCount == AUDIO_MIXER_VOICES);
+
+    PlayGameSound(ctx, &high); // steals the furthest along low voice, a hop
+    MixAudioFrames(mixer, out, 1);
+    TEST_ASSERT((CountAudioVoices(mixer, &high) == 1) && (CountAudioVoices(mixer, &hop) == 1));
+    TEST_ASSERT(mixer->stolenCount == 1);
+
+    for (int i = 0; i < AUDIO_MIXER_VOICES - 1; i++) PlayGameSound(ctx, &high);
+    PlayGameSound(ctx, &low); // nothing it may take
+    MixAudioFrames(mixer, out, 1);
+    TEST_ASSERT(CountAudioVoices(mixer, &high) == AUDIO_MIXER_VOICES);
+    TEST_ASSERT((mixer->stolenCount == AUDIO_MIXER_VOICES) && (mixer->skippedCount == 1));
+    TEST_ASSERT(mixer->voiceCountMax == AUDIO_MIXER_VOICES);
+
+    *mixer = (AudioMixer){ 0 };
+}
+
+static void SquareJob(void *data)
+{
+    int *value = data;
+    *value *= *value;
+}
+
+// Every job runs exactly once across the workers and the waiting thread
+static void TestJobQueue(GameContext *ctx)
+{
+    (void)ctx;
+    static JobQueue queue; // too big for the stack
+    int values[JOB_QUEUE_MAX_JOBS];
+
+    for (int round = 0; round < 2; round++) // reusable after a reset
+    {
+        ResetJobQueue(&queue);
+        for (int i = 0; i < JOB_QUEUE_MAX_JOBS; i++)
+        {
+            values[i] = i;
+            TEST_ASSERT(AddJob(&queue, SquareJob, &values[i]) == i);
+        }
+        TEST_ASSERT(AddJob(&queue, SquareJob, &values[0]) == -1); // full
+
+        StartJobThreads(&queue, 4);
+        WaitJobs(&queue);
+        for (int i = 0; i < JOB_QUEUE_MAX_JOBS; i++)
+            TEST_ASSERT(IsJobDone(&queue, i) && (values[i] == i*i));
+    }
+    ResetJobQueue(&queue);
+}
+
+// Frame memory is reused every frame, and kept pointers are caught in debug mode
+static void TestFrameArenaReset(GameContext *ctx)
+{
+    FrameArena *frame = &ctx->frame;
+
+    ResetGame(ctx, 1);
+    ctx->game.isDebugMode = true;
+
+    ResetFrameArena(ctx);
+    char *text = FrameTextFormat(ctx, "SCORE %i", 120);
+    TEST_ASSERT(!strcmp(text, "SCORE 120"));
+    TEST_ASSERT(IsFrameAllocValid(ctx, text));
+    int *values = FrameAllocArray(ctx, int, 4);
+    TEST_ASSERT((values[0] == 0) && (values[3] == 0));
+    TEST_ASSERT(frame->allocCount == 2);
+
+    ResetFrameArena(ctx);
+    TEST_ASSERT((unsigned char)text[0] == FRAME_ARENA_POISON);
+    SetTraceLogLevel(LOG_NONE);
+    TEST_ASSERT(!IsFrameAllocValid(ctx, text));
+    SetTraceLogLevel(LOG_WARNING);
+    TEST_ASSERT(frame->staleCount == 1);
+    TEST_ASSERT(frame->highWaterAllocs == 2);
+
+    // Same memory next frame, no new regions
+    Region *region = frame->arena.begin;
+    TEST_ASSERT(FrameTextFormat(ctx, "SCORE %i", 120) == text);
+    for (int i = 0; i < 100; i++)
+    {
+        ResetFrameArena(ctx);
+        FrameAllocArray(ctx, Vector2, 64);
+    }
+    TEST_ASSERT((frame->arena.begin == region) && (region->next == NULL));
+
+    FreeFrameArena(ctx);
+    ctx->game.isDebugMode = false;
+}
+
+// The touch gamepad hit map gives the same controls as testing each one exactly
+static void TestTouchGamepadHitMap(GameContext *ctx)
+{
+    UiGamepad *gamepad = &ctx->ui.gamepad;
+    InputState *input = &ctx->input;
+
+    UpdateUiGamepadLayout(ctx, 1280, 720, 1.125f);
+    for (float y = 0; y < 720; y += 3)
+    {
+        for (float x = 0; x < 1280; x += 3)
+        {
+            Vector2 point = { x, y };
+            unsigned int expected = 0;
+            for (int i = 0; i < 4; i++)
+                if (CheckCollisionPointRec(point, gamepad->dpad.button[i])) expected |= (1u << (UI_GAMEPAD_DPAD_UP + i));
+            if (CheckCollisionPointCircle(point, gamepad->pause.position, gamepad->pause.radius)) expected |= (1u << UI_GAMEPAD_PAUSE);
+            if (CheckCollisionPointCircle(point, gamepad->stick.centerPos, gamepad->stick.centerRadius)) expected |= (1u << UI_GAMEPAD_STICK);
+            TEST_ASSERT(GetUiGamepadHits(ctx, point) == expected);
+        }
+    }
+
+    // touch points resolve to their control
+    input->touchCount = 2;
+    input->touchPoints[0].gamepadHits = GetUiGamepadHits(ctx, (Vector2){ 10, 10 });
+    input->touchPoints[1].gamepadHits = GetUiGamepadHits(ctx, gamepad->pause.position);
+    TEST_ASSERT(FindUiGamepadTouch(ctx, UI_GAMEPAD_PAUSE) == 1);
+    TEST_ASSERT(FindUiGamepadTouch(ctx, UI_GAMEPAD_DPAD_UP) == -1);
+    input->touchCount = 0;
+}
+
+// The pacer sleeps so the slowest recent frame still ends before the next vblank
+static void TestFramePacerSleep(GameContext *ctx)
+{
+    FramePacer *pacer = &ctx->pacer;
+    const double period = 1.0/60.0;
+
+    InitFramePacer(ctx);
+    pacer->enabled = true;
+    TEST_ASSERT(GetFramePacerSleep(ctx, period, 1.0) == 0); // nothing presented yet
+
+    MarkFramePacerWorkStart(ctx, 0.990);
+    MarkFramePacerWorkDone(ctx, 0.992);
+    MarkFramePacerPresent(ctx, 1.0);
+    double sleep = GetFramePacerSleep(ctx, period, 1.0);
+    TEST_ASSERT(fabs(sleep - (period - 0.002 - FRAME_PACER_MIN_MARGIN)) < 1e-6);
+
+    // a skipped vblank leaves more room
+    MarkFramePacerPresent(ctx, 1.0 + period*2);
+    TEST_ASSERT(pacer->missedCount == 1);
+    TEST_ASSERT(pacer->margin > FRAME_PACER_MIN_MARGIN);
+
+    TEST_ASSERT(GetFramePacerSleep(ctx, 0, 1.0 + period*2) == 0); // vsync off
+    pacer->enabled = false;
+    TEST_ASSERT(GetFramePacerSleep(ctx, period, 1.0 + period*2) == 0);
+}
+
+static void TestSameSeedSameGame(GameContext *ctx)
+{
+    unsigned int seed = 99;
+    int fly[2][64];
+    for (int run = 0; run < 2; run++)
+    {
+        ResetGame(ctx, seed);
+        for (int i = 0; i < 64; i++)
+        {
+            StepGame(ctx, 30);
+            fly[run][i] = ctx->game.fly.idx;
+        }
+    }
+    TEST_ASSERT(memcmp(fly[0], fly[1], sizeof(fly[0])) == 0);
+}
+
+// Two games stepped in lockstep play out the same as each other, so no state is shared
+static void TestContextsAreIndependent(GameContext *ctx)
+{
+    GameContext *other = calloc(1, sizeof(GameContext));
+    InitUiState(other);
+    InitDefaultInputSettings(other);
+
+    ResetGame(ctx, 7);
+    ResetGame(other, 7);
+    unsigned int botState = 7, otherBotState = 7;
+    bool same = true;
+    for (int tick = 0; (tick < 20000) && same; tick++)
+    {
+        SetBotInput(ctx, BOT_INPUT_HOP, &botState);
+        SetBotInput(other, BOT_INPUT_HOP, &otherBotState);
+        UpdateGameSimulation(ctx);
+        UpdateGameSimulation(other);
+
+        same = (ctx->game.score == other->game.score) && (ctx->game.lives == other->game.lives) &&
+               (ctx->game.fly.idx == other->game.fly.idx) &&
+               Vector2Equals(ctx->game.frog->position, other->game.frog->position);
+    }
+
+    FreeGameState(other);
+    FreeUiState(other);
+    free(other);
+
+    TEST_ASSERT(same);
+    TEST_ASSERT(ctx->game.score > 0);
+}
+
+// Steady state allocations
+// ----------------------------------------------------------------------------
+static unsigned int steadyFrames = TEST_STEADY_FRAMES;
+
+// Full game frames with the greedy bot, which loses games but never clears a
+// level, so the win zones are filled for it like TestLevelWin() does. Only
+// level transitions may allocate once the game has warmed up
+static void TestSteadyStateDoesntAllocate(GameContext *ctx)
+{
+    GameState *game = &ctx->game;
+    AllocTracker *alloc = &ctx->alloc;
+    unsigned int botState = 1;
+    int levelWins = 0;
+
+    BindAllocTracker(ctx);
+    ResetGame(ctx, 1);
+    for (unsigned int frame = 0; frame < TEST_STEADY_WARMUP_FRAMES + steadyFrames; frame++)
+    {
+        if (frame == TEST_STEADY_WARMUP_FRAMES) *alloc = (AllocTracker){ 0 };
+        if ((frame > TEST_STEADY_WARMUP_FRAMES) && ((frame - TEST_STEADY_WARMUP_FRAMES) % TEST_STEADY_WIN_FRAMES == 0) &&
+            !game->isGameWon && !game->isGameOver)
+            game->winCount = 0;
+
+        int level = game->level;
+        game->frameCount++;
+        SetAllocScope(ctx, ALLOC_SCOPE_UPDATE);
+        SetBotInput(ctx, BOT_INPUT_GREEDY, &botState);
+        UpdateGameFrame(ctx);
+        SetAllocScope(ctx, ALLOC_SCOPE_OTHER);
+        EndAllocFrame(ctx);
+        if ((frame >= TEST_STEADY_WARMUP_FRAMES) && (game->level > level)) levelWins++;
+
+        if (GetSteadyAllocCount(ctx) > 0)
+        {
+            printf("    frame %u: %i allocations outside level transitions\n", frame, GetSteadyAllocCount(ctx));
+            if (frame >= TEST_STEADY_WARMUP_FRAMES) break;
+        }
+    }
+
+    TEST_ASSERT(alloc->steadyFrames == (int)steadyFrames);
+    TEST_ASSERT(alloc->totalCounts[ALLOC_SCOPE_UPDATE] == 0);
+    TEST_ASSERT((levelWins > 0) || (steadyFrames < TEST_STEADY_WIN_FRAMES + 300)); // a win takes 4.5s to move on
+}
+
+// Property tests
+// ----------------------------------------------------------------------------
+static unsigned int propertyTicks = TEST_PROPERTY_TICKS;
+static unsigned int propertySeed = 0; // 0 = run all default seeds
+
+// Odd seeds play with the hopping bot, even seeds with the greedy bot
+static bool RunPropertySeed(GameContext *ctx, unsigned int seed)
+{
+    BotInputMode mode = (seed % 2)? BOT_INPUT_HOP : BOT_INPUT_GREEDY;
+    ResetGame(ctx, seed);
+    unsigned int botState = seed*2654435761u + 1;
+
+    for (unsigned int tick = 0; tick < propertyTicks; tick++)
+    {
+        SetBotInput(ctx, mode, &botState);
+
+        InvariantSnapshot prev;
+        TakeInvariantSnapshot(ctx, &prev);
+        ctx->game.frameCount++;
+        UpdateGameSimulation(ctx);
+
+        const char *failed = CheckGameInvariants(ctx, &prev);
+        if (failed)
+        {
+            printf("    seed %u, tick %u: property failed: %s\n", seed, tick, failed);
+            currentTestFailed = true;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void TestPropertiesRandomPlay(GameContext *ctx)
+{
+    if (propertySeed != 0)
+    {
+        RunPropertySeed(ctx, propertySeed);
+        return;
+    }
+
+    for (unsigned int seed = 1; seed <= TEST_PROPERTY_SEEDS; seed++)
+        if (!RunPropertySeed(ctx, seed)) return;
+}
+
+// Main entry point
+int main(int argc, char **argv)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--ticks") && (i + 1 < argc)) propertyTicks = (unsigned int)strtoul(argv[++i], NULL, 10);
+        else if (!strcmp(argv[i], "--seed") && (i + 1 < argc)) propertySeed = (unsigned int)strtoul(argv[++i], NULL, 10);
+        else if (!strcmp(argv[i], "--steady-frames") && (i + 1 < argc)) steadyFrames = (unsigned int)strtoul(argv[++i], NULL, 10);
+        else
+        {
+            fprintf(stderr, "usage: %s [--ticks <n>] [--seed <n>] [--steady-frames <n>]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+
+    RUN_TEST(TestNewGameState);
+    RUN_TEST(TestFrogHopScoresOncePerRow);
+    RUN_TEST(TestFrogCantHopOffBottom);
+    RUN_TEST(TestKillFrog);
+    RUN_TEST(TestCarKillsFrog);
+    RUN_TEST(TestCrocBitesWithMouthOpen);
+    RUN_TEST(TestFrogDrownsInWater);
+    RUN_TEST(TestUpdatePlatform);
+    RUN_TEST(TestSunkTurtleIsNotAPlatform);
+    RUN_TEST(TestWinZoneScoring);
+    RUN_TEST(TestLevelWin);
+    RUN_TEST(TestGameOverResets);
+    RUN_TEST(TestLevelArenaIsReused);
+    RUN_TEST(TestEntityRecWraps);
+    RUN_TEST(TestGridWrapCopies);
+    RUN_TEST(TestLaneStripsMatchEntities);
+    RUN_TEST(TestInputBindingTable);
+    RUN_TEST(TestQueuedTapIsNotLost);
+    RUN_TEST(TestQueuedTapSurvivesMenuChange);
+    RUN_TEST(TestLatencyStages);
+    RUN_TEST(TestFramePacerSleep);
+    RUN_TEST(TestFrameArenaReset);
+    RUN_TEST(TestSpriteFramesInAtlas);
+    RUN_TEST(TestAssetArchive);
+    RUN_TEST(TestJobQueue);
+    RUN_TEST(TestQoaDecoder);
+    RUN_TEST(TestAudioMixerQueue);
+    RUN_TEST(TestAudioVoiceStealing);
+    RUN_TEST(TestTouchGamepadHitMap);
+    RUN_TEST(TestHudScoreText);
+    RUN_TEST(TestTextRunLayout);
+    RUN_TEST(TestSameSeedSameGame);
+    RUN_TEST(TestContextsAreIndependent);
+    RUN_TEST(TestSteadyStateDoesntAllocate);
+    RUN_TEST(TestPropertiesRandomPlay);
+
+    printf("%i/%i tests passed\n", testsRun - testsFailed, testsRun);
+    return (testsFailed == 0)? 0 : 1;
+}
@@ -2,24 +2,35 @@
 // For managing the user interface
 // See header for more documentation/descriptions
 
+#include "common.h" // all project header includes
+
+#include "rlgl.h" // blend factors for the UI layer
+
+// Local Functions Declaration
+static void DrawUiDefaultText(TextRun *run, const char *text, float x, float y, float fontSize, Color color);
+
 // Initialize
 // ----------------------------------------------------------------------------
 
-void InitUiState(void)
+void InitUiState(GameContext *ctx)
 {
-    ui = (UiState){
+    UiState *ui = &ctx->ui;
+
+    *ui = (UiState){
         .camera.target = (Vector2){ VIRTUAL_WIDTH/2, VIRTUAL_HEIGHT/2 },
         .currentMenu = UI_MENU_TITLE,
         .preventMouseClick = true,
         .selectedId = 0,
         .mouseHoverId = -1,
         .firstFrame = true,
+        .menuAutoRepeat = { .triggerTime = 0.6f, .fireInterval = 0.1f },
+        .sliderAutoRepeat = { .triggerTime = 0.6f, .fireInterval = 0.1f },
     };
 
     // Title menu
     // ----------------------------------------------------------------------------
-    ui.initMenu = UI_MENU_TITLE; // new buttons are added to this menu
-    UiMenu *titleMenu = &ui.menus[UI_MENU_TITLE];
+    ui->initMenu = UI_MENU_TITLE; // new buttons are added to this menu
+    UiMenu *titleMenu = &ui->menus[UI_MENU_TITLE];
     UiSelectionStyle selectionStyleFlags = (UI_SELSTYLE_HL_RECT | UI_SELSTYLE_HL_TEXT);
     // UiSelectionStyle selectionStyleFlags = (UI_SELSTYLE_GROW | UI_SELSTYLE_HL_TEXT);
     titleMenu->buttonWidth = UI_TITLE_BUTTON_WIDTH;
@@ -27,84 +38,77 @@ void InitUiState(void)
     titleMenu->spacing = UI_BUTTON_SPACING;
     titleMenu->selectStyleFlags = selectionStyleFlags;
 
-    SetUiAlignMode(UI_ALIGN_CENTER, UI_ALIGN_TOP);
+    SetUiAlignMode(ctx, UI_ALIGN_CENTER, UI_ALIGN_TOP);
     float alignOffsetY = UI_TITLE_TOP_PADDING + PLATFORM_TITLE_PADDING;
-    CreateUiText("Frogger", 0, alignOffsetY, UI_TITLE_FONT_SIZE);
-    CreateUiText("Remake", 0, alignOffsetY + UI_TITLE_FONT_SIZE + 10, UI_TITLE_FONT_SIZE);
+    CreateUiText(ctx, "Frogger", 0, alignOffsetY, UI_TITLE_FONT_SIZE);
+    CreateUiText(ctx, "Remake", 0, alignOffsetY + UI_TITLE_FONT_SIZE + 10, UI_TITLE_FONT_SIZE);
 
-    SetUiAlignMode(UI_ALIGN_CENTER, UI_ALIGN_MIDDLE);
-    CreateUiMenuButton("Start", UiCallbackStartGame, 0, 30);
-    CreateUiMenuButtonRelative("Settings", UiCallbackSettings);
+    SetUiAlignMode(ctx, UI_ALIGN_CENTER, UI_ALIGN_MIDDLE);
+    CreateUiMenuButton(ctx, "Start", UiCallbackStartGame, 0, 30);
+    CreateUiMenuButtonRelative(ctx, "Settings", UiCallbackSettings);
     if (PLATFORM_CAN_EXIT)
-        CreateUiMenuButtonRelative("Exit", UiCallbackExit);
+        CreateUiMenuButtonRelative(ctx, "Exit", UiCallbackExit);
 
     // Settings menu
     // ----------------------------------------------------------------------------
-    ui.initMenu = UI_MENU_SETTINGS;
-    UiMenu *settingsMenu = &ui.menus[UI_MENU_SETTINGS];
+    ui->initMenu = UI_MENU_SETTINGS;
+    UiMenu *settingsMenu = &ui->menus[UI_MENU_SETTINGS];
     settingsMenu->buttonWidth = UI_SETTINGS_BUTTON_WIDTH;
     settingsMenu->fontSize = UI_SETTINGS_FONT_SIZE;
     settingsMenu->spacing = UI_BUTTON_SPACING;
     settingsMenu->selectStyleFlags = selectionStyleFlags;
 
-    SetUiAlignMode(UI_ALIGN_CENTER, UI_ALIGN_TOP);
-    CreateUiText("SETTINGS", 0, VIRTUAL_HEIGHT*0.15f, UI_TITLE_FONT_SIZE);
-    CreateUiMenuButton("Back", UiCallbackGoBack, 0, VIRTUAL_HEIGHT*0.35f);
-    CreateUiMenuButtonRelative("Fullscreen:", UiCallbackToggleFullscreen);
-    CreateUiCheckbox(UiCallbackCheckFullscreen);
-    CreateUiMenuButtonRelative("Volume:", 0);
-    CreateUiSlider(UiCallbackSetVolume, GetMasterVolume, 0.0f, 1.0f, 0.1f);
-    CreateUiMenuButtonRelative("Render scale:", 0);
-    CreateUiSlider(UiCallbackSetRenderScale, UiCallbackGetRenderScale, 1/4.0f, 4.0f, 1/4.0f);
+    SetUiAlignMode(ctx, UI_ALIGN_CENTER, UI_ALIGN_TOP);
+    CreateUiText(ctx, "SETTINGS", 0, VIRTUAL_HEIGHT*0.15f, UI_TITLE_FONT_SIZE);
+    CreateUiMenuButton(ctx, "Back", UiCallbackGoBack, 0, VIRTUAL_HEIGHT*0.35f);
+    CreateUiMenuButtonRelative(ctx, "Fullscreen:", UiCallbackToggleFullscreen);
+    CreateUiCheckbox(ctx, UiCallbackCheckFullscreen);
+    CreateUiMenuButtonRelative(ctx, "Volume:", 0);
+    CreateUiSlider(ctx, UiCallbackSetVolume, UiCallbackGetVolume, 0.0f, 1.0f, 0.1f);
+    CreateUiMenuButtonRelative(ctx, "Render scale:", 0);
+    CreateUiSlider(ctx, UiCallbackSetRenderScale, UiCallbackGetRenderScale, 1/4.0f, 4.0f, 1/4.0f);
 
     // Pause menu
     // ----------------------------------------------------------------------------
-    ui.initMenu = UI_MENU_PAUSE;
-    UiMenu *pauseMenu = &ui.menus[UI_MENU_PAUSE];
+    ui->initMenu = UI_MENU_PAUSE;
+    UiMenu *pauseMenu = &ui->menus[UI_MENU_PAUSE];
     pauseMenu->buttonWidth = UI_PAUSE_BUTTON_WIDTH;
     pauseMenu->fontSize = UI_MENU_FONT_SIZE;
     pauseMenu->spacing = UI_BUTTON_SPACING;
     pauseMenu->selectStyleFlags = selectionStyleFlags;
 
-    SetUiAlignMode(UI_ALIGN_CENTER, UI_ALIGN_TOP);
-    CreateUiText("PAUSED", 0, VIRTUAL_HEIGHT*0.15f, UI_TITLE_FONT_SIZE);
-    CreateUiMenuButton("Resume", UiCallbackResume, 0, VIRTUAL_HEIGHT*0.35f);
-    CreateUiMenuButtonRelative("Settings", UiCallbackSettings);
-    CreateUiMenuButtonRelative("Title Screen", UiCallbackGoToTitle);
+    SetUiAlignMode(ctx, UI_ALIGN_CENTER, UI_ALIGN_TOP);
+    CreateUiText(ctx, "PAUSED", 0, VIRTUAL_HEIGHT*0.15f, UI_TITLE_FONT_SIZE);
+    CreateUiMenuButton(ctx, "Resume", UiCallbackResume, 0, VIRTUAL_HEIGHT*0.35f);
+    CreateUiMenuButtonRelative(ctx, "Settings", UiCallbackSettings);
+    CreateUiMenuButtonRelative(ctx, "Title Screen", UiCallbackGoToTitle);
     if (PLATFORM_CAN_EXIT)
-        CreateUiMenuButtonRelative("Exit Game", UiCallbackExit);
+        CreateUiMenuButtonRelative(ctx, "Exit Game", UiCallbackExit);
 
-    SetUiAlignMode(UI_ALIGN_DISABLED, UI_ALIGN_DISABLED);
+    SetUiAlignMode(ctx, UI_ALIGN_DISABLED, UI_ALIGN_DISABLED);
 
     // Sound assets
-    ui.sounds.menu =  LoadSoundAsset(&ui.assets, "assets/audio/menu_beep.wav", 1.0f);
+    QueueGameSound(ctx, &ui->assets, &ui->sounds.menu, "assets/audio/menu_beep.wav", 1.0f, 1, AUDIO_PRIORITY_NORMAL);
 
     // Textures
-    ui.textures.atlas       = LoadTextureAsset(&ui.assets, "assets/textures/controls.png");
-    ui.textures.analogBase  = (Rectangle){   0.5f,   0, 256, 256 };
-    ui.textures.analogStick = (Rectangle){   0.5f, 256, 128, 128 };
-    ui.textures.pause       = (Rectangle){ 128.5f, 256, 128, 128 };
-    ui.textures.dpad        = (Rectangle){ 256.5f,   0, 256, 256 };
-    // ui.textures.a           = (Rectangle){ 256.5f, 256, 128, 128 };
-    // ui.textures.b           = (Rectangle){ 384.5f, 256, 128, 128 };
-    // ui.textures.x           = (Rectangle){   0.5f, 384, 128, 128 };
-    // ui.textures.y           = (Rectangle){ 128.5f, 384, 128, 128 };
+    QueueTextureAsset(ctx, &ui->assets, &ui->textures.atlas, SPRITE_ATLAS_FILE, TEXTURE_FILTER_POINT);
+    QueueTextureAsset(ctx, &ui->assets, &ui->textures.controls, CONTROL_ATLAS_FILE, TEXTURE_FILTER_BILINEAR);
 
     // Touch input buttons (virtual gamepad)
     // ----------------------------------------------------------------------------
     // Analog stick
-    ui.gamepad.stick = (UiAnalogStick){
-        .sprite = &ui.textures.atlas,
-        .spriteBaseRec = ui.textures.analogBase,
-        .spriteStickRec = ui.textures.analogStick,
+    ui->gamepad.stick = (UiAnalogStick){
+        .sprite = &ui->textures.controls,
+        .spriteBaseRec = CONTROL_ANALOG_BASE.rec,
+        .spriteStickRec = CONTROL_ANALOG_STICK.rec,
         .lastTouchId = -1,
         .enabled = false,
     };
 
     // D-Pad
-    ui.gamepad.dpad = (UiDPad){
-        .sprite = &ui.textures.atlas,
-        .spriteRec = ui.textures.dpad,
+    ui->gamepad.dpad = (UiDPad){
+        .sprite = &ui->textures.controls,
+        .spriteRec = CONTROL_DPAD.rec,
         .inputActionId[UI_DPAD_UP] = INPUT_ACTION_UP,
         .inputActionId[UI_DPAD_DOWN] = INPUT_ACTION_DOWN,
         .inputActionId[UI_DPAD_LEFT] = INPUT_ACTION_LEFT,
@@ -113,33 +117,35 @@ void InitUiState(void)
     };
 
     // Pause button
-    ui.gamepad.pause = (UiButton){
-        .sprite = &ui.textures.atlas,
-        .spriteRec = ui.textures.pause,
+    ui->gamepad.pause = (UiButton){
+        .sprite = &ui->textures.controls,
+        .spriteRec = CONTROL_PAUSE.rec,
         .text = "Pause",
         .spriteScale = 1.333f,
         .inputActionId = INPUT_ACTION_PAUSE,
         .color = RAYWHITE
     };
 
-    UpdateUiGamepadRender();
+    UpdateUiGamepadLayout(ctx, GetRenderWidth(), GetRenderHeight(), ui->camera.zoom);
 }
 
-UiButton InitUiButton(char *text, UiActionFunc actionFunc, float x, float y, float buttonWidth, int fontSize)
+UiButton InitUiButton(GameContext *ctx, char *text, UiActionFunc actionFunc, float x, float y, float buttonWidth, int fontSize)
 {
+    UiState *ui = &ctx->ui;
+
     int textWidth = MeasureText(text, fontSize);
     int growWidth = MeasureText(text, (int)(fontSize*UI_SELECT_GROWTH_MULT));
     float growPosX = x;
     if (buttonWidth == 0) buttonWidth = (float)textWidth + 25;
 
     float buttonHeight = fontSize + fontSize*0.2f;
-    if (ui.hAlign != UI_ALIGN_DISABLED)
+    if (ui->hAlign != UI_ALIGN_DISABLED)
     {
-        x += Lerp(0.0f, (float)VIRTUAL_WIDTH - buttonWidth, ((float)ui.hAlign)*0.5f);
-        growPosX += Lerp(0.0f, (float)VIRTUAL_WIDTH - growWidth, ((float)ui.hAlign)*0.5f);
+        x += Lerp(0.0f, (float)VIRTUAL_WIDTH - buttonWidth, ((float)ui->hAlign)*0.5f);
+        growPosX += Lerp(0.0f, (float)VIRTUAL_WIDTH - growWidth, ((float)ui->hAlign)*0.5f);
     }
-    if (ui.vAlign != UI_ALIGN_DISABLED)
-        y += Lerp(0.0f, (float)VIRTUAL_HEIGHT - buttonHeight, ((float)ui.vAlign)*0.5f);
+    if (ui->vAlign != UI_ALIGN_DISABLED)
+        y += Lerp(0.0f, (float)VIRTUAL_HEIGHT - buttonHeight, ((float)ui->vAlign)*0.5f);
 
     Vector2 textPos;
     if (buttonWidth == (float)textWidth)
@@ -165,15 +171,17 @@ UiButton InitUiButton(char *text, UiActionFunc actionFunc, float x, float y, flo
     return button;
 }
 
-void CreateUiTextEx(Font font, char *text, float x, float y, float fontSize)
+void CreateUiTextEx(GameContext *ctx, Font font, char *text, float x, float y, float fontSize)
 {
-    Vector2 measure = MeasureTextEx(font, text, fontSize, 0);
-    if (ui.hAlign != UI_ALIGN_DISABLED)
+    UiState *ui = &ctx->ui;
+
+    Vector2 measure = MeasureFontText(font, text, fontSize, 0);
+    if (ui->hAlign != UI_ALIGN_DISABLED)
     {
-        x += Lerp(0.0f, (float)VIRTUAL_WIDTH - measure.x, ((float)ui.hAlign)*0.5f);
+        x += Lerp(0.0f, (float)VIRTUAL_WIDTH - measure.x, ((float)ui->hAlign)*0.5f);
     }
-    if (ui.vAlign != UI_ALIGN_DISABLED)
-        y += Lerp(0.0f, (float)VIRTUAL_HEIGHT - measure.y, ((float)ui.vAlign)*0.5f);
+    if (ui->vAlign != UI_ALIGN_DISABLED)
+        y += Lerp(0.0f, (float)VIRTUAL_HEIGHT - measure.y, ((float)ui->vAlign)*0.5f);
 
     UiText textElement = {
         .position = { x, y },
@@ -182,30 +190,34 @@ void CreateUiTextEx(Font font, char *text, float x, float y, float fontSize)
     };
     strcpy(textElement.text, text);
 
-    arrput(ui.menus[ui.initMenu].text, textElement);
+    arrput(ui->menus[ui->initMenu].text, textElement);
 }
 
-void CreateUiText(char *text, float x, float y, int fontSize)
+void CreateUiText(GameContext *ctx, char *text, float x, float y, int fontSize)
 {
-    CreateUiTextEx(GetFontDefault(), text, x, y, (float)fontSize);
+    CreateUiTextEx(ctx, GetFontDefault(), text, x, y, (float)fontSize);
 }
 
-UiButton *CreateUiMenuButton(char *text, UiActionFunc actionFunc, float x, float y)
+UiButton *CreateUiMenuButton(GameContext *ctx, char *text, UiActionFunc actionFunc, float x, float y)
 {
-    UiMenu *menu = &ui.menus[ui.initMenu];
-    UiButton button = InitUiButton(text, actionFunc, x, y, menu->buttonWidth, menu->fontSize);
+    UiState *ui = &ctx->ui;
+
+    UiMenu *menu = &ui->menus[ui->initMenu];
+    UiButton button = InitUiButton(ctx, text, actionFunc, x, y, menu->buttonWidth, menu->fontSize);
     arrput(menu->buttons, button);
-    ui.lastButtonCreated = &arrlast(menu->buttons);
+    ui->lastButtonCreated = &arrlast(menu->buttons);
 
     return &menu->buttons[arrlen(menu->buttons) - 1];
 }
 
-void CreateUiMenuButtonRelative(char* text, UiActionFunc actionFunc)
+void CreateUiMenuButtonRelative(GameContext *ctx, char* text, UiActionFunc actionFunc)
 {
-    UiMenu *menu = &ui.menus[ui.initMenu];
+    UiState *ui = &ctx->ui;
+
+    UiMenu *menu = &ui->menus[ui->initMenu];
     UiButton *originButton = &menu->buttons[arrlen(menu->buttons) - 1];
-    UiButton *button = CreateUiMenuButton(text, actionFunc, 0, 0);
-    if (ui.hAlign == UI_ALIGN_DISABLED)
+    UiButton *button = CreateUiMenuButton(ctx, text, actionFunc, 0, 0);
+    if (ui->hAlign == UI_ALIGN_DISABLED)
     {
         int textLength = MeasureText(text, menu->fontSize);
         button->rec.x = originButton->rec.x;
@@ -230,9 +242,11 @@ UiButton InitUiInputButton(char *text, int inputActionId, float x, float y, floa
     return button;
 }
 
-void CreateUiCheckbox(UiGetBoolFunc getValue)
+void CreateUiCheckbox(GameContext *ctx, UiGetBoolFunc getValue)
 {
-    UiButton *button = ui.lastButtonCreated;
+    UiState *ui = &ctx->ui;
+
+    UiButton *button = ui->lastButtonCreated;
     float radius = button->height/2 - 10;
 
     UiCheckbox newCheckbox = {
@@ -257,19 +271,21 @@ void CreateUiCheckbox(UiGetBoolFunc getValue)
         };
 
     // reposition rect if necessary
-    if (ui.menus[ui.initMenu].buttonWidth == 0)
+    if (ui->menus[ui->initMenu].buttonWidth == 0)
     {
         button->rec.width += radius*2 + 25;
         button->rec.x -= radius*0.75f + 25;
     }
 
-    button->checkbox = arena_alloc(&ui.arena, sizeof(UiCheckbox));
+    button->checkbox = arena_alloc(&ui->arena, sizeof(UiCheckbox));
     *button->checkbox = newCheckbox;
 }
 
-void CreateUiSlider(UiSetFloatFunc setValue, UiGetFloatFunc getValue, float minValue, float maxValue, float increment)
+void CreateUiSlider(GameContext *ctx, UiSetFloatFunc setValue, UiGetFloatFunc getValue, float minValue, float maxValue, float increment)
 {
-    UiButton *button = ui.lastButtonCreated;
+    UiState *ui = &ctx->ui;
+
+    UiButton *button = ui->lastButtonCreated;
 
     UiSlider newSlider = {
         .rec = (Rectangle){
@@ -287,14 +303,16 @@ void CreateUiSlider(UiSetFloatFunc setValue, UiGetFloatFunc getValue, float minV
     button->rec.height += button->height/2;
     button->height += button->height/2;
 
-    button->slider = arena_alloc(&ui.arena, sizeof(UiSlider));
+    button->slider = arena_alloc(&ui->arena, sizeof(UiSlider));
     *button->slider = newSlider;
 }
 
-void SetUiAlignMode(UiAlignment hAlign, UiAlignment vAlign)
+void SetUiAlignMode(GameContext *ctx, UiAlignment hAlign, UiAlignment vAlign)
 {
-    ui.hAlign = hAlign;
-    ui.vAlign = vAlign;
+    UiState *ui = &ctx->ui;
+
+    ui->hAlign = hAlign;
+    ui->vAlign = vAlign;
 }
 
 // void DisableAlignMode(void)
@@ -303,97 +321,109 @@ void SetUiAlignMode(UiAlignment hAlign, UiAlignment vAlign)
 //     ui.vAlign = UI_ALIGN_DISABLED;
 // }
 
-void FreeUiState(void)
+void FreeUiState(GameContext *ctx)
 {
+    UiState *ui = &ctx->ui;
+
     for (int i = 0; i < UI_MENU_AMOUNT; i++)
-        arrfree(ui.menus[i].buttons);
-    arena_free(&ui.arena);
-    FreeRaylibAssets(&ui.assets);
+        arrfree(ui->menus[i].buttons);
+    arena_free(&ui->arena);
+    FinishAssetLoads(ctx); // nothing may land in the pool after it's freed
+    SilenceAudioMixer(ctx); // or be played from it
+    FreeRaylibAssets(&ui->assets);
+    if (IsRenderTextureValid(ui->layer))
+        UnloadRenderTexture(ui->layer);
 }
 
 // Update / User Input
 // ----------------------------------------------------------------------------
 
-void UpdateUiFrame(void)
+void UpdateUiFrame(GameContext *ctx)
 {
-    if (input.global.debug)
-        game.isDebugMode = !game.isDebugMode;
+    GameState *game = &ctx->game;
+    InputState *input = &ctx->input;
+    UiState *ui = &ctx->ui;
+
+    if (input->global.debug)
+        game->isDebugMode = !game->isDebugMode;
 
     // Update text fade animation
-    static float fadeLength = 1.5f; // Fade in and out at this rate in seconds
-    static bool fadingOut = false;
-    float fadeIncrement = (1.0f/fadeLength)*game.frameTime;
-
-    if (ui.textFade >= 1.0f)
-        fadingOut = true;
-    else if (ui.textFade <= 0.0f)
-        fadingOut = false;
-    if (fadingOut)
+    const float fadeLength = 1.5f; // Fade in and out at this rate in seconds
+    float fadeIncrement = (1.0f/fadeLength)*game->frameTime;
+
+    if (ui->textFade >= 1.0f)
+        ui->textFadingOut = true;
+    else if (ui->textFade <= 0.0f)
+        ui->textFadingOut = false;
+    if (ui->textFadingOut)
         fadeIncrement *= -1;
 
     // Update timers
-    if (ui.actionCooldownTimer > 0) ui.actionCooldownTimer -= game.frameTime;
+    if (ui->actionCooldownTimer > 0) ui->actionCooldownTimer -= game->frameTime;
 
-    ui.textFade += fadeIncrement;
+    ui->textFade += fadeIncrement;
 
     // Update title menu
-    if (ui.currentMenu != UI_MENU_NONE)
+    if (ui->currentMenu != UI_MENU_NONE)
     {
         // Cancel/Back to main title menu
-        if (input.menu.cancel &&
-            ui.currentMenu != UI_MENU_TITLE &&
-            ui.currentMenu != UI_MENU_PAUSE)
+        if (input->menu.cancel &&
+            ui->currentMenu != UI_MENU_TITLE &&
+            ui->currentMenu != UI_MENU_PAUSE)
         {
-            ChangeUiMenu(UI_MENU_TITLE);
-            PlaySound(ui.sounds.menu);
+            ChangeUiMenu(ctx, UI_MENU_TITLE);
+            PlayGameSound(ctx, &ui->sounds.menu);
         }
 
         // Input for menu selection and movement
-        UpdateUiMenuTraverse();
-        UiButton *selectedButton = &ui.menus[ui.currentMenu].buttons[ui.selectedId];
-        UpdateUiButtonSelect(selectedButton);
+        UpdateUiMenuTraverse(ctx);
+        UiButton *selectedButton = &ui->menus[ui->currentMenu].buttons[ui->selectedId];
+        UpdateUiButtonSelect(ctx, selectedButton);
     }
 
     // Update touch gamepad for window size
-    UpdateUiGamepadRender();
+    UpdateUiGamepadRender(ctx);
 
     // Update specific text fade
-    if (game.isPaused)
+    if (game->isPaused)
     {
-        UiText *pauseText = &ui.menus[UI_MENU_PAUSE].text[0];
-        pauseText->color = Fade(RAYWHITE, ui.textFade);
-        UiText *settingsText = &ui.menus[UI_MENU_SETTINGS].text[0];
-        settingsText->color = Fade(RAYWHITE, ui.textFade);
+        UiText *pauseText = &ui->menus[UI_MENU_PAUSE].text[0];
+        pauseText->color = Fade(RAYWHITE, ui->textFade);
+        UiText *settingsText = &ui->menus[UI_MENU_SETTINGS].text[0];
+        settingsText->color = Fade(RAYWHITE, ui->textFade);
     }
     // Update message timer when unpaused
-    else if (ui.messageTimer > 0) ui.messageTimer -= game.frameTime;
+    else if (ui->messageTimer > 0) ui->messageTimer -= game->frameTime;
 
 }
 
-void UpdateUiMenuTraverse(void)
+void UpdateUiMenuTraverse(GameContext *ctx)
 {
-    if (ui.currentMenu == UI_MENU_NONE) return; // no menu to update
+    InputState *input = &ctx->input;
+    UiState *ui = &ctx->ui;
+
+    if (ui->currentMenu == UI_MENU_NONE) return; // no menu to update
 
-    UiMenu *menu = &ui.menus[ui.currentMenu];
+    UiMenu *menu = &ui->menus[ui->currentMenu];
 
-    int prevId = ui.selectedId; // used to determine when to play a sound
+    int prevId = ui->selectedId; // used to determine when to play a sound
     bool newMouseHover = false;
-    bool sliderActive = ((ui.selectedId != -1) &&
-                         menu->buttons[ui.selectedId].slider &&
-                         menu->buttons[ui.selectedId].slider->active);
+    bool sliderActive = ((ui->selectedId != -1) &&
+                         menu->buttons[ui->selectedId].slider &&
+                         menu->buttons[ui->selectedId].slider->active);
 
     // Deselect when not touching for touch screen
-    if (input.touchMode && input.touchCount == 0)
+    if (input->touchMode && input->touchCount == 0)
     {
-        ui.selectedId = -1;
-        ui.mouseHoverId = -1;
+        ui->selectedId = -1;
+        ui->mouseHoverId = -1;
     }
 
     // Keep slider button selected while active
     else if (sliderActive); // don't update traversal
 
     // Move cursor via mouse (also works for first touch point)
-    else if (input.mouse.moved || (ui.firstFrame && ui.lastSelectWithMouse))
+    else if (input->mouse.moved || (ui->firstFrame && ui->lastSelectWithMouse))
     {
 
         bool buttonFound = false;
@@ -402,132 +432,269 @@ void UpdateUiMenuTraverse(void)
             UiButton *currentButton = 0;
             currentButton = &menu->buttons[i];
 
-            if (IsMouseWithinUiButton(currentButton))
+            if (IsMouseWithinUiButton(ctx, currentButton))
             {
                 buttonFound = true;
-                ui.selectedId = i;
-                if (ui.mouseHoverId == -1)
+                ui->selectedId = i;
+                if (ui->mouseHoverId == -1)
                     newMouseHover = true;
-                ui.mouseHoverId = i;
-                ui.lastSelectWithMouse = true;
+                ui->mouseHoverId = i;
+                ui->lastSelectWithMouse = true;
                 break;
             }
         }
         if (!buttonFound)
         {
-            ui.mouseHoverId = -1;
-            ui.selectedId = -1;
+            ui->mouseHoverId = -1;
+            ui->selectedId = -1;
             prevId = -1;
         }
     }
 
     // Move cursor via input actions
-    static AutoRepeatSettings autoRepeat = { .triggerTime = 0.6f, .fireInterval = 0.1f };
-    bool validInput = (input.menu.moveUp || input.menu.moveDown);
-    if (AutoRepeatShouldFire(&autoRepeat, validInput))
+    bool validInput = (input->menu.moveUp || input->menu.moveDown);
+    if (AutoRepeatShouldFire(ctx, &ui->menuAutoRepeat, validInput))
     {
-        if (input.menu.moveUp)
+        if (input->menu.moveUp)
         {
-            if (ui.selectedId == -1) ui.selectedId = (int)arrlen(menu->buttons); // up defaults to last menu item
-            ui.selectedId = ((ui.selectedId + (int)arrlen(menu->buttons) - 1) % arrlen(menu->buttons));
-            ui.lastSelectWithMouse = false;
+            if (ui->selectedId == -1) ui->selectedId = (int)arrlen(menu->buttons); // up defaults to last menu item
+            ui->selectedId = ((ui->selectedId + (int)arrlen(menu->buttons) - 1) % arrlen(menu->buttons));
+            ui->lastSelectWithMouse = false;
         }
-        if (input.menu.moveDown)
+        if (input->menu.moveDown)
         {
-            ui.selectedId = ((ui.selectedId + 1) % arrlen(menu->buttons)); // down defaults to first menu item (-1 + 1)
-            ui.lastSelectWithMouse = false;
+            ui->selectedId = ((ui->selectedId + 1) % arrlen(menu->buttons)); // down defaults to first menu item (-1 + 1)
+            ui->lastSelectWithMouse = false;
         }
     }
 
     // Re-enable mouse click
-    if ((ui.preventMouseClick && (input.touchCount == 0) &&
-         !input.mouse.leftDown && !input.mouse.rightDown))
-        ui.preventMouseClick = false;
+    if ((ui->preventMouseClick && (input->touchCount == 0) &&
+         !input->mouse.leftDown && !input->mouse.rightDown))
+        ui->preventMouseClick = false;
 
     // Play sound when new item selected
-    bool cursorMoved = (ui.selectedId != (int)prevId);
+    bool cursorMoved = (ui->selectedId != (int)prevId);
 
-    if ((cursorMoved || newMouseHover) && !ui.firstFrame && !input.touchMode)
-        PlaySound(ui.sounds.menu);
+    if ((cursorMoved || newMouseHover) && !ui->firstFrame && !input->touchMode)
+        PlayGameSound(ctx, &ui->sounds.menu);
 
-    ui.firstFrame = false;
+    ui->firstFrame = false;
 }
 
-void UpdateUiButtonSelect(UiButton *button)
+void UpdateUiButtonSelect(GameContext *ctx, UiButton *button)
 {
-    if (ui.selectedId == -1) return;
+    InputState *input = &ctx->input;
+    UiState *ui = &ctx->ui;
 
-    // int touchIdx = IsTouchWithinUiButton(button);
-    // bool buttonTapped = ((touchIdx != -1) && IsTouchPointTapped(touchIdx));
-    // bool buttonDown = (input.mouse.leftDown && IsMouseWithinUiButton(button));
-    bool buttonClicked = (input.mouse.leftPressed && IsMouseWithinUiButton(button));
+    if (ui->selectedId == -1) return;
+
+    // int touchIdx = IsTouchWithinUiButton(ctx, button);
+    // bool buttonTapped = ((touchIdx != -1) && IsTouchPointTapped(ctx, touchIdx));
+    // bool buttonDown = (input->mouse.leftDown && IsMouseWithinUiButton(ctx, button));
+    bool buttonClicked = (input->mouse.leftPressed && IsMouseWithinUiButton(ctx, button));
 
     // Select a menu button
-    if (input.menu.confirm || buttonClicked)
+    if (input->menu.confirm || buttonClicked)
     {
-        if (ui.currentMenu == UI_MENU_NONE && !game.isPaused)
+        if (ui->currentMenu == UI_MENU_NONE && !ctx->game.isPaused)
             return; // not a menu
 
         if (button->onClick)
         {
-            button->onClick();
-            PlaySound(ui.sounds.menu);
+            button->onClick(ctx);
+            PlayGameSound(ctx, &ui->sounds.menu);
         }
     }
 
     if (button->slider)
     {
         // Adjust slider with mouse/touch
-        if (!ui.preventMouseClick && input.mouse.leftDown && ui.lastSelectWithMouse)
-            UpdateUiSliderSelect(button->slider);
+        if (!ui->preventMouseClick && input->mouse.leftDown && ui->lastSelectWithMouse)
+            UpdateUiSliderSelect(ctx, button->slider);
         else
             button->slider->active = false;
 
         // Adjust slider with input actions
-        static AutoRepeatSettings autoRepeat = { .triggerTime = 0.6f, .fireInterval = 0.1f };
-        bool validInput = (input.menu.moveLeft || input.menu.moveRight);
-        if (AutoRepeatShouldFire(&autoRepeat, validInput))
+        bool validInput = (input->menu.moveLeft || input->menu.moveRight);
+        if (AutoRepeatShouldFire(ctx, &ui->sliderAutoRepeat, validInput))
         {
-            float newValue = button->slider->getValue();
-            if (input.menu.moveLeft)
+            float newValue = button->slider->getValue(ctx);
+            if (input->menu.moveLeft)
                 newValue -= button->slider->increment;
-            else if (input.menu.moveRight)
+            else if (input->menu.moveRight)
                 newValue += button->slider->increment;
-            button->slider->setValue(newValue, button->slider);
+            button->slider->setValue(ctx, newValue, button->slider);
         }
     }
 }
 
-void UpdateUiSliderSelect(UiSlider *slider)
+void UpdateUiSliderSelect(GameContext *ctx, UiSlider *slider)
 {
-    if (input.mouse.leftPressed)
+    InputState *input = &ctx->input;
+
+    if (input->mouse.leftPressed)
         slider->active = true;
     if (slider->active)
     {
-        float newValue = Remap(input.mouse.uiPosition.x,
+        float newValue = Remap(input->mouse.uiPosition.x,
                                slider->rec.x, slider->rec.x + slider->rec.width,
                                slider->min, slider->max);
-        slider->setValue(newValue, slider);
+        slider->setValue(ctx, newValue, slider);
+    }
+}
+
+void UpdateUiHud(GameContext *ctx)
+{
+    GameState *game = &ctx->game;
+    UiState *ui = &ctx->ui;
+
+    if (game->score != ui->hudScore)
+    {
+        ui->hudScore = game->score;
+        snprintf(ui->scoreNum.text, sizeof(ui->scoreNum.text), "%i", game->score);
+    }
+    if (game->hiScore != ui->hudHiScore)
+    {
+        ui->hudHiScore = game->hiScore;
+        snprintf(ui->hiScoreNum.text, sizeof(ui->hiScoreNum.text), "%i", game->hiScore);
+    }
+}
+
+// UI layer
+// ----------------------------------------------------------------------------
+// FNV-1a, for hashing what's drawn on the UI layer
+static unsigned int HashUiData(unsigned int hash, const void *data, size_t size)
+{
+    const unsigned char *bytes = data;
+    for (size_t i = 0; i < size; i++)
+        hash = (hash ^ bytes[i])*16777619u;
+    return hash;
+}
+
+#define HASH_UI_VALUE(hash, value) HashUiData((hash), &(value), sizeof(value))
+
+// Everything DrawUiLayer() depends on that can change while the game runs
+static unsigned int GetUiLayerKey(GameContext *ctx)
+{
+    GameState *game = &ctx->game;
+    UiState *ui = &ctx->ui;
+
+    unsigned int key = 2166136261u;
+    key = HASH_UI_VALUE(key, game->camera);
+    key = HASH_UI_VALUE(key, game->currentScreen);
+    if (game->currentScreen == SCREEN_GAMEPLAY)
+    {
+        key = HASH_UI_VALUE(key, ui->hudScore);
+        key = HASH_UI_VALUE(key, ui->hudHiScore);
+        key = HASH_UI_VALUE(key, game->lives);
+        key = HASH_UI_VALUE(key, game->level);
+    }
+
+    key = HASH_UI_VALUE(key, ui->currentMenu);
+    if (ui->currentMenu != UI_MENU_NONE)
+    {
+        UiMenu *menu = &ui->menus[ui->currentMenu];
+        key = HASH_UI_VALUE(key, ui->selectedId);
+        key = HASH_UI_VALUE(key, ui->mouseHoverId);
+        key = HASH_UI_VALUE(key, ui->lastSelectWithMouse);
+        for (int i = 0; i < arrlen(menu->buttons); i++)
+        {
+            UiButton *button = &menu->buttons[i];
+            key = HASH_UI_VALUE(key, button->clicked);
+            key = HashUiData(key, button->text, strlen(button->text));
+            if (button->checkbox)
+            {
+                bool value = button->checkbox->getValue(ctx);
+                key = HASH_UI_VALUE(key, value);
+            }
+            if (button->slider)
+            {
+                float value = button->slider->getValue(ctx);
+                key = HASH_UI_VALUE(key, value);
+            }
+        }
+        for (int i = 0; i < arrlen(menu->text); i++)
+        {
+            key = HASH_UI_VALUE(key, menu->text[i].color);
+            key = HashUiData(key, menu->text[i].text, strlen(menu->text[i].text));
+        }
+    }
+
+    return key;
+}
+
+void UpdateUiLayer(GameContext *ctx)
+{
+    UiState *ui = &ctx->ui;
+    RenderData *viewport = &ctx->viewport;
+
+    // Same resolution as the render target, so the cached UI looks the same as drawing it directly
+    int width = (int)viewport->renderTexWidth;
+    int height = (int)viewport->renderTexHeight;
+    bool isResized = (ui->layer.texture.width != width) || (ui->layer.texture.height != height);
+    if (!IsRenderTextureValid(ui->layer) || isResized)
+    {
+        if (IsRenderTextureValid(ui->layer))
+            UnloadRenderTexture(ui->layer);
+        ui->layer = LoadRenderTexture(width, height);
+        SetTextureFilter(ui->layer.texture, TEXTURE_FILTER_BILINEAR);
     }
+
+    unsigned int key = GetUiLayerKey(ctx);
+    if (!isResized && (key == ui->layerKey)) return;
+    ui->layerKey = key;
+    ui->layerRedraws++;
+
+    // Draw with premultiplied alpha, so transparent boxes and text edges
+    // blend the same when the layer is drawn over the game later
+    BeginTextureMode(ui->layer);
+        ClearBackground(BLANK);
+        BeginMode2D(ctx->game.camera);
+            rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA,
+                                      RL_FUNC_ADD, RL_FUNC_ADD);
+            BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+                DrawUiLayer(ctx);
+            EndBlendMode();
+        EndMode2D();
+    EndTextureMode();
 }
 
 // Touch screen virtual gamepad
 // ----------------------------------------------------------------------------
-void UpdateUiGamepadRender(void)
+void UpdateUiGamepadRender(GameContext *ctx)
 {
+    UiGamepad *gamepad = &ctx->ui.gamepad;
+
     int winWidth = GetRenderWidth();
     int winHeight = GetRenderHeight();
-    float scale = ui.camera.zoom;
+    float scale = ctx->ui.camera.zoom;
+
+    if ((winWidth == gamepad->layoutWidth) && (winHeight == gamepad->layoutHeight) &&
+        (scale == gamepad->layoutScale))
+        return;
+
+    UpdateUiGamepadLayout(ctx, winWidth, winHeight, scale);
+}
+
+void UpdateUiGamepadLayout(GameContext *ctx, int winWidth, int winHeight, float scale)
+{
+    UiState *ui = &ctx->ui;
+    UiGamepad *gamepad = &ui->gamepad;
+
+    gamepad->layoutWidth = winWidth;
+    gamepad->layoutHeight = winHeight;
+    gamepad->layoutScale = scale;
     float padding = UI_INPUT_PADDING*scale;
 
-    UiAnalogStick *stick = &ui.gamepad.stick;
+    UiAnalogStick *stick = &ui->gamepad.stick;
     stick->centerRadius = UI_STICK_RADIUS*scale;
     stick->stickRadius = UI_STICK_RADIUS/2*scale;
     stick->centerPos.x = stick->centerRadius + padding;
     stick->centerPos.y = winHeight - stick->centerRadius - padding;
     stick->stickPos = stick->centerPos;
 
-    UiDPad *dpad = &ui.gamepad.dpad;
+    UiDPad *dpad = &ui->gamepad.dpad;
     dpad->width = UI_DPAD_WIDTH*scale;
     dpad->button[UI_DPAD_UP].width = dpad->width*3;
     dpad->button[UI_DPAD_UP].height = dpad->width;
@@ -561,50 +728,75 @@ void UpdateUiGamepadRender(void)
         (Rectangle){ dpad->button[UI_DPAD_UP].x, dpad->button[UI_DPAD_UP].y,
             dpad->width*3, dpad->width*3 };
 
-    UiButton *pause = &ui.gamepad.pause;
+    UiButton *pause = &ui->gamepad.pause;
     pause->radius = UI_INPUT_RADIUS*0.8f*scale;
     pause->position.x = winWidth - pause->radius - padding;
     pause->position.y = winHeight - dpad->width - padding;
+
+    // Hit map, mark the cells each control's bounds overlap
+    memset(gamepad->hitMap, 0, sizeof(gamepad->hitMap));
+    gamepad->hitCellSize = (Vector2){ fmaxf((float)winWidth/UI_HIT_MAP_RES, 1), fmaxf((float)winHeight/UI_HIT_MAP_RES, 1) };
+
+    Rectangle bounds[UI_GAMEPAD_STICK + 1];
+    for (int i = 0; i < 4; i++) bounds[UI_GAMEPAD_DPAD_UP + i] = dpad->button[i];
+    bounds[UI_GAMEPAD_PAUSE] = (Rectangle){ pause->position.x - pause->radius, pause->position.y - pause->radius,
+                                            pause->radius*2, pause->radius*2 };
+    bounds[UI_GAMEPAD_STICK] = (Rectangle){ stick->centerPos.x - stick->centerRadius, stick->centerPos.y - stick->centerRadius,
+                                            stick->centerRadius*2, stick->centerRadius*2 };
+
+    for (int control = 0; control <= UI_GAMEPAD_STICK; control++)
+    {
+        Rectangle *rec = &bounds[control];
+        int x0 = (int)Clamp(floorf(rec->x/gamepad->hitCellSize.x), 0, UI_HIT_MAP_RES - 1);
+        int y0 = (int)Clamp(floorf(rec->y/gamepad->hitCellSize.y), 0, UI_HIT_MAP_RES - 1);
+        int x1 = (int)Clamp(floorf((rec->x + rec->width)/gamepad->hitCellSize.x), 0, UI_HIT_MAP_RES - 1);
+        int y1 = (int)Clamp(floorf((rec->y + rec->height)/gamepad->hitCellSize.y), 0, UI_HIT_MAP_RES - 1);
+        for (int y = y0; y <= y1; y++)
+            for (int x = x0; x <= x1; x++)
+                gamepad->hitMap[y*UI_HIT_MAP_RES + x] |= (unsigned char)(1 << control);
+    }
 }
 
-void UpdateUiTouchInput(UiButton *button, UiInputTrigger onPressOrHold)
+void UpdateUiTouchInput(GameContext *ctx, UiButton *button, UiGamepadControl control, UiInputTrigger onPressOrHold)
 {
-    int touchIdx = CheckCollisionTouchCircle(button->position, button->radius);
+    int touchIdx = FindUiGamepadTouch(ctx, control);
     bool isValidPress = (touchIdx != -1);
     if (onPressOrHold == UI_INPUT_ON_PRESS)
-        isValidPress = IsTouchPointTapped(touchIdx);
+        isValidPress = IsTouchPointTapped(ctx, touchIdx);
     if (isValidPress)
-        SetTouchPointButton(touchIdx, button->inputActionId);
+        SetTouchPointButton(ctx, touchIdx, button->inputActionId);
 
-    SetTouchInputActionDown(button->inputActionId, isValidPress);
+    SetTouchInputActionDown(ctx, button->inputActionId, isValidPress);
     button->clicked = isValidPress;
 }
 
-void UpdateUiDPad(UiDPad *dpad)
+void UpdateUiDPad(GameContext *ctx, UiDPad *dpad)
 {
     for (int i = 0; i < 4; i++)
     {
-        int touchIdx = CheckCollisionTouchRec(dpad->button[i]);
+        int touchIdx = FindUiGamepadTouch(ctx, UI_GAMEPAD_DPAD_UP + i);
         bool isValidPress = (touchIdx != -1);
         if (isValidPress)
-            SetTouchPointButton(touchIdx, dpad->inputActionId[i]);
+            SetTouchPointButton(ctx, touchIdx, dpad->inputActionId[i]);
 
-        SetTouchInputActionDown(dpad->inputActionId[i], isValidPress);
+        SetTouchInputActionDown(ctx, dpad->inputActionId[i], isValidPress);
         dpad->clicked[i] = isValidPress;
     }
 }
 
-void UpdateUiAnalogStick(UiAnalogStick *stick)
+void UpdateUiAnalogStick(GameContext *ctx, UiAnalogStick *stick)
 {
+    InputState *input = &ctx->input;
+
     int touchIdx;
     if ((stick->lastTouchId != -1) &&
-        (input.touchPoints[stick->lastTouchId].pressedCurrentFrame))
+        (input->touchPoints[stick->lastTouchId].pressedCurrentFrame))
         touchIdx = stick->lastTouchId;
     else
-        touchIdx = CheckCollisionTouchCircle(stick->centerPos, stick->centerRadius);
+        touchIdx = FindUiGamepadTouch(ctx, UI_GAMEPAD_STICK);
 
     // not touching analog stick
-    if (touchIdx == -1 || input.touchCount == 0 || IsTouchingAnyButton(touchIdx))
+    if (touchIdx == -1 || input->touchCount == 0 || IsTouchingAnyButton(ctx, touchIdx))
     {
         stick->stickPos = stick->centerPos;
         stick->active = false;
@@ -613,8 +805,8 @@ void UpdateUiAnalogStick(UiAnalogStick *stick)
     }
 
     // is touching analog stick
-    stick->lastTouchId = input.touchPoints[touchIdx].id;
-    Vector2 touchPos = input.touchPoints[touchIdx].position;
+    stick->lastTouchId = input->touchPoints[touchIdx].id;
+    Vector2 touchPos = input->touchPoints[touchIdx].position;
 
     bool isTouchWithinStick =
         CheckCollisionPointCircle(touchPos, stick->centerPos, stick->centerRadius);
@@ -633,71 +825,181 @@ void UpdateUiAnalogStick(UiAnalogStick *stick)
     }
 }
 
-void ChangeUiMenu(UiMenuState newMenu)
+void ChangeUiMenu(GameContext *ctx, UiMenuState newMenu)
 {
-    ProcessUserInput(INPUT_POLL_MENU);
-    ui.currentMenu = newMenu;
-    ui.selectedId = 0;
-    ui.firstFrame = true;
-    ui.preventMouseClick = true;
+    UiState *ui = &ctx->ui;
+
+    ProcessUserInput(ctx, INPUT_POLL_MENU);
+    ui->currentMenu = newMenu;
+    ui->selectedId = 0;
+    ui->firstFrame = true;
+    ui->preventMouseClick = true;
 }
 
-bool IsMouseWithinUiButton(UiButton *button)
+bool IsMouseWithinUiButton(GameContext *ctx, UiButton *button)
 {
-    Vector2 mousePos = input.mouse.uiPosition;
+    Vector2 mousePos = ctx->input.mouse.uiPosition;
 
     return CheckCollisionPointRec(mousePos, button->rec);
 }
 
-int IsTouchWithinUiButton(UiButton *button)
+int IsTouchWithinUiButton(GameContext *ctx, UiButton *button)
+{
+    return CheckCollisionTouchRec(ctx, button->rec);
+}
+
+unsigned int GetUiGamepadHits(GameContext *ctx, Vector2 position)
+{
+    UiGamepad *gamepad = &ctx->ui.gamepad;
+
+    int x = (int)(position.x/gamepad->hitCellSize.x);
+    int y = (int)(position.y/gamepad->hitCellSize.y);
+    if ((x < 0) || (y < 0) || (x >= UI_HIT_MAP_RES) || (y >= UI_HIT_MAP_RES)) return 0;
+
+    // Exact tests for just the controls in this cell (usually none)
+    unsigned int hits = 0;
+    unsigned int candidates = gamepad->hitMap[y*UI_HIT_MAP_RES + x];
+    for (int control = 0; candidates; control++, candidates >>= 1)
+    {
+        if (!(candidates & 1)) continue;
+
+        bool isHit = false;
+        if (control == UI_GAMEPAD_PAUSE)
+            isHit = CheckCollisionPointCircle(position, gamepad->pause.position, gamepad->pause.radius);
+        else if (control == UI_GAMEPAD_STICK)
+            isHit = CheckCollisionPointCircle(position, gamepad->stick.centerPos, gamepad->stick.centerRadius);
+        else isHit = CheckCollisionPointRec(position, gamepad->dpad.button[control - UI_GAMEPAD_DPAD_UP]);
+
+        if (isHit) hits |= (1u << control);
+    }
+
+    return hits;
+}
+
+int FindUiGamepadTouch(GameContext *ctx, UiGamepadControl control)
 {
-    return CheckCollisionTouchRec(button->rec);
+    InputState *input = &ctx->input;
+
+    int touchCount = (input->touchCount < INPUT_MAX_TOUCH_POINTS)? input->touchCount : INPUT_MAX_TOUCH_POINTS;
+    for (int i = 0; i < touchCount; i++)
+        if (input->touchPoints[i].gamepadHits & (1u << control))
+            return i;
+
+    return -1;
 }
 
 // Draw
 // ----------------------------------------------------------------------------
 
-void DrawUiFrame(void)
+void DrawUiFrame(GameContext *ctx)
+{
+    UiState *ui = &ctx->ui;
+    Camera2D *camera = &ctx->game.camera;
+
+    // HUD and menus, from the UI layer when there is one
+    if (IsRenderTextureValid(ui->layer))
+    {
+        // The layer covers the whole render target, so undo the camera to draw it 1:1
+        Vector2 topLeft = GetScreenToWorld2D(Vector2Zero(), *camera);
+        float width = (float)ui->layer.texture.width;
+        float height = (float)ui->layer.texture.height;
+        BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+            DrawTexturePro(ui->layer.texture, (Rectangle){ 0, 0, width, -height },
+                           (Rectangle){ topLeft.x, topLeft.y, width/camera->zoom, height/camera->zoom },
+                           Vector2Zero(), 0, WHITE);
+        EndBlendMode();
+    }
+    else DrawUiLayer(ctx);
+
+    // Debug info
+    if (ctx->game.isDebugMode) DrawDebugInfo(ctx);
+}
+
+void DrawUiLayer(GameContext *ctx)
 {
+    UiState *ui = &ctx->ui;
+
+    if (ctx->game.currentScreen == SCREEN_GAMEPLAY) DrawUiHud(ctx);
+
     // Menus and buttons
     // ----------------------------------------------------------------------------
-    if (ui.currentMenu != UI_MENU_NONE) // Draw non-gameplay menu
+    if (ui->currentMenu != UI_MENU_NONE) // Draw non-gameplay menu
     {
-        UiMenu *menu = &ui.menus[ui.currentMenu];
+        UiMenu *menu = &ui->menus[ui->currentMenu];
         for (int i = 0; i < arrlen(menu->buttons); i++)
-            DrawUiButton(&menu->buttons[i]);
+            DrawUiButton(ctx, &menu->buttons[i]);
 
         for (int i = 0; i < arrlen(menu->text); i++)
         {
             UiText *textElem = &menu->text[i];
-            DrawText(textElem->text, (int)textElem->position.x, (int)textElem->position.y,
-                     (int)textElem->fontSize, textElem->color);
+            DrawUiDefaultText(&textElem->run, textElem->text, textElem->position.x, textElem->position.y,
+                              textElem->fontSize, textElem->color);
         }
     }
+}
 
-    // Debug info
-    if (game.isDebugMode) DrawDebugInfo();
+void DrawUiHud(GameContext *ctx)
+{
+    GameState *game = &ctx->game;
+    UiState *ui = &ctx->ui;
+
+    DrawUiText(game->font, &ui->score);
+    DrawUiText(game->font, &ui->scoreNum);
+    DrawUiText(game->font, &ui->hiScore);
+    DrawUiText(game->font, &ui->hiScoreNum);
+
+    Vector2 lifePos = game->gridStart;
+    lifePos.x += GRID_UNIT;
+    lifePos.y += GRID_HEIGHT - GRID_UNIT;
+    Rectangle lifeRec = { lifePos.x, lifePos.y, GRID_UNIT/2, GRID_UNIT/2 };
+    for (int i = 0; i < game->lives; i++)
+    {
+        DrawSpriteOnRectangle(&ui->textures.atlas, SPRITE_LIFE.rec, lifeRec, 0);
+        lifeRec.x += GRID_UNIT/2;
+    }
+
+    Vector2 levelPos = game->gridStart;
+    levelPos.x += GRID_WIDTH - GRID_UNIT*2;
+    levelPos.y += GRID_HEIGHT - GRID_UNIT;
+    Rectangle levelRec = { levelPos.x, levelPos.y, GRID_UNIT/2, GRID_UNIT/2 };
+    for (int i = 0; i < game->level; i++)
+    {
+        DrawSpriteOnRectangle(&ui->textures.atlas, SPRITE_LEVEL.rec, levelRec, 0);
+        levelRec.x -= GRID_UNIT/2;
+    }
 }
 
-void DrawUiText(Font font, UiText text)
+void DrawUiText(Font font, UiText *text)
 {
-    DrawTextEx(font, text.text, text.position, text.fontSize, 0, text.color);
+    DrawTextRun(&text->run, font, text->text, text->position, text->fontSize, 0, text->color);
 }
 
-void DrawUiGamepad(void)
+// DrawText() with raylib's default font, through a text run
+static void DrawUiDefaultText(TextRun *run, const char *text, float x, float y, float fontSize, Color color)
 {
-    if (input.touchMode &&
-        ui.currentMenu == UI_MENU_NONE && game.currentScreen == SCREEN_GAMEPLAY)
+    int size = (fontSize < 10)? 10 : (int)fontSize; // same rounding and spacing as DrawText()
+    DrawTextRun(run, GetFontDefault(), text, (Vector2){ (float)(int)x, (float)(int)y }, (float)size, (float)(size/10), color);
+}
+
+void DrawUiGamepad(GameContext *ctx)
+{
+    InputState *input = &ctx->input;
+    UiState *ui = &ctx->ui;
+
+    if (input->touchMode &&
+        ui->currentMenu == UI_MENU_NONE && ctx->game.currentScreen == SCREEN_GAMEPLAY)
     {
         // Touch screen input controls
-        DrawUiInputButton(&ui.gamepad.pause);
-        if (ui.gamepad.dpad.enabled) DrawUiDPad(&ui.gamepad.dpad);
-        if (ui.gamepad.stick.enabled) DrawUiAnalogStick(&ui.gamepad.stick);
+        DrawUiInputButton(&ui->gamepad.pause);
+        if (ui->gamepad.dpad.enabled) DrawUiDPad(&ui->gamepad.dpad);
+        if (ui->gamepad.stick.enabled) DrawUiAnalogStick(&ui->gamepad.stick);
     }
 }
 
-void DrawUiButton(UiButton *button)
+void DrawUiButton(GameContext *ctx, UiButton *button)
 {
+    UiState *ui = &ctx->ui;
+
     Color buttonColor = button->color;
     Color outlineColor = RAYWHITE;
     float buttonFontSize = (float)button->fontSize;
@@ -705,9 +1007,9 @@ void DrawUiButton(UiButton *button)
     Vector2 checkboxPos = { 0 };
     if (button->checkbox)
         checkboxPos = button->checkbox->position;
-    UiMenu *menu = &ui.menus[ui.currentMenu];
-    bool isMouseHovering = ui.lastSelectWithMouse && (button == &menu->buttons[ui.mouseHoverId]);
-    bool isSelectedButton = !ui.lastSelectWithMouse && (button == &menu->buttons[ui.selectedId]);
+    UiMenu *menu = &ui->menus[ui->currentMenu];
+    bool isMouseHovering = ui->lastSelectWithMouse && (button == &menu->buttons[ui->mouseHoverId]);
+    bool isSelectedButton = !ui->lastSelectWithMouse && (button == &menu->buttons[ui->selectedId]);
     UiSelectionStyle selectionStyleFlags = menu->selectStyleFlags;
 
     if (isMouseHovering || isSelectedButton)
@@ -746,7 +1048,7 @@ void DrawUiButton(UiButton *button)
     {
         // DrawRectangleRec(button->checkbox->rec, RAYWHITE);
         DrawCircleV(checkboxPos, button->checkbox->radius, DARKGRAY);
-        if (button->checkbox->getValue())
+        if (button->checkbox->getValue(ctx))
             DrawCircleV(checkboxPos, button->checkbox->radius/2, buttonColor);
     }
 
@@ -754,12 +1056,11 @@ void DrawUiButton(UiButton *button)
     {
         DrawRectangleRec(button->slider->rec, DARKGRAY);
         Rectangle sliderFilled = button->slider->rec;
-        sliderFilled.width = (button->slider->getValue()/button->slider->max)*button->slider->rec.width;
+        sliderFilled.width = (button->slider->getValue(ctx)/button->slider->max)*button->slider->rec.width;
         DrawRectangleRec(sliderFilled, buttonColor);
     }
 
-    DrawText(button->text, (int)buttonPos.x, (int)buttonPos.y,
-             (int)buttonFontSize, buttonColor);
+    DrawUiDefaultText(&button->run, button->text, buttonPos.x, buttonPos.y, buttonFontSize, buttonColor);
 }
 
 void DrawUiCursor(UiButton *selectedButton)
@@ -801,7 +1102,7 @@ void DrawUiDPad(UiDPad *dpad)
     //     DrawRectangleRec(dpad->button[i], buttonColor);
     // }
     DrawSpriteOnRectangle(dpad->sprite, dpad->spriteRec, dpad->rec, 0);
-    // DrawTexturePro(ui.textures.atlas, dpad->spriteRec, dpad->rec, Vector2Zero(), 0, WHITE);
+    // DrawTexturePro(ui.textures.controls, dpad->spriteRec, dpad->rec, Vector2Zero(), 0, WHITE);
 }
 
 void DrawUiAnalogStick(UiAnalogStick *stick)
@@ -814,24 +1115,63 @@ void DrawUiAnalogStick(UiAnalogStick *stick)
     DrawSpriteOnCircle(stick->sprite, stick->spriteStickRec, stick->stickPos, stick->stickRadius, 0);
 }
 
-void DrawDebugInfo(void)
+void DrawDebugInfo(GameContext *ctx)
 {
+    InputState *input = &ctx->input;
+    RenderData *viewport = &ctx->viewport;
+    LatencyTracker *latency = &ctx->latency;
+    FrameArena *frame = &ctx->frame;
+    AllocTracker *alloc = &ctx->alloc;
+
     DrawFPS(0, 0);
     const int textSize = 20;
     int textY = 20;
-    DrawText(TextFormat("%i touchCount", input.touchCount), 0, textY, textSize, RAYWHITE);
+    DrawText(FrameTextFormat(ctx, "%i touchCount", input->touchCount), 0, textY, textSize, RAYWHITE);
+    textY += textSize;
+    DrawText(FrameTextFormat(ctx, "%i leftDown, %i rightDown", input->mouse.leftDown, input->mouse.rightDown), 0, textY, textSize, RAYWHITE);
+    textY += textSize;
+    DrawText(FrameTextFormat(ctx, "mouse: %3.0f, %3.0f", input->mouse.uiPosition.x, input->mouse.uiPosition.y), 0, textY, textSize, RAYWHITE);
     textY += textSize;
-    DrawText(TextFormat("%i leftDown, %i rightDown", input.mouse.leftDown, input.mouse.rightDown), 0, textY, textSize, RAYWHITE);
+    DrawText(FrameTextFormat(ctx, "render res: %.0f, %.0f", viewport->renderTexWidth, viewport->renderTexHeight), 0, textY, textSize, RAYWHITE);
     textY += textSize;
-    DrawText(TextFormat("mouse: %3.0f, %3.0f", input.mouse.uiPosition.x, input.mouse.uiPosition.y), 0, textY, textSize, RAYWHITE);
+    DrawText(FrameTextFormat(ctx, "ui layer redraws: %i", ctx->ui.layerRedraws), 0, textY, textSize, RAYWHITE);
     textY += textSize;
-    DrawText(TextFormat("render res: %.0f, %.0f", viewport.renderTexWidth, viewport.renderTexHeight), 0, textY, textSize, RAYWHITE);
+    DrawText(FrameTextFormat(ctx, "frame arena: high %i bytes, %i allocs, %i stale", (int)frame->highWaterBytes,
+             frame->highWaterAllocs, frame->staleCount), 0, textY, textSize, RAYWHITE);
     textY += textSize;
-    if (input.touchCount > 0)
+    DrawText(FrameTextFormat(ctx, "heap allocs: input %i, update %i, level %i, draw %i (%i steady frames)",
+             alloc->lastFrameCounts[ALLOC_SCOPE_INPUT], alloc->lastFrameCounts[ALLOC_SCOPE_UPDATE],
+             alloc->lastFrameCounts[ALLOC_SCOPE_LEVEL], alloc->lastFrameCounts[ALLOC_SCOPE_DRAW],
+             alloc->steadyFrames), 0, textY, textSize, RAYWHITE);
+    textY += textSize;
+    AudioMixer *audio = &ctx->audio;
+    DrawText(FrameTextFormat(ctx, "audio mix: %.0f us, max %.0f us (audio thread), %i dropped", audio->mixTime*1e6f,
+             audio->mixTimeMax*1e6f, audio->droppedCount), 0, textY, textSize, RAYWHITE);
+    textY += textSize;
+    DrawText(FrameTextFormat(ctx, "voices: %i, max %i/%i, %li stolen, %li skipped", audio->voiceCount, audio->voiceCountMax,
+             AUDIO_MIXER_VOICES, audio->stolenCount, audio->skippedCount), 0, textY, textSize, RAYWHITE);
+    textY += textSize;
+    DrawText(FrameTextFormat(ctx, "input to move: %.1f ms (avg %.1f)", input->moveLatency*1000, input->moveLatencyAvg*1000), 0, textY, textSize, RAYWHITE);
+    textY += textSize;
+    DrawText(FrameTextFormat(ctx, "F4 pacing: %s", GetLatencyPacing(ctx)->name), 0, textY, textSize, RAYWHITE);
+    textY += textSize;
+    DrawText(FrameTextFormat(ctx, "F5 late latch: %s, sleep %.1f, work %.1f ms, %i missed", ctx->pacer.enabled? "on" : "off",
+             ctx->pacer.sleepTime*1000, ctx->pacer.predictedWork*1000, ctx->pacer.missedCount), 0, textY, textSize, RAYWHITE);
+    textY += textSize;
+    DrawText(FrameTextFormat(ctx, "F6 lane strips: %s, %i lanes", ctx->lanes.isEnabled? "on" : "off", ctx->lanes.stripCount),
+             0, textY, textSize, RAYWHITE);
+    textY += textSize;
+    if (latency->sampleCount > 0)
     {
-        for (int i = 0; i < input.touchCount; i++)
+        LatencyStats *total = &latency->stats[LATENCY_SERIES_TOTAL];
+        DrawText(FrameTextFormat(ctx, "input to present: p50 %.1f, p95 %.1f ms (%i moves)", total->p50, total->p95, latency->sampleCount), 0, textY, textSize, RAYWHITE);
+        textY += textSize;
+    }
+    if (input->touchCount > 0)
+    {
+        for (int i = 0; i < input->touchCount; i++)
         {
-            DrawText(TextFormat("touch %i: %3.0f, %3.0f", i, GetTouchPosition(i).x, GetTouchPosition(i).y), 0, textY, textSize, RAYWHITE);
+            DrawText(FrameTextFormat(ctx, "touch %i: %3.0f, %3.0f", i, GetTouchPosition(i).x, GetTouchPosition(i).y), 0, textY, textSize, RAYWHITE);
             textY += textSize;
         }
     }
@@ -839,12 +1179,50 @@ void DrawDebugInfo(void)
 
 // Frogger
 // ----------------------------------------------------------------------------
-void SetTimedMessage(const char *message, float time, Color color)
-{
-    ui.messageTimer = time;
-    Vector2 measure = MeasureTextEx(game.font, message, ui.timedMessage.fontSize, 0);
-    ui.timedMessage.measure = measure;
-    strcpy(ui.timedMessage.text, message);
-    ui.timedMessage.position = (Vector2){ (float)(VIRTUAL_WIDTH - measure.x)/2, (float)(VIRTUAL_HEIGHT - measure.y)/2 };
-    ui.timedMessage.color = color;
+void SetTimedMessage(GameContext *ctx, const char *message, float time, Color color)
+{
+    UiState *ui = &ctx->ui;
+
+    ui->messageTimer = time;
+    Vector2 measure = MeasureFontText(ctx->game.font, message, ui->timedMessage.fontSize, 0);
+    ui->timedMessage.measure = measure;
+    strcpy(ui->timedMessage.text, message);
+    ui->timedMessage.position = (Vector2){ (float)(VIRTUAL_WIDTH - measure.x)/2, (float)(VIRTUAL_HEIGHT - measure.y)/2 };
+    ui->timedMessage.color = color;
+}
+
+void LayoutUiHud(GameContext *ctx)
+{
+    GameState *game = &ctx->game;
+    UiState *ui = &ctx->ui;
+
+    UiText defaultFont = {
+        .fontSize = GAME_FONT_SIZE,
+        .color = WHITE,
+    };
+    UiText score = defaultFont;
+    strcpy(score.text, "SCORE");
+    score.measure = MeasureFontText(game->font, score.text, score.fontSize, 0);
+    score.position = (Vector2){ game->gridStart.x + GRID_UNIT*2.5f, game->gridStart.y };
+    UiText scoreNum = score;
+    scoreNum.position.y += scoreNum.measure.y;
+    scoreNum.position.x = GetGridPosition(ctx, 3, 0).x;
+    ui->score = score;
+    ui->scoreNum = scoreNum;
+
+    UiText hiScore = defaultFont;
+    strcpy(hiScore.text, "HI-SCORE");
+    hiScore.measure = MeasureFontText(game->font, hiScore.text, hiScore.fontSize, 0);
+    hiScore.position = (Vector2){ (VIRTUAL_WIDTH - hiScore.measure.x)/2, game->gridStart.y };
+    UiText hiScoreNum = hiScore;
+    hiScoreNum.position.y += hiScoreNum.measure.y;
+    hiScoreNum.position.x = GetGridPosition(ctx, 6, 0).x + GRID_UNIT/2;
+    ui->hiScore = hiScore;
+    ui->hiScoreNum = hiScoreNum;
+    ui->hudScore = ui->hudHiScore = -1; // the number texts are written again
+
+    // Center the timed message again
+    UiText *message = &ui->timedMessage;
+    message->measure = MeasureFontText(game->font, message->text, message->fontSize, 0);
+    message->position = (Vector2){ (VIRTUAL_WIDTH - message->measure.x)/2, (VIRTUAL_HEIGHT - message->measure.y)/2 };
 }
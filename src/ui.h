@@ -36,6 +36,7 @@
 #define UI_DPAD_WIDTH   70.0f
 #define UI_INPUT_RADIUS 40.0f
 #define UI_INPUT_PADDING 75.0f
+#define UI_HIT_MAP_RES  32 // touch hit map cells across each side of the window
 
 // Types and Structures
 // ----------------------------------------------------------------------------
@@ -62,21 +63,18 @@ typedef enum {
 typedef enum { UI_INPUT_ON_PRESS, UI_INPUT_ON_HOLD } UiInputTrigger;
 
 // Callback functions for interactive elements
-typedef void (*UiActionFunc)(void);
-typedef void (*UiSetFloatFunc)(float setValue, void *slider);
-typedef float (*UiGetFloatFunc)(void);
-typedef bool (*UiGetBoolFunc)(void);
+typedef void (*UiActionFunc)(GameContext *ctx);
+typedef void (*UiSetFloatFunc)(GameContext *ctx, float setValue, void *slider);
+typedef float (*UiGetFloatFunc)(GameContext *ctx);
+typedef bool (*UiGetBoolFunc)(GameContext *ctx);
 
 typedef struct {
-    Sound menu;
+    GameSound menu;
 } UiSounds;
 
 typedef struct {
-    Texture atlas;
-    Rectangle analogBase;
-    Rectangle analogStick;
-    Rectangle dpad;
-    Rectangle pause;
+    Texture atlas;    // all the game and UI sprites, see sprites.h (the UI outlives game restarts)
+    Texture controls; // the touch controls, bilinear as they're scaled down, see controls.h
 } UiTextures;
 
 typedef struct {
@@ -84,7 +82,8 @@ typedef struct {
     Vector2 position;
     Vector2 measure;
     float fontSize;
-    char text[64];
+    char text[TEXT_RUN_MAX_GLYPHS];
+    TextRun run; // glyph layout, redone when the text changes
 } UiText;
 
 typedef struct {
@@ -123,6 +122,7 @@ typedef struct {
     bool bordered;
     bool clicked;
     const char *text;
+    TextRun run;
 } UiButton;
 
 typedef struct {
@@ -160,10 +160,27 @@ typedef struct {
     bool enabled;
 } UiDPad;
 
+typedef enum {
+    UI_GAMEPAD_DPAD_UP, UI_GAMEPAD_DPAD_DOWN, // same order as UiDPadDirections
+    UI_GAMEPAD_DPAD_LEFT, UI_GAMEPAD_DPAD_RIGHT,
+    UI_GAMEPAD_PAUSE,
+    UI_GAMEPAD_STICK,
+} UiGamepadControl;
+
 typedef struct { // Virtual touchscreen input
     UiButton pause;
     UiAnalogStick stick;
     UiDPad dpad;
+
+    // Layout is only recomputed when the window size or UI scale changes
+    int layoutWidth, layoutHeight;
+    float layoutScale;
+
+    // Controls overlapping each cell of a coarse grid over the window,
+    // as UiGamepadControl bits, so a touch point is only tested exactly
+    // against the controls in its cell
+    unsigned char hitMap[UI_HIT_MAP_RES*UI_HIT_MAP_RES];
+    Vector2 hitCellSize;
 } UiGamepad;
 
 typedef struct {
@@ -180,6 +197,7 @@ typedef struct {
     bool firstFrame;
     bool lastSelectWithMouse;
     bool preventMouseClick;
+    AutoRepeatSettings menuAutoRepeat, sliderAutoRepeat; // held menu up/down, slider left/right
     UiGamepad gamepad; // touchscreen gamepad
 
     // Used during menu creation
@@ -192,6 +210,12 @@ typedef struct {
     UiText scoreNum;
     UiText hiScore;
     UiText hiScoreNum;
+    int hudScore, hudHiScore; // values in scoreNum/hiScoreNum, -1 to refresh
+
+    // Retained layer, the HUD and menus are only redrawn into it when they change
+    RenderTexture layer;
+    unsigned int layerKey; // hash of everything drawn on the layer
+    int layerRedraws;
 
     // Miscellaneous
     UiText timedMessage;
@@ -200,56 +224,79 @@ typedef struct {
     float actionCooldownTimer;
     float textFade; // for fade in and out animation
     float textFadeTimeElapsed;
+    float textFadeBeforePause;
+    bool textFadingOut;
 } UiState;
 
-extern UiState ui; // global declaration
-
 // Prototypes
 // ----------------------------------------------------------------------------
 
 // Initialize
-void InitUiState(void); // Initializes the title screen and allocates memory for menu buttons
-UiButton InitUiButton(char *text, UiActionFunc actionFunc, float x, float y, float buttonWidth, int fontSize); // creates a default UI button
-void CreateUiTextEx(Font font, char *text, float x, float y, float fontSize);
-void CreateUiText(char *text, float x, float y, int fontSize);
+void InitUiState(GameContext *ctx); // Initializes the title screen and allocates memory for menu buttons
+UiButton InitUiButton(GameContext *ctx, char *text, UiActionFunc actionFunc, float x, float y, float buttonWidth, int fontSize); // creates a default UI button
+void CreateUiTextEx(GameContext *ctx, Font font, char *text, float x, float y, float fontSize);
+void CreateUiText(GameContext *ctx, char *text, float x, float y, int fontSize);
 UiButton InitUiInputButton(char *text, int inputActionId, float textPosX, float textPosY, float radius);
-void CreateUiCheckbox(UiGetBoolFunc getValue);
-void CreateUiSlider(UiSetFloatFunc setValue, UiGetFloatFunc getValue, float minValue, float maxValue, float increment);
-UiButton *CreateUiMenuButton(char *text, UiActionFunc actionFunc, float x, float y); // Initializes a button within a menu
-void CreateUiMenuButtonRelative(char* text, UiActionFunc actionFunc); // Initializes a button within a menu relative to the last menu button
-void SetUiAlignMode(UiAlignment hAlign, UiAlignment vAlign);
-// void FreeUiState(void); // Frees memory for all menu buttons
+void CreateUiCheckbox(GameContext *ctx, UiGetBoolFunc getValue);
+void CreateUiSlider(GameContext *ctx, UiSetFloatFunc setValue, UiGetFloatFunc getValue, float minValue, float maxValue, float increment);
+UiButton *CreateUiMenuButton(GameContext *ctx, char *text, UiActionFunc actionFunc, float x, float y); // Initializes a button within a menu
+void CreateUiMenuButtonRelative(GameContext *ctx, char* text, UiActionFunc actionFunc); // Initializes a button within a menu relative to the last menu button
+void SetUiAlignMode(GameContext *ctx, UiAlignment hAlign, UiAlignment vAlign);
+void FreeUiState(GameContext *ctx); // Frees memory for all menu buttons
 
 // Update / User Input
-void UpdateUiFrame(void); // Updates the menu for the current frame
-void UpdateUiMenuTraverse(void); // Updates the cursor for movement by user input
-void UpdateUiButtonSelect(UiButton *button); // Selects a button by user input
-void UpdateUiSliderSelect(UiSlider *slider);
-void ChangeUiMenu(UiMenuState newMenu); // Change from one menu to another
+void UpdateUiFrame(GameContext *ctx); // Updates the menu for the current frame
+void UpdateUiMenuTraverse(GameContext *ctx); // Updates the cursor for movement by user input
+void UpdateUiButtonSelect(GameContext *ctx, UiButton *button); // Selects a button by user input
+void UpdateUiSliderSelect(GameContext *ctx, UiSlider *slider);
+void ChangeUiMenu(GameContext *ctx, UiMenuState newMenu); // Change from one menu to another
+
+void UpdateUiHud(GameContext *ctx); // Updates the score text if the score changed
+void UpdateUiLayer(GameContext *ctx); // Redraws the retained UI layer if anything on it changed, call outside of texture mode
 
 // Touch screen virtual gamepad
-void UpdateUiGamepadRender(void);
-void UpdateUiTouchInput(UiButton *button, UiInputTrigger onPressOrHold); // Updates virtual input from button
-void UpdateUiAnalogStick(UiAnalogStick *stick);
-void UpdateUiDPad(UiDPad *dpad);
+void UpdateUiGamepadRender(GameContext *ctx); // Updates the layout and hit map if the window was resized
+void UpdateUiGamepadLayout(GameContext *ctx, int winWidth, int winHeight, float scale);
+void UpdateUiTouchInput(GameContext *ctx, UiButton *button, UiGamepadControl control, UiInputTrigger onPressOrHold); // Updates virtual input from button
+void UpdateUiAnalogStick(GameContext *ctx, UiAnalogStick *stick);
+void UpdateUiDPad(GameContext *ctx, UiDPad *dpad);
 
 // Collision
-bool IsMouseWithinUiButton(UiButton *button);
-int IsTouchWithinUiButton(UiButton *button);
+bool IsMouseWithinUiButton(GameContext *ctx, UiButton *button);
+int IsTouchWithinUiButton(GameContext *ctx, UiButton *button);
+unsigned int GetUiGamepadHits(GameContext *ctx, Vector2 position); // Touch gamepad controls at a screen position, as UiGamepadControl bits
+int FindUiGamepadTouch(GameContext *ctx, UiGamepadControl control); // First touch point on a control, returns index to touch point or -1
 
 // Draw
-void DrawUiFrame(void); // Draws all the UI buttons for the current frame
-void DrawUiText(Font font, UiText text);
-void DrawUiGamepad(void);
-void DrawUiButton(UiButton *button);
+void DrawUiFrame(GameContext *ctx); // Draws the UI layer (HUD and menus) and debug info for the current frame
+void DrawUiLayer(GameContext *ctx); // Draws the HUD and menus, into the UI layer or directly if there is none
+void DrawUiHud(GameContext *ctx); // Draws the score, lives and level
+void DrawUiText(Font font, UiText *text);
+void DrawUiGamepad(GameContext *ctx);
+void DrawUiButton(GameContext *ctx, UiButton *button);
 void DrawUiCursor(UiButton *selectedButton); // Draw the cursor at the given button
 void DrawUiInputButton(UiButton *button); // Draw touch input button
 void DrawUiDPad(UiDPad *dpad); // Draw touch directional pad
 void DrawUiAnalogStick(UiAnalogStick *stick); // Draw touch analog stick
 
-void DrawDebugInfo(void);
+void DrawDebugInfo(GameContext *ctx);
 
 // Other
-void SetTimedMessage(const char *message, float time, Color color);
+void SetTimedMessage(GameContext *ctx, const char *message, float time, Color color);
+void LayoutUiHud(GameContext *ctx); // Measure and place the HUD labels and timed message with the game font
+
+// Callbacks for interactive UI elements (ui_callbacks.c)
+void UiCallbackStartGame(GameContext *ctx);
+void UiCallbackSettings(GameContext *ctx);
+void UiCallbackExit(GameContext *ctx);
+void UiCallbackResume(GameContext *ctx);
+void UiCallbackGoBack(GameContext *ctx);
+void UiCallbackGoToTitle(GameContext *ctx);
+bool UiCallbackCheckFullscreen(GameContext *ctx);
+void UiCallbackToggleFullscreen(GameContext *ctx);
+void UiCallbackSetVolume(GameContext *ctx, float setValue, void *slider);
+float UiCallbackGetVolume(GameContext *ctx);
+float UiCallbackGetRenderScale(GameContext *ctx);
+void UiCallbackSetRenderScale(GameContext *ctx, float setValue, void *slider);
 
 #endif // FROGGER_UI_HEADER_GUARD
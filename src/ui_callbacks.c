@@ -1,122 +1,143 @@
 // EXPLANATION:
 // Callback functions for interactive UI elements
 
+#include "common.h" // all project header includes
+
 // Title
-void UiCallbackStartGame(void)
+void UiCallbackStartGame(GameContext *ctx)
 {
-    game.currentScreen = SCREEN_GAMEPLAY;
-    ChangeUiMenu(UI_MENU_NONE);
+    ctx->game.currentScreen = SCREEN_GAMEPLAY;
+    ChangeUiMenu(ctx, UI_MENU_NONE);
 }
 
-void UiCallbackSettings(void)
+void UiCallbackSettings(GameContext *ctx)
 {
-    ChangeUiMenu(UI_MENU_SETTINGS);
+    ChangeUiMenu(ctx, UI_MENU_SETTINGS);
 }
 
-void UiCallbackExit(void)
+void UiCallbackExit(GameContext *ctx)
 {
-    game.shouldExit = true;
+    ctx->game.shouldExit = true;
 }
 
 // Paused
-void UiCallbackResume(void)
+void UiCallbackResume(GameContext *ctx)
 {
-    ChangeUiMenu(UI_MENU_NONE);
-    game.isPaused = false;
-    game.currentScreen = SCREEN_GAMEPLAY;
-    game.isInputDisabledFromResume = true;
+    GameState *game = &ctx->game;
+
+    ChangeUiMenu(ctx, UI_MENU_NONE);
+    game->isPaused = false;
+    game->currentScreen = SCREEN_GAMEPLAY;
+    game->isInputDisabledFromResume = true;
 }
 
-void UiCallbackGoBack(void)
+void UiCallbackGoBack(GameContext *ctx)
 {
-    if (game.currentScreen == SCREEN_TITLE)
-        ChangeUiMenu(UI_MENU_TITLE);
+    GameState *game = &ctx->game;
+
+    if (game->currentScreen == SCREEN_TITLE)
+        ChangeUiMenu(ctx, UI_MENU_TITLE);
 
-    if (game.currentScreen == SCREEN_GAMEPLAY)
-        ChangeUiMenu(UI_MENU_PAUSE);
+    if (game->currentScreen == SCREEN_GAMEPLAY)
+        ChangeUiMenu(ctx, UI_MENU_PAUSE);
 }
 
-void UiCallbackGoToTitle(void)
+void UiCallbackGoToTitle(GameContext *ctx)
 {
-    ChangeUiMenu(UI_MENU_TITLE);
+    GameState *game = &ctx->game;
+
+    ChangeUiMenu(ctx, UI_MENU_TITLE);
 
     // Reset game state if returning from gameplay
-    if (game.currentScreen == SCREEN_GAMEPLAY)
+    if (game->currentScreen == SCREEN_GAMEPLAY)
     {
-        int hiScore = game.hiScore;
-        FreeGameState();
-        InitGameState();
-        game.hiScore = hiScore;
+        int hiScore = game->hiScore;
+        FreeGameState(ctx);
+        InitGameState(ctx);
+        game->hiScore = hiScore;
     }
 }
 
 // Settings
-bool UiCallbackCheckFullscreen(void)
+bool UiCallbackCheckFullscreen(GameContext *ctx)
 {
-    return game.isFullscreen;
+    return ctx->game.isFullscreen;
 }
 
-void UiCallbackToggleFullscreen(void)
+void UiCallbackToggleFullscreen(GameContext *ctx)
 {
     ToggleBorderlessWindowed();
-    input.cancelTime = 0.25f;
+    ctx->input.cancelTime = 0.25f;
 }
 
-void UiCallbackSetVolume(float setValue, void *slider)
+void UiCallbackSetVolume(GameContext *ctx, float setValue, void *slider)
 {
+    UiState *ui = &ctx->ui;
+
     const float cooldownTime = 0.1f;
     UiSlider *s = (UiSlider*)slider;
     setValue = Clamp(setValue, s->min, s->max);
     SetMasterVolume(setValue);
-    if (ui.actionCooldownTimer < EPSILON)
+    if (ui->actionCooldownTimer < EPSILON)
     {
-        ui.actionCooldownTimer = cooldownTime;
-        PlaySound(ui.sounds.menu);
+        ui->actionCooldownTimer = cooldownTime;
+        PlayGameSound(ctx, &ui->sounds.menu);
     }
 }
 
-float UiCallbackGetRenderScale(void)
+float UiCallbackGetVolume(GameContext *ctx)
 {
-    return viewport.resScale;
+    (void)ctx; // volume belongs to the audio device, not the game
+    return GetMasterVolume();
 }
 
-void UiCallbackSetRenderScale(float setValue, void *slider)
+float UiCallbackGetRenderScale(GameContext *ctx)
 {
+    return ctx->viewport.resScale;
+}
+
+void UiCallbackSetRenderScale(GameContext *ctx, float setValue, void *slider)
+{
+    GameState *game = &ctx->game;
+    UiState *ui = &ctx->ui;
+    RenderData *viewport = &ctx->viewport;
+
     const float cooldownTime = 0.1f;
     UiSlider *s = (UiSlider*)slider;
     setValue = Clamp(setValue, s->min, s->max);
     setValue = roundf(setValue/s->increment)*s->increment;
-    if (setValue == s->getValue()) return; // don't update if value is unchanged
+    if (setValue == s->getValue(ctx)) return; // don't update if value is unchanged
 
-    if (ui.actionCooldownTimer < EPSILON)
+    if (ui->actionCooldownTimer < EPSILON)
     {
-        ui.actionCooldownTimer = cooldownTime;
-        viewport.resScale = setValue;
+        ui->actionCooldownTimer = cooldownTime;
+        viewport->resScale = setValue;
     }
-    InitRenderTexture();
-    game.camera.offset = (Vector2){ viewport.renderTexWidth/2, viewport.renderTexHeight/2 };
-    game.camera.zoom = viewport.renderTexHeight/VIRTUAL_HEIGHT;
+    InitRenderTexture(ctx);
+    game->camera.offset = (Vector2){ viewport->renderTexWidth/2, viewport->renderTexHeight/2 };
+    game->camera.zoom = viewport->renderTexHeight/VIRTUAL_HEIGHT;
+    BakeGameFont(ctx);
 }
 
-// bool UiCallbackCheckShader(void)
+// bool UiCallbackCheckShader(GameContext *ctx)
 // {
-//     return viewport.shaderEnabled;
+//     return ctx->viewport.shaderEnabled;
 // }
 
-// void UiCallbackToggleShader(void)
+// void UiCallbackToggleShader(GameContext *ctx)
 // {
-//     viewport.shaderEnabled = !viewport.shaderEnabled;
+//     ctx->viewport.shaderEnabled = !ctx->viewport.shaderEnabled;
 // }
 
-// float UiCallbackGetPixelSize(void)
+// float UiCallbackGetPixelSize(GameContext *ctx)
 // {
-//     return viewport.pixelSize;
+//     return ctx->viewport.pixelSize;
 // }
 
-// void UiCallbackSetPixelSize(float setValue, float min, float max)
+// void UiCallbackSetPixelSize(GameContext *ctx, float setValue, float min, float max)
 // {
 //     setValue = Clamp(setValue, min, max);
-//     viewport.pixelSize = (int)setValue;
-//     SetShaderValue(viewport.shader, viewport.shaderPixelWidthLoc, &viewport.pixelSize, SHADER_UNIFORM_FLOAT);
-//     SetShaderValue(viewport.shader, viewport.shaderPixelHeightLoc, &viewport.pixelSize, SHADER_UNIFORM_FLOAT);
+//     ctx->viewport.pixelSize = (int)setValue;
+//     SetShaderValue(ctx->viewport.shader, ctx->viewport.shaderPixelWidthLoc, &ctx->viewport.pixelSize, SHADER_UNIFORM_FLOAT);
+//     SetShaderValue(ctx->viewport.shader, ctx->viewport.shaderPixelHeightLoc, &ctx->viewport.pixelSize, SHADER_UNIFORM_FLOAT);
 // }
@@ -0,0 +1,28 @@
+// EXPLANATION:
+// Unity build of the game modules, all compiled as one translation unit
+// Used by the simple build scripts and `make UNITY=1`, link it with main.c
+// (or a headless tool) and one platform_*.c file
+
+#include "external.c" // first, it implements the library headers
+
+#include "rl_utils.c" // raylib convenience
+#include "archive.c"  // packed asset archive
+#include "jobs.c"     // job queue for worker threads
+#include "music.c"    // streaming QOA music
+#include "audio.c"    // audio mixer and its event queue
+
+// Modules
+#include "render.c"
+#include "input.c"
+#include "logo.c"
+#include "ui_callbacks.c"
+#include "ui.c"
+#include "latency.c"
+#include "pacing.c"
+#include "frame_arena.c"
+#include "alloc.c"
+#include "loader.c"
+#include "lanes.c"
+
+// Game code
+#include "frogger.c"